@@ -0,0 +1,158 @@
+/*
+ * Aggregate Hangar Atomic Model
+ *
+ * Stand-in for the Hangar coupled model (Selector, four storage bays,
+ * Merger) with the same in / hangar_exit ports, for runs where only the
+ * runway side matters. The hangar is one delay line: planes are routed
+ * one at a time in arrival order, ROUTING_TIME each as in the Selector,
+ * and leave in the same order. Each plane's release time is worked out
+ * when it comes in and kept in a flat FIFO of timestamps, so a plane
+ * costs one transition in and one out instead of the six of the
+ * detailed hangar.
+ *
+ * With DwellConfig enabled a plane is also held for its dwell, drawn
+ * and rounded up to the resolution by StorageBay's releaseTick, so a
+ * release past the last tick never comes. Release stays FIFO, so a
+ * plane with a short dwell waits for the one routed before it; the
+ * detailed hangar would let it overtake.
+ *
+ * States: IDLE, ACTIVE
+ *   - IDLE: No planes
+ *   - ACTIVE: Planes in the delay line, next release in sigma
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ */
+
+#ifndef AGGREGATE_HANGAR_HPP
+#define AGGREGATE_HANGAR_HPP
+
+#include <cadmium/modeling/devs/atomic.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../data_structures/ring_queue.hpp"
+#include "selector.hpp"
+#include "storageBay.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <random>
+
+using namespace cadmium;
+
+enum class AggregateHangarPhase { IDLE, ACTIVE };
+
+struct AggregateHangarState {
+    struct Release {
+        double time;
+        PlaneMsg plane;
+    };
+
+    AggregateHangarPhase phase;
+    RingQueue<Release> releases;  // in release order
+    double clock;
+    double routed_until;          // end of the last routing slot
+    double sigma;
+    DwellConfig dwell;
+    std::mt19937_64 rng;
+
+    explicit AggregateHangarState(const DwellConfig& dwell = DwellConfig())
+        : phase(AggregateHangarPhase::IDLE),
+          clock(0),
+          routed_until(0),
+          sigma(std::numeric_limits<double>::infinity()),
+          dwell(dwell),
+          rng(dwell.seed) {}
+
+    // same as a new AggregateHangarState(dwell), buffer storage kept
+    void reset(const DwellConfig& new_dwell) {
+        phase = AggregateHangarPhase::IDLE;
+        releases.clear();
+        clock = 0;
+        routed_until = 0;
+        sigma = std::numeric_limits<double>::infinity();
+        dwell = new_dwell;
+        rng.seed(new_dwell.seed);
+    }
+};
+
+std::ostream& operator<<(std::ostream &out, const AggregateHangarState& state) {
+    std::string phaseStr = (state.phase == AggregateHangarPhase::IDLE) ? "IDLE" : "ACTIVE";
+    out << "{phase=" << phaseStr << ", size=" << state.releases.size()
+        << ", sigma=" << state.sigma << "}";
+    return out;
+}
+
+class AggregateHangar : public Atomic<AggregateHangarState> {
+public:
+    PooledPort<PlaneMsg> in;
+    PooledPort<PlaneMsg> hangar_exit;
+
+    AggregateHangar(const std::string& id, const DwellConfig& dwell = DwellConfig())
+        : Atomic<AggregateHangarState>(id, AggregateHangarState(dwell)) {
+        in = addPooledInPort<PlaneMsg>(this, "in");
+        hangar_exit = addPooledOutPort<PlaneMsg>(this, "hangar_exit");
+    }
+
+    // back to the initial state for a new run, with new dwell options
+    void reset(const DwellConfig& dwell = DwellConfig()) { state.reset(dwell); }
+
+    // release time of a plane coming in now
+    static double releaseTime(AggregateHangarState& state, const PlaneMsg& plane) {
+        state.routed_until = std::max(state.clock, state.routed_until) + SelectorState::ROUTING_TIME;
+        double release = state.routed_until;
+        if (state.dwell.enabled) {
+            double dwell = planeDwell(plane);
+            if (dwell <= 0) {
+                dwell = state.dwell.dwell;
+                if (state.dwell.exponential && dwell > 0) {
+                    dwell = std::exponential_distribution<double>(1.0 / dwell)(state.rng);
+                }
+            }
+            DwellTick tick = releaseTick(release + dwell, state.dwell.resolution);
+            release = (tick == NEVER_RELEASED) ? std::numeric_limits<double>::infinity()
+                                               : tick * state.dwell.resolution;
+        }
+        if (!state.releases.empty()) release = std::max(release, state.releases.back().time);
+        return release;
+    }
+
+    static void schedule(AggregateHangarState& state) {
+        if (!state.releases.empty()) {
+            state.phase = AggregateHangarPhase::ACTIVE;
+            state.sigma = state.releases.front().time - state.clock;
+        } else {
+            state.phase = AggregateHangarPhase::IDLE;
+            state.sigma = std::numeric_limits<double>::infinity();
+        }
+    }
+
+    // front plane left, wait for the next
+    void internalTransition(AggregateHangarState& state) const override {
+        state.clock = state.releases.front().time;
+        state.releases.pop();
+        schedule(state);
+    }
+
+    // planes join the back of the line
+    void externalTransition(AggregateHangarState& state, double e) const override {
+        state.clock += e;
+        for (const auto& plane : in->getBag()) {
+            double release = releaseTime(state, plane);
+            state.releases.push(AggregateHangarState::Release{release, plane});
+        }
+        schedule(state);
+    }
+
+    // send front plane
+    void output(const AggregateHangarState& state) const override {
+        if (state.phase == AggregateHangarPhase::ACTIVE) {
+            hangar_exit->addMessage(state.releases.front().plane);
+        }
+    }
+
+    [[nodiscard]] double timeAdvance(const AggregateHangarState& state) const override {
+        return state.sigma;
+    }
+};
+
+#endif
@@ -13,6 +13,23 @@
  * race conditions when both queues output simultaneously, or when planes
  * arrive while ControlTower is busy processing another operation.
  *
+ * Scheduling modes for the pending buffers:
+ *   - FIFO (default): planes are served in arrival order
+ *   - PRIORITY: planes are served by PlaneMessage priority (emergency,
+ *     low fuel, normal), FIFO among equal priorities. Backed by an
+ *     indexed heap so insert, pop and a priority change on in_priority
+ *     are O(log n) however many planes are holding.
+ * Landings are always served before takeoffs.
+ *
+ * Signalling modes for the queue control ports:
+ *   - FULL (default): stop to both queues with every runway command and
+ *     done to both when the runway is free again
+ *   - COALESCED: no stop to a queue that is already held, because it
+ *     sent a plane and waits for its done. When another operation
+ *     follows at once, the done and the next stop go out as one
+ *     QUEUE_HANDOVER done. Planes move exactly as in FULL mode with
+ *     fewer queue transitions; a queue waiting for its done logs busy=0.
+ *
  * Authors: Hasib Khodayar & Hajar Assim
  */
 
@@ -20,32 +37,114 @@
 #define CONTROL_TOWER_HPP
 
 #include <cadmium/modeling/devs/atomic.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../data_structures/ring_queue.hpp"
+#include "../data_structures/indexed_heap.hpp"
+#include "queue.hpp"
 #include <iostream>
 #include <limits>
-#include <queue>
+#include <unordered_map>
 
 using namespace cadmium;
 
 enum class TowerPhase { IDLE, SIGNAL, WAIT };
 enum class OperationType { NONE, LANDING, TAKEOFF };
+enum class TowerScheduling { FIFO, PRIORITY };
+enum class TowerSignalling { FULL, COALESCED };
+
+// pending buffer for one operation type, FIFO or priority ordered
+struct PendingPlanes {
+    using Handle = IndexedHeap<PlaneMsg>::Handle;
+
+    bool prioritized;
+    RingQueue<PlaneMsg> fifo;
+    IndexedHeap<PlaneMsg> heap;
+    std::unordered_map<int, Handle> handle_of;  // holding plane id -> heap handle, for priority changes
+
+    explicit PendingPlanes(bool prioritized) : prioritized(prioritized), fifo(), heap(), handle_of() {}
+
+    // empty, possibly switching order, storage kept
+    void reset(bool new_prioritized) {
+        prioritized = new_prioritized;
+        fifo.clear();
+        heap.clear();
+        handle_of.clear();
+    }
+
+    [[nodiscard]] bool empty() const { return prioritized ? heap.empty() : fifo.empty(); }
+    [[nodiscard]] std::size_t size() const { return prioritized ? heap.size() : fifo.size(); }
+    [[nodiscard]] const PlaneMsg& front() const { return prioritized ? heap.top() : fifo.front(); }
+
+    void push(const PlaneMsg& plane) {
+        if (!prioritized) {
+            fifo.push(plane);
+            return;
+        }
+        Handle h = heap.push(plane, planePriority(plane));
+        int id = planeId(plane);
+        if (id >= 0) handle_of[id] = h;
+    }
+
+    void pop() {
+        if (!prioritized) {
+            fifo.pop();
+            return;
+        }
+        auto it = handle_of.find(planeId(heap.top()));
+        if (it != handle_of.end() && it->second == heap.topHandle()) handle_of.erase(it);
+        heap.pop();
+    }
+
+    // re-rank a holding plane, returns false if it is not in this buffer
+    bool updatePriority(int id, int priority) {
+        if (!prioritized) return false;
+        auto it = handle_of.find(id);
+        if (it == handle_of.end()) return false;
+        Handle h = it->second;
+        setPlanePriority(heap.get(h), priority);
+        heap.update(h, priority);
+        return true;
+    }
+};
 
 struct ControlTowerState {
     TowerPhase phase;
     OperationType operation_type;
-    int plane_id;
+    PlaneMsg plane;
     double sigma;
-    std::queue<int> pending_landings;  // holds landing planes that arrive while busy
-    std::queue<int> pending_takeoffs;  // holds takeoff planes that arrive while busy
+    PendingPlanes pending_landings;  // holds landing planes that arrive while busy
+    PendingPlanes pending_takeoffs;  // holds takeoff planes that arrive while busy
+    TowerSignalling signalling;
+    bool held_landing;               // landing queue is stopped or waiting for done
+    bool held_takeoff;               // takeoff queue is stopped or waiting for done
 
     static constexpr double RUNWAY_TIME = 60.0;  // 1 min for runway ops
 
-    explicit ControlTowerState()
+    explicit ControlTowerState(TowerScheduling scheduling = TowerScheduling::FIFO,
+                               TowerSignalling signalling = TowerSignalling::FULL)
         : phase(TowerPhase::IDLE),
           operation_type(OperationType::NONE),
-          plane_id(0),
+          plane(),
           sigma(std::numeric_limits<double>::infinity()),
-          pending_landings(),
-          pending_takeoffs() {}
+          pending_landings(scheduling == TowerScheduling::PRIORITY),
+          pending_takeoffs(scheduling == TowerScheduling::PRIORITY),
+          signalling(signalling),
+          held_landing(false),
+          held_takeoff(false) {}
+
+    // same as a new ControlTowerState(scheduling, signalling), buffer storage kept
+    void reset(TowerScheduling scheduling, TowerSignalling new_signalling) {
+        phase = TowerPhase::IDLE;
+        operation_type = OperationType::NONE;
+        plane = PlaneMsg();
+        sigma = std::numeric_limits<double>::infinity();
+        pending_landings.reset(scheduling == TowerScheduling::PRIORITY);
+        pending_takeoffs.reset(scheduling == TowerScheduling::PRIORITY);
+        signalling = new_signalling;
+        held_landing = false;
+        held_takeoff = false;
+    }
 };
 
 std::ostream& operator<<(std::ostream &out, const ControlTowerState& state) {
@@ -62,7 +161,7 @@ std::ostream& operator<<(std::ostream &out, const ControlTowerState& state) {
         case OperationType::TAKEOFF: opStr = "TAKEOFF"; break;
     }
     out << "{phase=" << phaseStr << ", op=" << opStr
-        << ", plane=" << state.plane_id
+        << ", plane=" << state.plane
         << ", pendingL=" << state.pending_landings.size()
         << ", pendingT=" << state.pending_takeoffs.size()
         << ", sigma=" << state.sigma << "}";
@@ -72,33 +171,44 @@ std::ostream& operator<<(std::ostream &out, const ControlTowerState& state) {
 class ControlTower : public Atomic<ControlTowerState> {
 public:
     // inputs
-    Port<int> in_landing;
-    Port<int> in_takeoff;
+    PooledPort<PlaneMsg> in_landing;
+    PooledPort<PlaneMsg> in_takeoff;
+    PooledPort<PlaneMsg> in_priority;  // new priority for a holding plane (PRIORITY mode)
 
     // outputs
-    Port<int> stop_landing;
-    Port<int> stop_takeoff;
-    Port<int> done_landing;
-    Port<int> done_takeoff;
-    Port<int> land;
-    Port<int> takeoff;
-
-    ControlTower(const std::string& id) : Atomic<ControlTowerState>(id, ControlTowerState()) {
-        in_landing = addInPort<int>("in_landing");
-        in_takeoff = addInPort<int>("in_takeoff");
-
-        stop_landing = addOutPort<int>("stop_landing");
-        stop_takeoff = addOutPort<int>("stop_takeoff");
-        done_landing = addOutPort<int>("done_landing");
-        done_takeoff = addOutPort<int>("done_takeoff");
-        land = addOutPort<int>("land");
-        takeoff = addOutPort<int>("takeoff");
+    PooledPort<int> stop_landing;
+    PooledPort<int> stop_takeoff;
+    PooledPort<int> done_landing;
+    PooledPort<int> done_takeoff;
+    PooledPort<PlaneMsg> land;
+    PooledPort<PlaneMsg> takeoff;
+
+    ControlTower(const std::string& id, TowerScheduling scheduling = TowerScheduling::FIFO,
+                 TowerSignalling signalling = TowerSignalling::FULL)
+        : Atomic<ControlTowerState>(id, ControlTowerState(scheduling, signalling)) {
+        in_landing = addPooledInPort<PlaneMsg>(this, "in_landing");
+        in_takeoff = addPooledInPort<PlaneMsg>(this, "in_takeoff");
+        in_priority = addPooledInPort<PlaneMsg>(this, "in_priority");
+
+        stop_landing = addPooledOutPort<int>(this, "stop_landing");
+        stop_takeoff = addPooledOutPort<int>(this, "stop_takeoff");
+        done_landing = addPooledOutPort<int>(this, "done_landing");
+        done_takeoff = addPooledOutPort<int>(this, "done_takeoff");
+        land = addPooledOutPort<PlaneMsg>(this, "land");
+        takeoff = addPooledOutPort<PlaneMsg>(this, "takeoff");
+    }
+
+    // back to the initial state for a new run, with new tower options
+    void reset(TowerScheduling scheduling = TowerScheduling::FIFO, TowerSignalling signalling = TowerSignalling::FULL) {
+        state.reset(scheduling, signalling);
     }
 
     void internalTransition(ControlTowerState& state) const override {
         switch (state.phase) {
             case TowerPhase::SIGNAL:
                 // commands sent, now wait for runway
+                state.held_landing = true;
+                state.held_takeoff = true;
                 state.phase = TowerPhase::WAIT;
                 state.sigma = ControlTowerState::RUNWAY_TIME;
                 break;
@@ -107,20 +217,22 @@ public:
                 // runway done, check pending planes (landing has priority)
                 if (!state.pending_landings.empty()) {
                     // process buffered landing
-                    state.plane_id = state.pending_landings.front();
+                    state.plane = state.pending_landings.front();
                     state.pending_landings.pop();
                     state.operation_type = OperationType::LANDING;
                     state.phase = TowerPhase::SIGNAL;
                     state.sigma = 0.0;
                 } else if (!state.pending_takeoffs.empty()) {
                     // process buffered takeoff
-                    state.plane_id = state.pending_takeoffs.front();
+                    state.plane = state.pending_takeoffs.front();
                     state.pending_takeoffs.pop();
                     state.operation_type = OperationType::TAKEOFF;
                     state.phase = TowerPhase::SIGNAL;
                     state.sigma = 0.0;
                 } else {
                     // nothing pending, go back to idle
+                    state.held_landing = false;
+                    state.held_takeoff = false;
                     state.phase = TowerPhase::IDLE;
                     state.operation_type = OperationType::NONE;
                     state.sigma = std::numeric_limits<double>::infinity();
@@ -135,15 +247,25 @@ public:
 
     void externalTransition(ControlTowerState& state, double e) const override {
         // always buffer inputs to prevent plane loss when both queues send at once
+        // a queue that sent a plane waits for done, no need to stop it
         if (!in_landing->empty()) {
             for (const auto& plane : in_landing->getBag()) {
                 state.pending_landings.push(plane);
             }
+            state.held_landing = true;
         }
         if (!in_takeoff->empty()) {
             for (const auto& plane : in_takeoff->getBag()) {
                 state.pending_takeoffs.push(plane);
             }
+            state.held_takeoff = true;
+        }
+
+        // emergencies declared while holding move the plane up the queue
+        for (const auto& update : in_priority->getBag()) {
+            if (!state.pending_landings.updatePriority(planeId(update), planePriority(update))) {
+                state.pending_takeoffs.updatePriority(planeId(update), planePriority(update));
+            }
         }
 
         // only process when idle
@@ -151,7 +273,7 @@ public:
 
         // landing has priority
         if (!state.pending_landings.empty()) {
-            state.plane_id = state.pending_landings.front();
+            state.plane = state.pending_landings.front();
             state.pending_landings.pop();
             state.operation_type = OperationType::LANDING;
             state.phase = TowerPhase::SIGNAL;
@@ -159,7 +281,7 @@ public:
         }
         // otherwise process takeoffs
         else if (!state.pending_takeoffs.empty()) {
-            state.plane_id = state.pending_takeoffs.front();
+            state.plane = state.pending_takeoffs.front();
             state.pending_takeoffs.pop();
             state.operation_type = OperationType::TAKEOFF;
             state.phase = TowerPhase::SIGNAL;
@@ -171,21 +293,33 @@ public:
         switch (state.phase) {
             case TowerPhase::SIGNAL:
                 // stop both queues while runway is in use
-                stop_landing->addMessage(1);
-                stop_takeoff->addMessage(1);
+                if (state.signalling == TowerSignalling::FULL) {
+                    stop_landing->addMessage(1);
+                    stop_takeoff->addMessage(1);
+                } else {
+                    if (!state.held_landing) stop_landing->addMessage(1);
+                    if (!state.held_takeoff) stop_takeoff->addMessage(1);
+                }
 
                 // tell runway what to do
                 if (state.operation_type == OperationType::LANDING) {
-                    land->addMessage(state.plane_id);
+                    land->addMessage(state.plane);
                 } else if (state.operation_type == OperationType::TAKEOFF) {
-                    takeoff->addMessage(state.plane_id);
+                    takeoff->addMessage(state.plane);
                 }
                 break;
 
             case TowerPhase::WAIT:
                 // let queues know they can send again
-                done_landing->addMessage(1);
-                done_takeoff->addMessage(1);
+                if (state.signalling == TowerSignalling::COALESCED &&
+                    (!state.pending_landings.empty() || !state.pending_takeoffs.empty())) {
+                    // next operation starts now, the queues stay stopped after one send
+                    done_landing->addMessage(QUEUE_HANDOVER);
+                    done_takeoff->addMessage(QUEUE_HANDOVER);
+                } else {
+                    done_landing->addMessage(QUEUE_DONE);
+                    done_takeoff->addMessage(QUEUE_DONE);
+                }
                 break;
 
             case TowerPhase::IDLE:
@@ -15,8 +15,10 @@
 #define MERGER_HPP
 
 #include <cadmium/modeling/devs/atomic.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../data_structures/ring_queue.hpp"
 #include <iostream>
-#include <queue>
 #include <limits>
 
 using namespace cadmium;
@@ -25,12 +27,19 @@ enum class MergerPhase { IDLE, ACTIVE };
 
 struct MergerState {
     MergerPhase phase;
-    std::queue<int> elements;
+    RingQueue<PlaneMsg> elements;
     double sigma;
 
     explicit MergerState()
         : phase(MergerPhase::IDLE),
           sigma(std::numeric_limits<double>::infinity()) {}
+
+    // initial state, buffer storage kept
+    void reset() {
+        phase = MergerPhase::IDLE;
+        elements.clear();
+        sigma = std::numeric_limits<double>::infinity();
+    }
 };
 
 std::ostream& operator<<(std::ostream &out, const MergerState& state) {
@@ -42,20 +51,23 @@ std::ostream& operator<<(std::ostream &out, const MergerState& state) {
 
 class Merger : public Atomic<MergerState> {
 public:
-    Port<int> in1;  // from bay 1
-    Port<int> in2;  // from bay 2
-    Port<int> in3;  // from bay 3
-    Port<int> in4;  // from bay 4
-    Port<int> out;
+    PooledPort<PlaneMsg> in1;  // from bay 1
+    PooledPort<PlaneMsg> in2;  // from bay 2
+    PooledPort<PlaneMsg> in3;  // from bay 3
+    PooledPort<PlaneMsg> in4;  // from bay 4
+    PooledPort<PlaneMsg> out;
 
     Merger(const std::string& id) : Atomic<MergerState>(id, MergerState()) {
-        in1 = addInPort<int>("in1");
-        in2 = addInPort<int>("in2");
-        in3 = addInPort<int>("in3");
-        in4 = addInPort<int>("in4");
-        out = addOutPort<int>("out");
+        in1 = addPooledInPort<PlaneMsg>(this, "in1");
+        in2 = addPooledInPort<PlaneMsg>(this, "in2");
+        in3 = addPooledInPort<PlaneMsg>(this, "in3");
+        in4 = addPooledInPort<PlaneMsg>(this, "in4");
+        out = addPooledOutPort<PlaneMsg>(this, "out");
     }
 
+    // back to the initial state for a new run
+    void reset() { state.reset(); }
+
     // output done check for more
     void internalTransition(MergerState& state) const override {
         if (!state.elements.empty()) {
@@ -73,17 +85,17 @@ public:
     // planes arrive from any bay
     void externalTransition(MergerState& state, double e) const override {
         // add planes from all inputs in order
-        for (const auto& plane_id : in1->getBag()) {
-            state.elements.push(plane_id);
+        for (const auto& plane : in1->getBag()) {
+            state.elements.push(plane);
         }
-        for (const auto& plane_id : in2->getBag()) {
-            state.elements.push(plane_id);
+        for (const auto& plane : in2->getBag()) {
+            state.elements.push(plane);
         }
-        for (const auto& plane_id : in3->getBag()) {
-            state.elements.push(plane_id);
+        for (const auto& plane : in3->getBag()) {
+            state.elements.push(plane);
         }
-        for (const auto& plane_id : in4->getBag()) {
-            state.elements.push(plane_id);
+        for (const auto& plane : in4->getBag()) {
+            state.elements.push(plane);
         }
 
         if (!state.elements.empty()) {
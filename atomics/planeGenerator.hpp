@@ -0,0 +1,202 @@
+/*
+ * Plane Generator Atomic Model
+ *
+ * Replays plane arrivals from an input file, one line per arrival:
+ *   time plane_id [class priority fuel dwell]
+ * Works like Cadmium's IEStream (one message per transition, only the
+ * next line is held in memory) but stamps each plane with its arrival
+ * time so downstream models can measure delays.
+ *
+ * The input does not have to be a regular file: "-" reads standard
+ * input, and a FIFO path is read as it is written. Input is read through
+ * a fixed-size LineReader buffer, so an endless stream piped in from
+ * another tool runs in bounded memory. The generator goes passive when
+ * the writer closes its end. Blank and unparsable lines are skipped.
+ * resetFromText() replays arrival lines held in memory instead, for
+ * callers that get the arrivals over a socket (see WhatIfServer).
+ *
+ * State prints the time to the next arrival, same as IEStream, so
+ * traces are unchanged by the switch.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ */
+
+#ifndef PLANE_GENERATOR_HPP
+#define PLANE_GENERATOR_HPP
+
+#include <cadmium/modeling/devs/atomic.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../data_structures/line_reader.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+
+using namespace cadmium;
+
+// input descriptor plus its line buffer, closes the descriptor it opened;
+// or, after useText, arrival lines held in memory
+struct PlaneSource {
+    int fd;
+    bool owned;
+    LineReader reader;
+    bool in_memory;
+    std::string text;
+    std::size_t offset;  // next unread byte of text
+
+    explicit PlaneSource(const char* input_file)
+        : fd(openInput(input_file)),
+          owned(fd != STDIN_FILENO),
+          reader(fd),
+          in_memory(false),
+          text(),
+          offset(0) {}
+
+    ~PlaneSource() {
+        if (owned && fd >= 0) ::close(fd);
+    }
+
+    static int openInput(const char* input_file) {
+        return std::strcmp(input_file, "-") == 0 ? STDIN_FILENO : ::open(input_file, O_RDONLY);
+    }
+
+    // close the current input and read input_file from the start, keeping the buffer
+    void reopen(const char* input_file) {
+        if (owned && fd >= 0) ::close(fd);
+        fd = openInput(input_file);
+        owned = (fd != STDIN_FILENO);
+        reader.reset(fd);
+        in_memory = false;
+    }
+
+    // close the current input and read the lines of arrivals instead
+    void useText(std::string arrivals) {
+        if (owned && fd >= 0) ::close(fd);
+        fd = -1;
+        owned = false;
+        reader.reset(fd);
+        in_memory = true;
+        text = std::move(arrivals);
+        offset = 0;
+    }
+
+    [[nodiscard]] bool readable() const { return in_memory || fd >= 0; }
+
+    // next line of either input, false at the end
+    bool next(std::string_view& line) {
+        if (!in_memory) return reader.next(line) == LineReader::Status::LINE;
+        if (offset >= text.size()) return false;
+        std::size_t end = text.find('\n', offset);
+        if (end == std::string::npos) end = text.size();
+        line = std::string_view(text).substr(offset, end - offset);
+        offset = end + 1;
+        return true;
+    }
+
+    PlaneSource(const PlaneSource&) = delete;
+    PlaneSource& operator=(const PlaneSource&) = delete;
+};
+
+struct PlaneGeneratorState {
+    std::shared_ptr<PlaneSource> source;  // shared so the state stays copyable
+    double clock;
+    double sigma;
+    PlaneMsg next_plane;
+
+    explicit PlaneGeneratorState(const char* input_file)
+        : source(std::make_shared<PlaneSource>(input_file)),
+          clock(0),
+          sigma(std::numeric_limits<double>::infinity()),
+          next_plane() {}
+
+    // same as a new PlaneGeneratorState(input_file), the source is reopened in place
+    void reset(const char* input_file) {
+        source->reopen(input_file);
+        restart();
+    }
+
+    void resetFromText(std::string arrivals) {
+        source->useText(std::move(arrivals));
+        restart();
+    }
+
+    void restart() {
+        clock = 0;
+        sigma = std::numeric_limits<double>::infinity();
+        next_plane = PlaneMsg();
+    }
+};
+
+std::ostream& operator<<(std::ostream &out, const PlaneGeneratorState& state) {
+    out << state.sigma;
+    return out;
+}
+
+class PlaneGenerator : public Atomic<PlaneGeneratorState> {
+public:
+    PooledPort<PlaneMsg> out;
+
+    PlaneGenerator(const std::string& id, const char* input_file) : Atomic<PlaneGeneratorState>(id, PlaneGeneratorState(input_file)) {
+        out = addPooledOutPort<PlaneMsg>(this, "out");
+        readFirst(input_file);
+    }
+
+    // back to the initial state for a new run, replaying input_file from its first line
+    void reset(const char* input_file) {
+        state.reset(input_file);
+        readFirst(input_file);
+    }
+
+    // same, replaying the arrival lines in arrivals (input file format)
+    void resetFromText(std::string arrivals) {
+        state.resetFromText(std::move(arrivals));
+        readNext(state);
+    }
+
+    // read the next arrival and schedule it
+    static void readNext(PlaneGeneratorState& state) {
+        state.sigma = std::numeric_limits<double>::infinity();
+        if (!state.source->readable()) return;
+
+        std::string_view line;
+        while (state.source->next(line)) {
+            double time;
+            if (!parsePlaneLine(line, time, state.next_plane)) continue;
+            // out of order lines are sent right away
+            state.sigma = (time > state.clock) ? time - state.clock : 0.0;
+            stampArrival(state.next_plane, state.clock + state.sigma);
+            return;
+        }
+    }
+
+    void internalTransition(PlaneGeneratorState& state) const override {
+        state.clock += state.sigma;
+        readNext(state);
+    }
+
+    void externalTransition(PlaneGeneratorState& state, double e) const override {}
+
+    void output(const PlaneGeneratorState& state) const override {
+        out->addMessage(state.next_plane);
+    }
+
+    [[nodiscard]] double timeAdvance(const PlaneGeneratorState& state) const override {
+        return state.sigma;
+    }
+
+private:
+    void readFirst(const char* input_file) {
+        if (state.source->fd < 0) {
+            std::cerr << "Warning: could not open input file " << input_file << std::endl;
+        }
+        readNext(state);
+    }
+};
+
+#endif
@@ -9,6 +9,16 @@
  *   - SENDING: About to output front plane (Ta = 0)
  *   - WAIT_ACK: Sent plane, waiting for tower to finish
  *
+ * Capacity: 0 (default) keeps every plane. With a capacity the buffer is
+ * allocated once and never grows; a plane that does not fit is sent on
+ * the overflow port the same instant and counted in diverted. The
+ * holding policy picks the plane to divert: the newest arrival, or the
+ * oldest plane still waiting so the newcomer takes its place.
+ *
+ * A done carrying QUEUE_HANDOVER means the tower starts its next runway
+ * operation at once: the queue resumes, sends its front plane if it has
+ * one, and is stopped again, as if a stop had followed the done.
+ *
  * Authors: Hasib Khodayar & Hajar Assim
  */
 
@@ -16,24 +26,54 @@
 #define QUEUE_HPP
 
 #include <cadmium/modeling/devs/atomic.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../data_structures/ring_queue.hpp"
 #include <iostream>
-#include <queue>
 #include <limits>
 
 using namespace cadmium;
 
 enum class QueuePhase { IDLE, SENDING, WAIT_ACK };
+enum class QueueOverflow { DIVERT_NEWEST, DIVERT_OLDEST };
+
+// values on the done port
+constexpr int QUEUE_DONE = 1;
+constexpr int QUEUE_HANDOVER = 2;  // done, then stop once the next plane is sent
 
 struct QueueState {
     QueuePhase phase;
-    std::queue<int> elements;
+    RingQueue<PlaneMsg> elements;
     bool busy;  // true when tower said stop
     double sigma;
+    std::size_t capacity;                // 0 = unbounded
+    QueueOverflow policy;
+    RingQueue<PlaneMsg> diverting;       // diverted this instant, sent on overflow
+    unsigned long long diverted;         // total planes diverted
 
-    explicit QueueState()
+    explicit QueueState(std::size_t capacity = 0, QueueOverflow policy = QueueOverflow::DIVERT_NEWEST)
         : phase(QueuePhase::IDLE),
           busy(false),
-          sigma(std::numeric_limits<double>::infinity()) {}
+          sigma(std::numeric_limits<double>::infinity()),
+          capacity(capacity),
+          policy(policy),
+          diverting(),
+          diverted(0) {
+        if (capacity > 0) elements.reserve(capacity);
+    }
+
+    // same as a new QueueState(capacity, policy), buffer storage kept
+    void reset(std::size_t new_capacity, QueueOverflow new_policy) {
+        phase = QueuePhase::IDLE;
+        elements.clear();
+        busy = false;
+        sigma = std::numeric_limits<double>::infinity();
+        capacity = new_capacity;
+        policy = new_policy;
+        diverting.clear();
+        diverted = 0;
+        if (capacity > 0) elements.reserve(capacity);
+    }
 };
 
 std::ostream& operator<<(std::ostream &out, const QueueState& state) {
@@ -44,33 +84,44 @@ std::ostream& operator<<(std::ostream &out, const QueueState& state) {
         case QueuePhase::WAIT_ACK: phaseStr = "WAIT_ACK"; break;
     }
     out << "{phase=" << phaseStr << ", size=" << state.elements.size()
-        << ", busy=" << state.busy << ", sigma=" << state.sigma << "}";
+        << ", busy=" << state.busy;
+    if (state.capacity > 0) out << ", diverted=" << state.diverted;
+    out << ", sigma=" << state.sigma << "}";
     return out;
 }
 
 class Queue : public Atomic<QueueState> {
 public:
-    Port<int> in;
-    Port<int> stop;
-    Port<int> done;
-    Port<int> out;
-
-    Queue(const std::string& id) : Atomic<QueueState>(id, QueueState()) {
-        in = addInPort<int>("in");
-        stop = addInPort<int>("stop");
-        done = addInPort<int>("done");
-        out = addOutPort<int>("out");
+    PooledPort<PlaneMsg> in;
+    PooledPort<int> stop;
+    PooledPort<int> done;
+    PooledPort<PlaneMsg> out;
+    PooledPort<PlaneMsg> overflow;  // planes turned away by a full queue
+
+    Queue(const std::string& id, std::size_t capacity = 0, QueueOverflow policy = QueueOverflow::DIVERT_NEWEST)
+        : Atomic<QueueState>(id, QueueState(capacity, policy)) {
+        in = addPooledInPort<PlaneMsg>(this, "in");
+        stop = addPooledInPort<int>(this, "stop");
+        done = addPooledInPort<int>(this, "done");
+        out = addPooledOutPort<PlaneMsg>(this, "out");
+        overflow = addPooledOutPort<PlaneMsg>(this, "overflow");
+    }
+
+    // back to the initial state for a new run, with new limits
+    void reset(std::size_t capacity = 0, QueueOverflow policy = QueueOverflow::DIVERT_NEWEST) {
+        state.reset(capacity, policy);
     }
 
     // after sending wait for ack
     void internalTransition(QueueState& state) const override {
+        state.diverting.clear();
         if (state.phase == QueuePhase::SENDING) {
             if (!state.elements.empty()) {
                 state.elements.pop();
             }
             state.phase = QueuePhase::WAIT_ACK;
-            state.sigma = std::numeric_limits<double>::infinity();
         }
+        state.sigma = std::numeric_limits<double>::infinity();
     }
 
     // handle stop done and new planes
@@ -85,8 +136,12 @@ public:
         }
 
         // done signal tower finished we can resume
+        bool handover = false;
         if (!done->empty()) {
             state.busy = false;
+            for (int signal : done->getBag()) {
+                if (signal == QUEUE_HANDOVER) handover = true;
+            }
 
             if (state.phase == QueuePhase::WAIT_ACK) {
                 state.phase = QueuePhase::IDLE;
@@ -99,9 +154,19 @@ public:
             }
         }
 
-        // new planes coming in always add them
-        for (const auto& plane_id : in->getBag()) {
-            state.elements.push(plane_id);
+        // new planes coming in, divert one when full
+        for (const auto& plane : in->getBag()) {
+            if (state.capacity == 0 || state.elements.size() < state.capacity) {
+                state.elements.push(plane);
+            } else if (state.policy == QueueOverflow::DIVERT_NEWEST) {
+                state.diverting.push(plane);
+                state.diverted++;
+            } else {
+                state.diverting.push(state.elements.front());
+                state.elements.pop();
+                state.elements.push(plane);
+                state.diverted++;
+            }
         }
 
         // if we can send and have planes do it
@@ -111,13 +176,24 @@ public:
             state.phase = QueuePhase::SENDING;
             state.sigma = 0.0;
         }
+
+        // tower is busy again right away, hold after this send
+        if (handover) state.busy = true;
+
+        // diverted planes leave right away
+        if (!state.diverting.empty()) {
+            state.sigma = 0.0;
+        }
     }
 
-    // send front plane
+    // send front plane and any diverted planes
     void output(const QueueState& state) const override {
         if (state.phase == QueuePhase::SENDING && !state.elements.empty()) {
             out->addMessage(state.elements.front());
         }
+        for (std::size_t i = 0; i < state.diverting.size(); i++) {
+            overflow->addMessage(state.diverting[i]);
+        }
     }
 
     [[nodiscard]] double timeAdvance(const QueueState& state) const override {
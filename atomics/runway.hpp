@@ -15,6 +15,8 @@
 #define RUNWAY_HPP
 
 #include <cadmium/modeling/devs/atomic.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
 #include <iostream>
 #include <limits>
 
@@ -24,15 +26,21 @@ enum class RunwayPhase { IDLE, LANDING, TAKEOFF };
 
 struct RunwayState {
     RunwayPhase phase;
-    int plane_id;
+    PlaneMsg plane;
     double sigma;
 
     static constexpr double RUNWAY_TIME = 60.0;  // 1 min
 
     explicit RunwayState()
         : phase(RunwayPhase::IDLE),
-          plane_id(0),
+          plane(),
           sigma(std::numeric_limits<double>::infinity()) {}
+
+    void reset() {
+        phase = RunwayPhase::IDLE;
+        plane = PlaneMsg();
+        sigma = std::numeric_limits<double>::infinity();
+    }
 };
 
 std::ostream& operator<<(std::ostream &out, const RunwayState& state) {
@@ -42,25 +50,28 @@ std::ostream& operator<<(std::ostream &out, const RunwayState& state) {
         case RunwayPhase::LANDING: phaseStr = "LANDING"; break;
         case RunwayPhase::TAKEOFF: phaseStr = "TAKEOFF"; break;
     }
-    out << "{phase=" << phaseStr << ", plane=" << state.plane_id
+    out << "{phase=" << phaseStr << ", plane=" << state.plane
         << ", sigma=" << state.sigma << "}";
     return out;
 }
 
 class Runway : public Atomic<RunwayState> {
 public:
-    Port<int> land;
-    Port<int> takeoff;
-    Port<int> landing_exit;
-    Port<int> takeoff_exit;
+    PooledPort<PlaneMsg> land;
+    PooledPort<PlaneMsg> takeoff;
+    PooledPort<PlaneMsg> landing_exit;
+    PooledPort<PlaneMsg> takeoff_exit;
 
     Runway(const std::string& id) : Atomic<RunwayState>(id, RunwayState()) {
-        land = addInPort<int>("land");
-        takeoff = addInPort<int>("takeoff");
-        landing_exit = addOutPort<int>("landing_exit");
-        takeoff_exit = addOutPort<int>("takeoff_exit");
+        land = addPooledInPort<PlaneMsg>(this, "land");
+        takeoff = addPooledInPort<PlaneMsg>(this, "takeoff");
+        landing_exit = addPooledOutPort<PlaneMsg>(this, "landing_exit");
+        takeoff_exit = addPooledOutPort<PlaneMsg>(this, "takeoff_exit");
     }
 
+    // back to the initial state for a new run
+    void reset() { state.reset(); }
+
     // go back to idle after operation
     void internalTransition(RunwayState& state) const override {
         state.phase = RunwayPhase::IDLE;
@@ -70,12 +81,12 @@ public:
     // start landing or takeoff
     void externalTransition(RunwayState& state, double e) const override {
         if (!land->empty()) {
-            state.plane_id = land->getBag().back();
+            state.plane = land->getBag().back();
             state.phase = RunwayPhase::LANDING;
             state.sigma = RunwayState::RUNWAY_TIME;
         }
         else if (!takeoff->empty()) {
-            state.plane_id = takeoff->getBag().back();
+            state.plane = takeoff->getBag().back();
             state.phase = RunwayPhase::TAKEOFF;
             state.sigma = RunwayState::RUNWAY_TIME;
         }
@@ -85,10 +96,10 @@ public:
     void output(const RunwayState& state) const override {
         switch (state.phase) {
             case RunwayPhase::LANDING:
-                landing_exit->addMessage(state.plane_id);
+                landing_exit->addMessage(state.plane);
                 break;
             case RunwayPhase::TAKEOFF:
-                takeoff_exit->addMessage(state.plane_id);
+                takeoff_exit->addMessage(state.plane);
                 break;
             case RunwayPhase::IDLE:
                 break;
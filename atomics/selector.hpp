@@ -17,8 +17,10 @@
 #define SELECTOR_HPP
 
 #include <cadmium/modeling/devs/atomic.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../data_structures/ring_queue.hpp"
 #include <iostream>
-#include <queue>
 #include <limits>
 
 using namespace cadmium;
@@ -27,8 +29,8 @@ enum class SelectorPhase { IDLE, ROUTING };
 
 struct SelectorState {
     SelectorPhase phase;
-    std::queue<int> pending_planes;
-    int current_plane;
+    RingQueue<PlaneMsg> pending_planes;
+    PlaneMsg current_plane;
     double sigma;
 
     static constexpr double ROUTING_TIME = 30.0;  // 30 seconds to route
@@ -41,8 +43,16 @@ struct SelectorState {
 
     explicit SelectorState()
         : phase(SelectorPhase::IDLE),
-          current_plane(0),
+          current_plane(),
           sigma(std::numeric_limits<double>::infinity()) {}
+
+    // initial state, pending buffer storage kept
+    void reset() {
+        phase = SelectorPhase::IDLE;
+        pending_planes.clear();
+        current_plane = PlaneMsg();
+        sigma = std::numeric_limits<double>::infinity();
+    }
 };
 
 std::ostream& operator<<(std::ostream &out, const SelectorState& state) {
@@ -54,20 +64,23 @@ std::ostream& operator<<(std::ostream &out, const SelectorState& state) {
 
 class Selector : public Atomic<SelectorState> {
 public:
-    Port<int> in;
-    Port<int> out1;  // bay 1
-    Port<int> out2;  // bay 2
-    Port<int> out3;  // bay 3
-    Port<int> out4;  // bay 4
+    PooledPort<PlaneMsg> in;
+    PooledPort<PlaneMsg> out1;  // bay 1
+    PooledPort<PlaneMsg> out2;  // bay 2
+    PooledPort<PlaneMsg> out3;  // bay 3
+    PooledPort<PlaneMsg> out4;  // bay 4
 
     Selector(const std::string& id) : Atomic<SelectorState>(id, SelectorState()) {
-        in = addInPort<int>("in");
-        out1 = addOutPort<int>("out1");
-        out2 = addOutPort<int>("out2");
-        out3 = addOutPort<int>("out3");
-        out4 = addOutPort<int>("out4");
+        in = addPooledInPort<PlaneMsg>(this, "in");
+        out1 = addPooledOutPort<PlaneMsg>(this, "out1");
+        out2 = addPooledOutPort<PlaneMsg>(this, "out2");
+        out3 = addPooledOutPort<PlaneMsg>(this, "out3");
+        out4 = addPooledOutPort<PlaneMsg>(this, "out4");
     }
 
+    // back to the initial state for a new run
+    void reset() { state.reset(); }
+
     // check if more planes waiting
     void internalTransition(SelectorState& state) const override {
         if (!state.pending_planes.empty()) {
@@ -88,15 +101,15 @@ public:
             state.sigma -= e;
         }
 
-        for (const auto& plane_id : in->getBag()) {
+        for (const auto& plane : in->getBag()) {
             if (state.phase == SelectorPhase::IDLE) {
                 // start routing right away
-                state.current_plane = plane_id;
+                state.current_plane = plane;
                 state.phase = SelectorPhase::ROUTING;
                 state.sigma = SelectorState::ROUTING_TIME;
             } else {
                 // already busy queue it
-                state.pending_planes.push(plane_id);
+                state.pending_planes.push(plane);
             }
         }
     }
@@ -105,20 +118,21 @@ public:
     void output(const SelectorState& state) const override {
         if (state.phase != SelectorPhase::ROUTING) return;
 
-        int id = state.current_plane;
+        const PlaneMsg& plane = state.current_plane;
+        int id = planeId(plane);
 
         if (id <= SelectorState::BAY1_MAX) {
-            out1->addMessage(id);
+            out1->addMessage(plane);
         } else if (id <= SelectorState::BAY2_MAX) {
-            out2->addMessage(id);
+            out2->addMessage(plane);
         } else if (id <= SelectorState::BAY3_MAX) {
-            out3->addMessage(id);
+            out3->addMessage(plane);
         } else if (id <= SelectorState::BAY4_MAX) {
-            out4->addMessage(id);
+            out4->addMessage(plane);
         } else {
             // out of range send to bay 4 anyway
             std::cerr << "Warning: Plane ID " << id << " out of range, sending to Bay 4" << std::endl;
-            out4->addMessage(id);
+            out4->addMessage(plane);
         }
     }
 
@@ -4,9 +4,18 @@
  * Stores planes and forwards them to the merger immediately.
  * Basically a pass-through buffer - planes come in and go out right away.
  *
- * States: IDLE, ACTIVE
+ * States: IDLE, ACTIVE, PARKED
  *   - IDLE: No planes
  *   - ACTIVE: Outputting planes (Ta = 0)
+ *   - PARKED: Planes parked, waiting for the next dwell to end
+ *
+ * Dwell mode (DwellConfig::enabled) parks each plane for its turnaround
+ * before releasing it. The dwell comes from the message when it carries
+ * one, otherwise from the config: a fixed time or an exponential draw
+ * with that mean. Parked planes sit in a timer wheel, so parking and
+ * release are O(1) however many planes the bay holds, and the time
+ * advance is the wheel's next deadline. Release times are rounded up to
+ * the wheel resolution; one past the wheel's last tick never comes.
  *
  * Authors: Hasib Khodayar & Hajar Assim
  */
@@ -15,43 +24,143 @@
 #define STORAGE_BAY_HPP
 
 #include <cadmium/modeling/devs/atomic.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../data_structures/ring_queue.hpp"
+#include "../data_structures/timer_wheel.hpp"
+#include <cmath>
+#include <cstdint>
 #include <iostream>
-#include <queue>
 #include <limits>
+#include <random>
 
 using namespace cadmium;
 
-enum class StorageBayPhase { IDLE, ACTIVE };
+enum class StorageBayPhase { IDLE, ACTIVE, PARKED };
+
+// hangar turnaround options, disabled keeps the pass-through bay
+struct DwellConfig {
+    bool enabled = false;
+    double dwell = 0.0;          // seconds for planes without their own dwell
+    bool exponential = false;    // draw those dwells from an exponential with mean dwell
+    double resolution = 1.0;     // seconds per wheel tick
+    std::uint64_t seed = 1;
+};
+
+using DwellTick = TimerWheel<PlaneMsg>::Tick;
+
+// a release beyond what a tick can count, the plane stays parked for good
+constexpr DwellTick NEVER_RELEASED = ~DwellTick(0);
+
+// wheel tick a release at time rounds up to, NEVER_RELEASED if time is not
+// finite or past the last tick, so the conversion is always in range
+inline DwellTick releaseTick(double time, double resolution) {
+    // small slack so exact multiples of the resolution are not pushed a tick late
+    double ticks = std::ceil(time / resolution - 1e-9);
+    if (!(ticks < static_cast<double>(NEVER_RELEASED))) return NEVER_RELEASED;
+    return ticks > 0 ? static_cast<DwellTick>(ticks) : 0;
+}
 
 struct StorageBayState {
     StorageBayPhase phase;
-    std::queue<int> elements;
+    RingQueue<PlaneMsg> elements;  // planes ready to leave
     double sigma;
+    DwellConfig dwell;
+    TimerWheel<PlaneMsg> parked;
+    double clock;
+    std::mt19937_64 rng;
 
-    explicit StorageBayState()
+    explicit StorageBayState(const DwellConfig& dwell = DwellConfig())
         : phase(StorageBayPhase::IDLE),
-          sigma(std::numeric_limits<double>::infinity()) {}
+          sigma(std::numeric_limits<double>::infinity()),
+          dwell(dwell),
+          parked(),
+          clock(0),
+          rng(dwell.seed) {}
+
+    // same as a new StorageBayState(dwell), buffer and wheel storage kept
+    void reset(const DwellConfig& new_dwell) {
+        phase = StorageBayPhase::IDLE;
+        elements.clear();
+        sigma = std::numeric_limits<double>::infinity();
+        dwell = new_dwell;
+        parked.clear();
+        clock = 0;
+        rng.seed(new_dwell.seed);
+    }
 };
 
 std::ostream& operator<<(std::ostream &out, const StorageBayState& state) {
-    std::string phaseStr = (state.phase == StorageBayPhase::IDLE) ? "IDLE" : "ACTIVE";
-    out << "{phase=" << phaseStr << ", size=" << state.elements.size()
-        << ", sigma=" << state.sigma << "}";
+    std::string phaseStr;
+    switch (state.phase) {
+        case StorageBayPhase::IDLE:   phaseStr = "IDLE"; break;
+        case StorageBayPhase::ACTIVE: phaseStr = "ACTIVE"; break;
+        case StorageBayPhase::PARKED: phaseStr = "PARKED"; break;
+    }
+    out << "{phase=" << phaseStr << ", size=" << state.elements.size();
+    if (state.dwell.enabled) out << ", parked=" << state.parked.size();
+    out << ", sigma=" << state.sigma << "}";
     return out;
 }
 
 class StorageBay : public Atomic<StorageBayState> {
 public:
-    Port<int> in;
-    Port<int> out;
+    PooledPort<PlaneMsg> in;
+    PooledPort<PlaneMsg> out;
+
+    StorageBay(const std::string& id, const DwellConfig& dwell = DwellConfig())
+        : Atomic<StorageBayState>(id, StorageBayState(dwell)) {
+        in = addPooledInPort<PlaneMsg>(this, "in");
+        out = addPooledOutPort<PlaneMsg>(this, "out");
+    }
 
-    StorageBay(const std::string& id) : Atomic<StorageBayState>(id, StorageBayState()) {
-        in = addInPort<int>("in");
-        out = addOutPort<int>("out");
+    // back to the initial state for a new run, with new dwell options
+    void reset(const DwellConfig& dwell = DwellConfig()) { state.reset(dwell); }
+
+    // park a plane until the end of its dwell
+    static void park(StorageBayState& state, const PlaneMsg& plane) {
+        double dwell = planeDwell(plane);
+        if (dwell <= 0) {
+            dwell = state.dwell.dwell;
+            if (state.dwell.exponential && dwell > 0) {
+                dwell = std::exponential_distribution<double>(1.0 / dwell)(state.rng);
+            }
+        }
+        state.parked.schedule(releaseTick(state.clock + dwell, state.dwell.resolution), plane);
+    }
+
+    // next phase once the ready planes and the wheel are known
+    static void schedule(StorageBayState& state) {
+        if (!state.elements.empty()) {
+            state.phase = StorageBayPhase::ACTIVE;
+            state.sigma = 0.0;
+        } else if (!state.parked.empty()) {
+            state.phase = StorageBayPhase::PARKED;
+            DwellTick next = state.parked.nextExpiry();
+            state.sigma = (next == NEVER_RELEASED) ? std::numeric_limits<double>::infinity()
+                                                   : next * state.dwell.resolution - state.clock;
+        } else {
+            state.phase = StorageBayPhase::IDLE;
+            state.sigma = std::numeric_limits<double>::infinity();
+        }
     }
 
     // output done check for more
     void internalTransition(StorageBayState& state) const override {
+        if (state.dwell.enabled) {
+            if (state.phase == StorageBayPhase::ACTIVE) {
+                state.elements.pop();
+            } else if (state.phase == StorageBayPhase::PARKED) {
+                // dwell ended, move every plane due now to the ready buffer
+                auto tick = state.parked.nextExpiry();
+                state.clock = tick * state.dwell.resolution;
+                state.parked.advance(tick);
+                state.parked.expire([&state](const PlaneMsg& plane) { state.elements.push(plane); });
+            }
+            schedule(state);
+            return;
+        }
+
         if (!state.elements.empty()) {
             state.elements.pop();
         }
@@ -68,8 +177,17 @@ public:
 
     // new planes arrive
     void externalTransition(StorageBayState& state, double e) const override {
-        for (const auto& plane_id : in->getBag()) {
-            state.elements.push(plane_id);
+        if (state.dwell.enabled) {
+            state.clock += e;
+            for (const auto& plane : in->getBag()) {
+                park(state, plane);
+            }
+            schedule(state);
+            return;
+        }
+
+        for (const auto& plane : in->getBag()) {
+            state.elements.push(plane);
         }
 
         if (!state.elements.empty()) {
@@ -0,0 +1,177 @@
+/*
+ * Batch Run Benchmark
+ *
+ * Times a batch of short airport runs, the way replications and
+ * parameter sweeps use the model, three ways:
+ *   - rebuild: a new model and RootCoordinator for every run
+ *   - reset:   one model reset in place, a new RootCoordinator per run
+ *   - reuse:   one model and one FlatCoordinator, both reset in place
+ * Every run gets a new input file (cycling through a few written up
+ * front) and new options: hangar dwell seed and queue capacity change
+ * from run to run. Setup (building or resetting) and simulation are timed
+ * separately. Each run is traced with the FingerprintLogger, and the
+ * benchmark fails unless the three batches give the same traces.
+ *
+ * Usage: BATCH_BENCH [runs] [planes_per_run]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include <cadmium/simulation/root_coordinator.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+
+#include "../atomics/planeGenerator.hpp"
+#include "../coupled/airportTop.hpp"
+#include "../simulation/flat_coordinator.hpp"
+#include "../loggers/fingerprint_logger.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace cadmium;
+
+// same structure and names as AirportSimulation in top_model/main.cpp
+class BatchBench : public Coupled {
+    std::shared_ptr<PlaneGenerator> generator;
+    std::shared_ptr<AirportTop> airport;
+
+public:
+    BatchBench(const std::string& id, const char* input_file, const AirportConfig& config) : Coupled(id) {
+        generator = addComponent<PlaneGenerator>("Generator", input_file);
+        airport = addComponent<AirportTop>("Airport", config);
+
+        addCoupling(generator->out, airport->in_landing);
+    }
+
+    void reset(const char* input_file, const AirportConfig& config) {
+        generator->reset(input_file);
+        airport->reset(config);
+    }
+};
+
+// planes arrivals a few minutes apart with random ids
+std::string writeArrivals(int planes, std::uint64_t seed) {
+    char path[] = "/tmp/airport_batch_bench_XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0) return "";
+    ::close(fd);
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> id(0, 999);
+    std::uniform_int_distribution<int> gap(30, 300);
+    std::ofstream file(path);
+    int time = 0;
+    for (int i = 0; i < planes; i++) {
+        time += gap(rng);
+        file << time << " " << id(rng) << "\n";
+    }
+    return path;
+}
+
+AirportConfig runConfig(long run) {
+    AirportConfig config;
+    config.queue_capacity = (run % 2 == 0) ? 0 : 4;
+    config.hangar_dwell.enabled = true;
+    config.hangar_dwell.dwell = 120.0;
+    config.hangar_dwell.exponential = true;
+    config.hangar_dwell.seed = static_cast<std::uint64_t>(run) + 1;
+    return config;
+}
+
+struct Batch {
+    double setup_ns = 0;
+    double run_ns = 0;
+    std::uint64_t records = 0;
+    std::uint64_t hash = 0;  // every run's trace hash, folded in order
+
+    template <typename Coordinator>
+    void run(Coordinator& coordinator, std::chrono::steady_clock::time_point t0) {
+        auto t1 = std::chrono::steady_clock::now();
+        auto fingerprint = std::make_shared<TraceFingerprint>();
+        coordinator.template setLogger<FingerprintLogger>(fingerprint);
+        coordinator.start();
+        coordinator.simulate(std::numeric_limits<double>::infinity());
+        coordinator.stop();
+        auto t2 = std::chrono::steady_clock::now();
+        setup_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        run_ns += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        records += fingerprint->records;
+        hash = (hash ^ fingerprint->hash) * 1099511628211ULL;
+    }
+};
+
+void report(const std::string& name, const Batch& batch, long runs) {
+    std::cout << name << std::setw(10) << batch.setup_ns / runs / 1000 << std::setw(10)
+              << batch.run_ns / runs / 1000 << std::setw(10) << (batch.setup_ns + batch.run_ns) / 1e9 << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    long runs = (argc > 1) ? std::atol(argv[1]) : 10000;
+    int planes = (argc > 2) ? std::atoi(argv[2]) : 10;
+    const int files = 8;
+
+    std::vector<std::string> inputs;
+    for (int i = 0; i < files; i++) {
+        inputs.push_back(writeArrivals(planes, static_cast<std::uint64_t>(i) + 1));
+        if (inputs.back().empty()) {
+            std::cout << "Cannot write the arrivals files" << std::endl;
+            return 1;
+        }
+    }
+    auto input = [&](long run) { return inputs[static_cast<std::size_t>(run % files)].c_str(); };
+
+    Batch rebuild;
+    for (long run = 0; run < runs; run++) {
+        auto t0 = std::chrono::steady_clock::now();
+        auto model = std::make_shared<BatchBench>("AirportSimulation", input(run), runConfig(run));
+        RootCoordinator coordinator(model);
+        rebuild.run(coordinator, t0);
+    }
+
+    Batch reset;
+    auto model = std::make_shared<BatchBench>("AirportSimulation", "/dev/null", runConfig(0));
+    for (long run = 0; run < runs; run++) {
+        auto t0 = std::chrono::steady_clock::now();
+        model->reset(input(run), runConfig(run));
+        RootCoordinator coordinator(model);
+        reset.run(coordinator, t0);
+    }
+
+    Batch reuse;
+    FlatCoordinator flat(model);
+    for (long run = 0; run < runs; run++) {
+        auto t0 = std::chrono::steady_clock::now();
+        model->reset(input(run), runConfig(run));
+        flat.reset();
+        reuse.run(flat, t0);
+    }
+    for (const auto& path : inputs) std::remove(path.c_str());
+
+    std::cout << "runs:         " << runs << " of " << planes << " planes" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "              setup us   run us   total s" << std::endl;
+    report("rebuild:   ", rebuild, runs);
+    report("reset:     ", reset, runs);
+    report("reuse:     ", reuse, runs);
+    std::cout << "setup saved:  " << (rebuild.setup_ns - reuse.setup_ns) / runs / 1000 << " us/run ("
+              << rebuild.setup_ns / reuse.setup_ns << "x less setup)" << std::endl;
+
+    if (reset.records != rebuild.records || reset.hash != rebuild.hash || reuse.records != rebuild.records ||
+        reuse.hash != rebuild.hash) {
+        std::cout << "ERROR: the batches disagree (" << rebuild.records << " / " << reset.records << " / "
+                  << reuse.records << " records)" << std::endl;
+        return 1;
+    }
+    std::cout << "traces:       identical, " << rebuild.records << " records" << std::endl;
+    return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * Event Calendar Benchmark
+ *
+ * Compares the ways of finding the next atomics to fire on models of 10,
+ * 1,000 and 100,000 atomics: Cadmium's RootCoordinator, the
+ * FlatCoordinator scanning every model on every step, and the
+ * FlatCoordinator with its calendar scheduler (an IndexedHeap of next
+ * times, updated only for the atomics a step touched).
+ *
+ * The model is a row of lanes, each a StorageBay, a Queue and a Runway
+ * in a loop. A Seeder puts two planes into every lane at time 0. The
+ * queue holds one plane and, full, diverts the oldest (DIVERT_OLDEST,
+ * capacity 1), so without a tower it passes each plane on to the runway
+ * one arrival later; the runway lands it back into the bay, which parks
+ * it for an exponential dwell. Every lane draws its dwells from its own
+ * seed, so the lanes drift apart and each step touches a few of them.
+ *
+ * Each kernel is timed without a logger after the seeding step, then
+ * rerun from the start with the FingerprintLogger for the first steps;
+ * the benchmark fails if the three traces differ.
+ *
+ * Usage: CALENDAR_BENCH [max_atomics]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include <cadmium/simulation/root_coordinator.hpp>
+#include <cadmium/modeling/devs/atomic.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+
+#include "../atomics/queue.hpp"
+#include "../atomics/storageBay.hpp"
+#include "../atomics/runway.hpp"
+#include "../data_structures/pooled_port.hpp"
+#include "../simulation/flat_coordinator.hpp"
+#include "../loggers/fingerprint_logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace cadmium;
+
+constexpr int PLANES_PER_LANE = 2;
+constexpr double MEAN_DWELL = 3600.0;
+
+struct SeederState {
+    bool sent;
+    double sigma;
+
+    SeederState() : sent(false), sigma(0.0) {}
+};
+
+std::ostream& operator<<(std::ostream& out, const SeederState& state) {
+    out << "{sent=" << state.sent << ", sigma=" << state.sigma << "}";
+    return out;
+}
+
+// sends planes ids 0..planes-1 at time 0, then stays passive
+class Seeder : public Atomic<SeederState> {
+    int planes;
+
+public:
+    PooledPort<PlaneMsg> out;
+
+    Seeder(const std::string& id, int planes) : Atomic<SeederState>(id, SeederState()), planes(planes) {
+        out = addPooledOutPort<PlaneMsg>(this, "out");
+    }
+
+    void internalTransition(SeederState& state) const override {
+        state.sent = true;
+        state.sigma = std::numeric_limits<double>::infinity();
+    }
+
+    void externalTransition(SeederState& state, double e) const override {}
+
+    void output(const SeederState& state) const override {
+        for (int i = 0; i < planes; i++) out->addMessage(PlaneMsg(i));
+    }
+
+    [[nodiscard]] double timeAdvance(const SeederState& state) const override { return state.sigma; }
+};
+
+// StorageBay -> Queue -> Runway -> StorageBay
+class Lane : public Coupled {
+public:
+    PooledPort<PlaneMsg> in;
+
+    Lane(const std::string& id, std::uint64_t seed) : Coupled(id) {
+        in = addPooledInPort<PlaneMsg>(this, "in");
+
+        DwellConfig dwell;
+        dwell.enabled = true;
+        dwell.exponential = true;
+        dwell.dwell = MEAN_DWELL;
+        dwell.seed = seed;
+        auto bay = addComponent<StorageBay>("Bay", dwell);
+        auto queue = addComponent<Queue>("Queue", 1, QueueOverflow::DIVERT_OLDEST);
+        auto runway = addComponent<Runway>("Runway");
+
+        addCoupling(in, bay->in);
+        addCoupling(bay->out, queue->in);
+        addCoupling(queue->out, runway->land);
+        addCoupling(queue->overflow, runway->land);
+        addCoupling(runway->landing_exit, bay->in);
+    }
+};
+
+class Lanes : public Coupled {
+public:
+    Lanes(const std::string& id, long lanes) : Coupled(id) {
+        auto seeder = addComponent<Seeder>("Seeder", PLANES_PER_LANE);
+        for (long i = 0; i < lanes; i++) {
+            auto lane = addComponent<Lane>("Lane" + std::to_string(i), static_cast<std::uint64_t>(i + 1));
+            addCoupling(seeder->out, lane->in);
+        }
+    }
+};
+
+// RootCoordinator has no getTimeNext, step it through its top coordinator
+struct CadmiumKernel {
+    RootCoordinator root;
+
+    explicit CadmiumKernel(const std::shared_ptr<Coupled>& model) : root(model) {}
+    [[nodiscard]] double getTimeNext() const { return root.getTopCoordinator()->getTimeNext(); }
+    template <typename T, typename... Args>
+    void setLogger(Args&&... args) { root.setLogger<T>(std::forward<Args>(args)...); }
+    void start() { root.start(); }
+    void stop() { root.stop(); }
+    void simulate(long steps) { root.simulate(steps); }
+};
+
+struct CalendarRun {
+    double ns_per_step = 0;
+    TraceFingerprint check;
+};
+
+// make builds one kernel; the timed and the checked run each get a fresh model
+template <typename Make>
+CalendarRun measure(const Make& make, long steps, long check_steps) {
+    CalendarRun run;
+    {
+        auto timed = make();
+        timed->start();
+        timed->simulate(1L);  // seeding step, as wide as the model
+        auto t0 = std::chrono::steady_clock::now();
+        timed->simulate(steps);
+        run.ns_per_step = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / steps;
+        timed->stop();
+    }
+    auto checked = make();
+    auto fingerprint = std::make_shared<TraceFingerprint>();
+    checked->template setLogger<FingerprintLogger>(fingerprint);
+    checked->start();
+    checked->simulate(check_steps);
+    checked->stop();
+    run.check = *fingerprint;
+    return run;
+}
+
+ParallelOptions withScheduler(FlatScheduler scheduler) {
+    ParallelOptions options;
+    options.scheduler = scheduler;
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    long max_atomics = (argc > 1) ? std::atol(argv[1]) : 100000;
+    const long check_steps = 100;
+
+    bool same = true;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "   atomics      steps   RootCoordinator   flat scan   flat calendar  (ns/step)" << std::endl;
+    for (long atomics : {10L, 1000L, 100000L}) {
+        if (atomics > max_atomics) break;
+        long lanes = std::max(1L, (atomics - 1) / 3);
+        long steps = std::max(200L, 20000000L / atomics);
+
+        CalendarRun cadmium = measure([&] {
+            return std::make_unique<CadmiumKernel>(std::make_shared<Lanes>("Lanes", lanes));
+        }, steps, check_steps);
+        CalendarRun scan = measure([&] {
+            return std::make_unique<FlatCoordinator>(std::make_shared<Lanes>("Lanes", lanes),
+                                                     withScheduler(FlatScheduler::SCAN));
+        }, steps, check_steps);
+        CalendarRun calendar = measure([&] {
+            return std::make_unique<FlatCoordinator>(std::make_shared<Lanes>("Lanes", lanes),
+                                                     withScheduler(FlatScheduler::CALENDAR));
+        }, steps, check_steps);
+
+        std::cout << std::setw(10) << 3 * lanes + 1 << std::setw(11) << steps << std::setw(18)
+                  << cadmium.ns_per_step << std::setw(12) << scan.ns_per_step << std::setw(16)
+                  << calendar.ns_per_step << std::endl;
+
+        for (const auto* run : {&scan, &calendar}) {
+            if (run->check.records != cadmium.check.records || run->check.hash != cadmium.check.hash) {
+                std::cout << "ERROR: the kernels disagree over the first " << check_steps << " steps ("
+                          << cadmium.check.final() << " / " << scan.check.final() << " / "
+                          << calendar.check.final() << ")" << std::endl;
+                same = false;
+                break;
+            }
+        }
+    }
+    if (!same) return 1;
+    std::cout << "traces:    identical over the first " << check_steps << " steps" << std::endl;
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Hangar Dwell Benchmark
+ *
+ * Parks a large number of planes with random turnaround times in the
+ * timer wheel behind StorageBay's dwell mode, then releases them all,
+ * and does the same with a std::multimap as the sorted-container
+ * reference. Both must release the planes in the same order; the
+ * benchmark reports ns/plane for each and fails if the orders differ.
+ *
+ * Usage: DWELL_BENCH [planes] [max_dwell_ticks]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include "../data_structures/timer_wheel.hpp"
+#include "../data_structures/plane_message.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    long planes = (argc > 1) ? std::atol(argv[1]) : 2000000;
+    std::uint64_t max_dwell = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 7 * 24 * 3600;
+
+    // arrivals one tick apart, dwell uniform in [0, max_dwell]
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<std::uint64_t> dwell(0, max_dwell);
+    std::vector<std::uint64_t> expiry(planes);
+    for (long i = 0; i < planes; i++) expiry[i] = static_cast<std::uint64_t>(i) + dwell(rng);
+
+    std::vector<int> wheel_order;
+    std::vector<int> map_order;
+    wheel_order.reserve(planes);
+    map_order.reserve(planes);
+
+    // timer wheel: park as arrivals come in, release whenever a deadline passes
+    auto t0 = std::chrono::steady_clock::now();
+    TimerWheel<PlaneMsg> wheel;
+    for (long i = 0; i < planes; i++) {
+        while (!wheel.empty() && wheel.nextExpiry() < static_cast<std::uint64_t>(i)) {
+            wheel.advance(wheel.nextExpiry());
+            wheel.expire([&](const PlaneMsg& p) { wheel_order.push_back(planeId(p)); });
+        }
+        wheel.advance(i);
+        wheel.schedule(expiry[i], PlaneMsg(static_cast<int>(i)));
+    }
+    while (!wheel.empty()) {
+        wheel.advance(wheel.nextExpiry());
+        wheel.expire([&](const PlaneMsg& p) { wheel_order.push_back(planeId(p)); });
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // sorted container reference, insertion order kept among equal keys
+    std::multimap<std::uint64_t, PlaneMsg> parked;
+    for (long i = 0; i < planes; i++) {
+        while (!parked.empty() && parked.begin()->first < static_cast<std::uint64_t>(i)) {
+            map_order.push_back(planeId(parked.begin()->second));
+            parked.erase(parked.begin());
+        }
+        parked.emplace(expiry[i], PlaneMsg(static_cast<int>(i)));
+    }
+    while (!parked.empty()) {
+        map_order.push_back(planeId(parked.begin()->second));
+        parked.erase(parked.begin());
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double wheel_ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    double map_ns = std::chrono::duration<double, std::nano>(t2 - t1).count();
+    std::cout << "planes:            " << planes << std::endl;
+    std::cout << "max dwell:         " << max_dwell << " ticks" << std::endl;
+    std::cout << "timer wheel:       " << wheel_ns / planes << " ns/plane" << std::endl;
+    std::cout << "multimap:          " << map_ns / planes << " ns/plane" << std::endl;
+
+    if (wheel_order != map_order) {
+        std::cout << "ERROR: release order differs from the multimap reference" << std::endl;
+        return 1;
+    }
+    std::cout << "release order:     matches" << std::endl;
+    return 0;
+}
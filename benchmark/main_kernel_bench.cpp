@@ -0,0 +1,148 @@
+/*
+ * Simulation Kernel Benchmark
+ *
+ * Runs the full airport on a steady stream of arrivals three ways: on
+ * Cadmium's RootCoordinator, on the FlatCoordinator and on the static
+ * airport topology of coupled/staticAirport.hpp. No logger is attached
+ * for the timed runs, so only the kernel and the models are measured.
+ * Each kernel then reruns the first steps with the FingerprintLogger;
+ * the benchmark fails if the three traces differ.
+ *
+ * Usage: KERNEL_BENCH [planes] [interarrival_seconds]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include <cadmium/simulation/root_coordinator.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+
+#include "../atomics/planeGenerator.hpp"
+#include "../coupled/airportTop.hpp"
+#include "../coupled/staticAirport.hpp"
+#include "../simulation/flat_coordinator.hpp"
+#include "../loggers/fingerprint_logger.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unistd.h>
+
+using namespace cadmium;
+
+// same structure and names as AirportSimulation in top_model/main.cpp
+class KernelBench : public Coupled {
+public:
+    KernelBench(const std::string& id, const char* input_file) : Coupled(id) {
+        auto generator = addComponent<PlaneGenerator>("Generator", input_file);
+        auto airport = addComponent<AirportTop>("Airport", AirportConfig());
+
+        addCoupling(generator->out, airport->in_landing);
+    }
+};
+
+// arrivals every interval seconds, cycling through all 1000 ids so every bay gets traffic
+std::string writeArrivals(long planes, double interval) {
+    char path[] = "/tmp/airport_kernel_bench_XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0) return "";
+    ::close(fd);
+    std::ofstream file(path);
+    for (long i = 0; i < planes; i++) file << (i + 1) * interval << " " << i % 1000 << "\n";
+    return path;
+}
+
+struct KernelRun {
+    long steps = 0;
+    double ns = 0;
+    TraceFingerprint check;
+};
+
+// timed run to the end without a logger, then the first check_steps with the fingerprint
+template <typename Kernel>
+KernelRun measure(Kernel& timed, Kernel& checked, long check_steps) {
+    KernelRun run;
+    auto t0 = std::chrono::steady_clock::now();
+    timed.start();
+    while (timed.getTimeNext() < std::numeric_limits<double>::infinity()) {
+        timed.simulate(1L);
+        run.steps++;
+    }
+    timed.stop();
+    run.ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+    auto fingerprint = std::make_shared<TraceFingerprint>();
+    checked.template setLogger<FingerprintLogger>(fingerprint);
+    checked.start();
+    checked.simulate(check_steps);
+    checked.stop();
+    run.check = *fingerprint;
+    return run;
+}
+
+// RootCoordinator has no getTimeNext, step it through its top coordinator
+struct CadmiumKernel {
+    RootCoordinator root;
+
+    explicit CadmiumKernel(const std::shared_ptr<Coupled>& model) : root(model) {}
+    [[nodiscard]] double getTimeNext() const { return root.getTopCoordinator()->getTimeNext(); }
+    template <typename T, typename... Args>
+    void setLogger(Args&&... args) { root.setLogger<T>(std::forward<Args>(args)...); }
+    void start() { root.start(); }
+    void stop() { root.stop(); }
+    void simulate(long steps) { root.simulate(steps); }
+};
+
+void report(const std::string& name, const KernelRun& run) {
+    std::cout << name << run.ns / run.steps << " ns/step" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    long planes = (argc > 1) ? std::atol(argv[1]) : 200000;
+    double interval = (argc > 2) ? std::atof(argv[2]) : 150.0;
+    const long check_steps = 20000;
+
+    std::string input = writeArrivals(planes, interval);
+    if (input.empty()) {
+        std::cout << "Cannot write the arrivals file" << std::endl;
+        return 1;
+    }
+
+    CadmiumKernel cadmium_timed(std::make_shared<KernelBench>("AirportSimulation", input.c_str()));
+    CadmiumKernel cadmium_checked(std::make_shared<KernelBench>("AirportSimulation", input.c_str()));
+    KernelRun cadmium = measure(cadmium_timed, cadmium_checked, check_steps);
+
+    FlatCoordinator flat_timed(std::make_shared<KernelBench>("AirportSimulation", input.c_str()));
+    FlatCoordinator flat_checked(std::make_shared<KernelBench>("AirportSimulation", input.c_str()));
+    KernelRun flat = measure(flat_timed, flat_checked, check_steps);
+
+    using Airport = StaticAirport<StaticHangar, false>;  // the default AirportConfig
+    KernelBench reference("AirportSimulation", "/dev/null");
+    StaticKernel<Airport::type> static_timed(reference, Airport::args(input.c_str(), AirportConfig()));
+    StaticKernel<Airport::type> static_checked(reference, Airport::args(input.c_str(), AirportConfig()));
+    KernelRun fixed = measure(static_timed, static_checked, check_steps);
+    std::remove(input.c_str());
+
+    std::cout << "planes:            " << planes << std::endl;
+    std::cout << "interarrival:      " << interval << " s" << std::endl;
+    std::cout << "steps:             " << cadmium.steps << std::endl;
+    report("RootCoordinator:   ", cadmium);
+    report("FlatCoordinator:   ", flat);
+    report("static kernel:     ", fixed);
+    std::cout << "speedup (static):  " << cadmium.ns / fixed.ns << "x" << std::endl;
+
+    bool same = flat.steps == cadmium.steps && fixed.steps == cadmium.steps &&
+                flat.check.hash == cadmium.check.hash && fixed.check.hash == cadmium.check.hash &&
+                flat.check.records == cadmium.check.records && fixed.check.records == cadmium.check.records;
+    if (!same) {
+        std::cout << "ERROR: the kernels disagree (first " << check_steps << " steps: " << cadmium.check.final()
+                  << " / " << flat.check.final() << " / " << fixed.check.final() << ")" << std::endl;
+        return 1;
+    }
+    std::cout << "traces:            identical over the first " << check_steps << " steps" << std::endl;
+    return 0;
+}
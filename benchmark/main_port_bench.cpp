@@ -0,0 +1,126 @@
+/*
+ * Port Allocation Benchmark
+ *
+ * Drives the full AirportTop model with a steady stream of arrivals and
+ * counts heap allocations per simulation event, so we can check that the
+ * message bags and model buffers stop allocating once they are warm.
+ * No logger is attached, only the model and the coordinator are measured.
+ *
+ * The makefile builds this twice: PORT_BENCH carries PlaneMessage records
+ * and PORT_BENCH_INT is built with -DAIRPORT_INT_MESSAGES as the bare int
+ * reference, so the ns/event of the two can be compared directly.
+ *
+ * Usage: PORT_BENCH [events] [interarrival_seconds]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include <cadmium/simulation/root_coordinator.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+#include <cadmium/modeling/devs/atomic.hpp>
+
+#include "../coupled/airportTop.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+
+using namespace cadmium;
+
+// count every global allocation made by the process
+static std::atomic<unsigned long> allocation_count{0};
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// periodic arrival source, no input file so runs can be arbitrarily long
+struct ArrivalSourceState {
+    int next_id;
+    double clock;
+    double sigma;
+
+    explicit ArrivalSourceState(double interval) : next_id(0), clock(0), sigma(interval) {}
+};
+
+std::ostream& operator<<(std::ostream &out, const ArrivalSourceState& s) {
+    out << "{next=" << s.next_id << ", sigma=" << s.sigma << "}";
+    return out;
+}
+
+class ArrivalSource : public Atomic<ArrivalSourceState> {
+public:
+    PooledPort<PlaneMsg> out;
+
+    ArrivalSource(const std::string& id, double interval) : Atomic<ArrivalSourceState>(id, ArrivalSourceState(interval)) {
+        out = addPooledOutPort<PlaneMsg>(this, "out");
+    }
+
+    // cycle through all 1000 ids so every bay gets traffic
+    void internalTransition(ArrivalSourceState& s) const override {
+        s.next_id = (s.next_id + 1) % 1000;
+        s.clock += s.sigma;
+    }
+
+    void externalTransition(ArrivalSourceState& s, double e) const override {}
+
+    void output(const ArrivalSourceState& s) const override {
+        PlaneMsg plane = s.next_id;
+        stampArrival(plane, s.clock + s.sigma);
+        out->addMessage(plane);
+    }
+
+    [[nodiscard]] double timeAdvance(const ArrivalSourceState& s) const override {
+        return s.sigma;
+    }
+};
+
+class PortBench : public Coupled {
+public:
+    PortBench(const std::string& id, double interval) : Coupled(id) {
+        auto source = addComponent<ArrivalSource>("Source", interval);
+        auto airport = addComponent<AirportTop>("Airport");
+
+        addCoupling(source->out, airport->in_landing);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    long events = (argc > 1) ? std::atol(argv[1]) : 2000000;
+    double interval = (argc > 2) ? std::atof(argv[2]) : 150.0;
+    long warmup = events / 10;
+
+    auto model = std::make_shared<PortBench>("PortBench", interval);
+    auto rootCoordinator = RootCoordinator(model);
+    rootCoordinator.start();
+
+    // warm up so queues and bags reach their working size
+    rootCoordinator.simulate(warmup);
+
+    unsigned long allocs_before = allocation_count.load();
+    auto t0 = std::chrono::steady_clock::now();
+    rootCoordinator.simulate(events);
+    auto t1 = std::chrono::steady_clock::now();
+    unsigned long allocs = allocation_count.load() - allocs_before;
+
+    rootCoordinator.stop();
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    std::cout << "message size:      " << sizeof(PlaneMsg) << " bytes" << std::endl;
+    std::cout << "events:            " << events << std::endl;
+    std::cout << "interarrival:      " << interval << " s" << std::endl;
+    std::cout << "allocations:       " << allocs << std::endl;
+    std::cout << "allocations/event: " << static_cast<double>(allocs) / events << std::endl;
+    std::cout << "ns/event:          " << ns / events << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * What-If Server Benchmark
+ *
+ * Starts a WhatIfServer in the process on a temporary socket and has
+ * client threads send it small scenarios: Poisson arrivals at 12 per hour
+ * over a few seeds, asking for the trace fingerprint. Every client keeps
+ * one connection open and waits for each answer before sending the next
+ * request. Reports the round-trip latency (median, 99th percentile, worst)
+ * and the requests per second over all clients.
+ *
+ * For reference the same scenarios are first run the one-shot way, on a
+ * new model and RootCoordinator each. The benchmark fails unless every
+ * answer carries the fingerprint of that run.
+ *
+ * Usage: SERVER_BENCH [clients] [requests_per_client] [planes] [workers]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include <cadmium/simulation/root_coordinator.hpp>
+
+#include "../simulation/what_if_server.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace cadmium;
+
+constexpr int SEEDS = 16;
+
+std::string request(int planes, int seed) {
+    return "poisson 12 " + std::to_string(planes) + " " + std::to_string(seed) + "\nreply fingerprint\n\n";
+}
+
+// "ok records=N hash=HEX ..." -> "N HEX", empty for anything else
+std::string fingerprintOf(const std::string& reply) {
+    std::istringstream fields(reply);
+    std::string ok, records, hash;
+    if (!(fields >> ok >> records >> hash) || ok != "ok") return "";
+    return records.substr(8) + " " + hash.substr(5);
+}
+
+int connectTo(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+struct Client {
+    std::vector<double> latency_us;
+    long wrong = 0;
+    bool failed = false;
+};
+
+// one connection, requests sent one at a time
+void runClient(const std::string& path, int index, int requests, int planes, const std::vector<std::string>& expected,
+               Client& client) {
+    int fd = connectTo(path);
+    if (fd < 0) {
+        client.failed = true;
+        return;
+    }
+    LineReader reader(fd);
+    std::string_view line;
+    for (int i = 0; i < requests; i++) {
+        int seed = (index * requests + i) % SEEDS;
+        std::string text = request(planes, seed + 1);
+        auto t0 = std::chrono::steady_clock::now();
+        if (::send(fd, text.data(), text.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(text.size()) ||
+            reader.next(line) != LineReader::Status::LINE) {
+            client.failed = true;
+            break;
+        }
+        client.latency_us.push_back(
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+        if (fingerprintOf(std::string(line)) != expected[static_cast<std::size_t>(seed)]) client.wrong++;
+    }
+    ::close(fd);
+}
+
+int main(int argc, char* argv[]) {
+    int clients = (argc > 1) ? std::atoi(argv[1]) : 4;
+    int requests = (argc > 2) ? std::atoi(argv[2]) : 500;
+    int planes = (argc > 3) ? std::atoi(argv[3]) : 20;
+    unsigned workers = (argc > 4) ? static_cast<unsigned>(std::atoi(argv[4]))
+                                  : std::max(1u, std::thread::hardware_concurrency());
+
+    // one-shot reference: a new model and RootCoordinator per scenario
+    std::vector<std::string> expected;
+    double cold_us = 0;
+    for (int seed = 1; seed <= SEEDS; seed++) {
+        auto t0 = std::chrono::steady_clock::now();
+        auto model = std::make_shared<ServedAirport>("AirportSimulation", AirportConfig());
+        model->reset(poissonArrivals(12, planes, static_cast<std::uint64_t>(seed)), AirportConfig());
+        RootCoordinator coordinator(model);
+        auto fingerprint = std::make_shared<TraceFingerprint>();
+        coordinator.setLogger<FingerprintLogger>(fingerprint);
+        coordinator.start();
+        coordinator.simulate(36000.0);
+        coordinator.stop();
+        cold_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        std::ostringstream print;
+        print << fingerprint->records << " " << std::hex << std::setw(16) << std::setfill('0') << fingerprint->hash;
+        expected.push_back(print.str());
+    }
+
+    WhatIfOptions options;
+    options.socket_path = "/tmp/airport_server_bench_" + std::to_string(::getpid()) + ".sock";
+    options.workers = workers;
+    WhatIfServer server(options);
+    if (!server.open()) return 1;
+    std::thread serving([&] { server.run(); });
+
+    std::vector<Client> results(static_cast<std::size_t>(clients));
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; c++) {
+        threads.emplace_back(runClient, options.socket_path, c, requests, planes, std::cref(expected),
+                             std::ref(results[static_cast<std::size_t>(c)]));
+    }
+    for (auto& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    server.stop();
+    serving.join();
+
+    std::vector<double> latency;
+    long wrong = 0;
+    bool failed = false;
+    for (const auto& client : results) {
+        latency.insert(latency.end(), client.latency_us.begin(), client.latency_us.end());
+        wrong += client.wrong;
+        failed = failed || client.failed;
+    }
+    if (failed || latency.empty()) {
+        std::cout << "ERROR: a client lost its connection" << std::endl;
+        return 1;
+    }
+    std::sort(latency.begin(), latency.end());
+    auto percentile = [&](double p) { return latency[static_cast<std::size_t>(p * (latency.size() - 1))]; };
+
+    std::cout << "requests:     " << latency.size() << " of " << planes << " planes from " << clients
+              << " clients, " << workers << " workers" << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "one-shot:     " << cold_us / SEEDS << " us per scenario (new model and coordinator)" << std::endl;
+    std::cout << "latency:      median " << percentile(0.5) << " us, p99 " << percentile(0.99) << " us, max "
+              << latency.back() << " us" << std::endl;
+    std::cout << "throughput:   " << latency.size() / seconds << " requests/s" << std::endl;
+
+    if (wrong > 0) {
+        std::cout << "ERROR: " << wrong << " answers differ from the one-shot runs" << std::endl;
+        return 1;
+    }
+    std::cout << "answers:      identical to the one-shot runs" << std::endl;
+    return 0;
+}
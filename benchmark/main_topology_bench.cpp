@@ -0,0 +1,137 @@
+/*
+ * Topology Builder Benchmark
+ *
+ * Builds fleets of airports from input_data/topology/airport.ma with a
+ * [fleet] section added: one Generator feeding N copies of its [Airport],
+ * written as one repeat block. Each airport is 10 atomics and 3 coupled
+ * models, so the default sizes give about 1.3k, 13k and 104k components.
+ * Reports the time to parse the file and to build each fleet, and for
+ * comparison the time to build the same fleet from the C++ models
+ * (AirportTop and Cadmium's addComponent / addCoupling).
+ *
+ * The smallest fleet is then run on T2 both ways; the benchmark fails
+ * unless the built and the hand-wired fleet give the same trace.
+ *
+ * Usage: TOPOLOGY_BENCH [input_data_dir] [airports...]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include <cadmium/simulation/root_coordinator.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+
+#include "../coupled/topologyBuilder.hpp"
+#include "../loggers/fingerprint_logger.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace cadmium;
+
+constexpr std::size_t COMPONENTS_PER_AIRPORT = 13;
+
+// the fleet as the C++ models build it, same names and order as the [fleet] section
+class FleetBench : public Coupled {
+public:
+    PooledPort<PlaneMsg> out_takeoff;
+
+    FleetBench(const std::string& id, const char* input_file, int airports) : Coupled(id) {
+        out_takeoff = addPooledOutPort<PlaneMsg>(this, "out_takeoff");
+        auto generator = addComponent<PlaneGenerator>("Generator", input_file);
+        for (int a = 1; a <= airports; a++) {
+            auto airport = addComponent<AirportTop>("Airport" + std::to_string(a));
+            addCoupling(generator->out, airport->in_landing);
+            addCoupling(airport->out_takeoff, out_takeoff);
+        }
+    }
+};
+
+std::string fleetSection(int airports) {
+    return "\n[fleet]\n"
+           "components : Generator@Generator\n"
+           "repeat : a 1 " + std::to_string(airports) + "\n"
+           "components : Airport{a}@Airport\n"
+           "Link : out@Generator in_landing@Airport{a}\n"
+           "Link : out_takeoff@Airport{a} out_takeoff\n"
+           "end\n";
+}
+
+template <typename Root>
+TraceFingerprint fingerprintOf(Root& rootCoordinator) {
+    auto fingerprint = std::make_shared<TraceFingerprint>();
+    rootCoordinator.template setLogger<FingerprintLogger>(fingerprint);
+    rootCoordinator.start();
+    rootCoordinator.simulate(36000.0);
+    rootCoordinator.stop();
+    return *fingerprint;
+}
+
+double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::string base_path = (argc > 1) ? argv[1] : "input_data/";
+    if (base_path.back() != '/') base_path += "/";
+    std::vector<int> sizes;
+    for (int i = 2; i < argc; i++) sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty()) sizes = {100, 1000, 8000};
+
+    std::ifstream in(base_path + "topology/airport.ma");
+    if (!in) {
+        std::cout << "Cannot read " << base_path << "topology/airport.ma" << std::endl;
+        return 1;
+    }
+    std::stringstream airport;
+    airport << in.rdbuf();
+    std::string input_file = base_path + "T2_burst_test.txt";
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "airports  components  couplings   parse ms   build ms   C++ ms" << std::endl;
+    for (int airports : sizes) {
+        auto t0 = std::chrono::steady_clock::now();
+        TopologyFile topology = TopologyFile::parse(airport.str() + fleetSection(airports), "fleet");
+        double parse_ms = msSince(t0);
+
+        t0 = std::chrono::steady_clock::now();
+        TopologyBuilder builder(topology, AtomicParameters{AirportConfig(), "/dev/null"});
+        auto built = builder.build("AirportSimulation", "fleet");
+        double build_ms = msSince(t0);
+
+        t0 = std::chrono::steady_clock::now();
+        auto wired = std::make_shared<FleetBench>("AirportSimulation", "/dev/null", airports);
+        double wired_ms = msSince(t0);
+
+        const TopologyStats& stats = builder.stats();
+        std::size_t components = stats.atomics + stats.coupled;
+        if (components != 1 + COMPONENTS_PER_AIRPORT * static_cast<std::size_t>(airports) + 1) {
+            std::cout << "ERROR: built " << components << " components for " << airports << " airports" << std::endl;
+            return 1;
+        }
+        std::cout << std::setw(8) << airports << std::setw(12) << components << std::setw(11) << stats.couplings
+                  << std::setw(11) << parse_ms << std::setw(11) << build_ms << std::setw(9) << wired_ms << std::endl;
+    }
+
+    int airports = sizes.front();
+    TopologyFile topology = TopologyFile::parse(airport.str() + fleetSection(airports), "fleet");
+    TopologyBuilder builder(topology, AtomicParameters{AirportConfig(), input_file});
+    auto built = RootCoordinator(builder.build("AirportSimulation", "fleet"));
+    auto wired = RootCoordinator(std::make_shared<FleetBench>("AirportSimulation", input_file.c_str(), airports));
+    TraceFingerprint on_built = fingerprintOf(built);
+    TraceFingerprint on_wired = fingerprintOf(wired);
+    if (on_built.records != on_wired.records || on_built.hash != on_wired.hash) {
+        std::cout << "ERROR: the built fleet differs: " << on_built.final() << ", hand-wired " << on_wired.final()
+                  << std::endl;
+        return 1;
+    }
+    std::cout << "traces:   " << airports << " airports on T2, built and hand-wired identical, " << on_built.records
+              << " records" << std::endl;
+    return 0;
+}
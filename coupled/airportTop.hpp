@@ -0,0 +1,230 @@
+/*
+ * AirportTop Coupled Model
+ *
+ * The full airport: landing and takeoff queues, control tower, runway
+ * and hangar. Planes enter through in_landing and leave on out_takeoff
+ * once they have landed, been stored and taken off again.
+ *
+ * AirportConfig selects the run options. With PRIORITY scheduling the
+ * arrivals hold in the tower's priority buffer instead of the FIFO
+ * landing queue, so emergencies can overtake the planes already holding.
+ * A queue capacity bounds both queues; planes they turn away leave on
+ * out_diverted. airportConfigError refuses it under PRIORITY scheduling,
+ * which has no landing queue to bound, so the takeoff queue cannot be
+ * bounded on its own in that mode either. The hangar dwell options
+ * give planes a turnaround time in the storage bays before they queue
+ * for takeoff. The AGGREGATE hangar replaces the Selector / bays /
+ * Merger with a single delay line (AggregateHangar) for runs that only
+ * look at the runway side. COALESCED signalling cuts the tower's stop /
+ * done messages to the ones that change what a queue does.
+ *
+ * reset() puts every atomic back to its initial state in place, so a
+ * batch of runs can reuse one built airport instead of rebuilding its
+ * components, ports and couplings for each run.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef AIRPORT_TOP_HPP
+#define AIRPORT_TOP_HPP
+
+#include <cadmium/modeling/devs/coupled.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../atomics/controlTower.hpp"
+#include "../atomics/queue.hpp"
+#include "../atomics/runway.hpp"
+#include "../atomics/aggregateHangar.hpp"
+#include "hangar.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace cadmium;
+
+// detailed hangar (coupled) or the single delay line
+enum class HangarModel { DETAILED, AGGREGATE };
+
+// run options for the airport, defaults reproduce the original model
+struct AirportConfig {
+    TowerScheduling scheduling = TowerScheduling::FIFO;
+    std::size_t queue_capacity = 0;  // 0 = unbounded queues
+    QueueOverflow queue_overflow = QueueOverflow::DIVERT_NEWEST;
+    DwellConfig hangar_dwell;        // disabled = planes leave the hangar at once
+    HangarModel hangar = HangarModel::DETAILED;
+    TowerSignalling signalling = TowerSignalling::FULL;
+};
+
+// seconds of a --dwell option, a value that is not finite or is negative throws
+inline double parseDwell(const std::string& text) {
+    double dwell = std::stod(text);
+    if (!std::isfinite(dwell) || dwell < 0) throw std::invalid_argument("dwell must be finite and not negative: " + text);
+    return dwell;
+}
+
+// apply one command-line option (--tower=..., --dwell=..., ...) to config,
+// false if arg is not an airport option; bad numbers throw std::invalid_argument
+inline bool parseAirportOption(const std::string& arg, AirportConfig& config) {
+    if (arg == "--tower=fifo") {
+        config.scheduling = TowerScheduling::FIFO;
+    } else if (arg == "--tower=priority") {
+        config.scheduling = TowerScheduling::PRIORITY;
+    } else if (arg.rfind("--queue-capacity=", 0) == 0) {
+        config.queue_capacity = std::stoul(arg.substr(17));
+    } else if (arg == "--queue-policy=newest") {
+        config.queue_overflow = QueueOverflow::DIVERT_NEWEST;
+    } else if (arg == "--queue-policy=oldest") {
+        config.queue_overflow = QueueOverflow::DIVERT_OLDEST;
+    } else if (arg.rfind("--dwell=", 0) == 0) {
+        config.hangar_dwell.enabled = true;
+        config.hangar_dwell.dwell = parseDwell(arg.substr(8));
+    } else if (arg.rfind("--dwell-exp=", 0) == 0) {
+        config.hangar_dwell.enabled = true;
+        config.hangar_dwell.exponential = true;
+        config.hangar_dwell.dwell = parseDwell(arg.substr(12));
+    } else if (arg.rfind("--seed=", 0) == 0) {
+        config.hangar_dwell.seed = std::stoull(arg.substr(7));
+    } else if (arg == "--hangar=detailed") {
+        config.hangar = HangarModel::DETAILED;
+    } else if (arg == "--hangar=aggregate") {
+        config.hangar = HangarModel::AGGREGATE;
+    } else if (arg == "--signals=full") {
+        config.signalling = TowerSignalling::FULL;
+    } else if (arg == "--signals=coalesced") {
+        config.signalling = TowerSignalling::COALESCED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// why config cannot be built, empty if it can
+inline std::string airportConfigError(const AirportConfig& config) {
+    // priority mode has no landing queue, arrivals hold in the tower's unbounded buffer
+    if (config.scheduling == TowerScheduling::PRIORITY && config.queue_capacity > 0) {
+        return "--queue-capacity cannot bound the landings under --tower=priority, they hold in the tower";
+    }
+    // a dwell set without parseAirportOption, as a what-if request can
+    double dwell = config.hangar_dwell.dwell;
+    if (config.hangar_dwell.enabled && (!std::isfinite(dwell) || dwell < 0)) {
+        return "the hangar dwell must be finite and not negative";
+    }
+    return "";
+}
+
+// every option of config, in a fixed order, as parseAirportOption reads them
+inline std::string airportOptions(const AirportConfig& config) {
+    std::ostringstream out;
+    out << std::setprecision(17);
+    out << "--tower=" << (config.scheduling == TowerScheduling::PRIORITY ? "priority" : "fifo");
+    out << " --queue-capacity=" << config.queue_capacity;
+    out << " --queue-policy=" << (config.queue_overflow == QueueOverflow::DIVERT_OLDEST ? "oldest" : "newest");
+    if (config.hangar_dwell.enabled) {
+        out << (config.hangar_dwell.exponential ? " --dwell-exp=" : " --dwell=") << config.hangar_dwell.dwell;
+    }
+    out << " --seed=" << config.hangar_dwell.seed;
+    out << " --hangar=" << (config.hangar == HangarModel::AGGREGATE ? "aggregate" : "detailed");
+    out << " --signals=" << (config.signalling == TowerSignalling::COALESCED ? "coalesced" : "full");
+    return out.str();
+}
+
+// airporttop the main airport model with queues tower runway hangar
+class AirportTop : public Coupled {
+    std::shared_ptr<ControlTower> tower;
+    std::shared_ptr<Queue> landing_queue;  // null in priority mode
+    std::shared_ptr<Queue> takeoff_queue;
+    std::shared_ptr<Runway> runway;
+    std::shared_ptr<Hangar> hangar;                     // detailed hangar
+    std::shared_ptr<AggregateHangar> aggregate_hangar;  // or the delay line
+
+public:
+    PooledPort<PlaneMsg> in_landing;
+    PooledPort<PlaneMsg> in_priority;  // priority changes for holding planes
+    PooledPort<PlaneMsg> out_takeoff;
+    PooledPort<PlaneMsg> out_diverted;  // planes turned away by a full queue
+
+    AirportTop(const std::string& id, const AirportConfig& config = AirportConfig()) : Coupled(id) {
+        std::string error = airportConfigError(config);
+        if (!error.empty()) throw CadmiumModelException(error);
+        in_landing = addPooledInPort<PlaneMsg>(this, "in_landing");
+        in_priority = addPooledInPort<PlaneMsg>(this, "in_priority");
+        out_takeoff = addPooledOutPort<PlaneMsg>(this, "out_takeoff");
+        out_diverted = addPooledOutPort<PlaneMsg>(this, "out_diverted");
+
+        // in priority mode arrivals hold in the tower, not in a FIFO queue
+        bool priority = (config.scheduling == TowerScheduling::PRIORITY);
+
+        tower = addComponent<ControlTower>("ControlTower", config.scheduling, config.signalling);
+        if (!priority) landing_queue = addComponent<Queue>("landing_queue", config.queue_capacity, config.queue_overflow);
+        takeoff_queue = addComponent<Queue>("takeoff_queue", config.queue_capacity, config.queue_overflow);
+        runway = addComponent<Runway>("Runway");
+
+        // planes come in through landing queue
+        if (priority) {
+            addCoupling(in_landing, tower->in_landing);
+        } else {
+            addCoupling(in_landing, landing_queue->in);
+        }
+        addCoupling(in_priority, tower->in_priority);
+
+        // queues send planes to tower
+        if (!priority) addCoupling(landing_queue->out, tower->in_landing);
+        addCoupling(takeoff_queue->out, tower->in_takeoff);
+
+        // tower controls the queues with stop done signals
+        if (!priority) addCoupling(tower->stop_landing, landing_queue->stop);
+        addCoupling(tower->stop_takeoff, takeoff_queue->stop);
+        if (!priority) addCoupling(tower->done_landing, landing_queue->done);
+        addCoupling(tower->done_takeoff, takeoff_queue->done);
+
+        // tower sends planes to runway
+        addCoupling(tower->land, runway->land);
+        addCoupling(tower->takeoff, runway->takeoff);
+
+        // after landing planes go to hangar then back to takeoff queue
+        if (config.hangar == HangarModel::AGGREGATE) {
+            aggregate_hangar = addComponent<AggregateHangar>("Hangar", config.hangar_dwell);
+            addCoupling(runway->landing_exit, aggregate_hangar->in);
+            addCoupling(aggregate_hangar->hangar_exit, takeoff_queue->in);
+        } else {
+            hangar = addComponent<Hangar>("Hangar", config.hangar_dwell);
+            addCoupling(runway->landing_exit, hangar->in);
+            addCoupling(hangar->hangar_exit, takeoff_queue->in);
+        }
+
+        // takeoff exit is the final output
+        addCoupling(runway->takeoff_exit, out_takeoff);
+
+        // diverted planes leave the airport
+        if (!priority) addCoupling(landing_queue->overflow, out_diverted);
+        addCoupling(takeoff_queue->overflow, out_diverted);
+    }
+
+    // every atomic back to its initial state for a new run under config; the
+    // tower scheduling and the hangar model pick the structure, so they must
+    // stay the ones the airport was built with
+    void reset(const AirportConfig& config = AirportConfig()) {
+        std::string error = airportConfigError(config);
+        if (!error.empty()) throw CadmiumModelException(error);
+        bool priority = (config.scheduling == TowerScheduling::PRIORITY);
+        bool aggregate = (config.hangar == HangarModel::AGGREGATE);
+        if (priority != (landing_queue == nullptr) || aggregate != (aggregate_hangar != nullptr)) {
+            throw CadmiumModelException("AirportTop::reset cannot change the tower scheduling or hangar model");
+        }
+        tower->reset(config.scheduling, config.signalling);
+        if (landing_queue) landing_queue->reset(config.queue_capacity, config.queue_overflow);
+        takeoff_queue->reset(config.queue_capacity, config.queue_overflow);
+        runway->reset();
+        if (aggregate) {
+            aggregate_hangar->reset(config.hangar_dwell);
+        } else {
+            hangar->reset(config.hangar_dwell);
+        }
+    }
+};
+
+#endif // AIRPORT_TOP_HPP
@@ -13,22 +13,27 @@
 #define HANGAR_HPP
 
 #include <cadmium/modeling/devs/coupled.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
 #include "../atomics/selector.hpp"
 #include "storageBank.hpp"
 
 using namespace cadmium;
 
 class Hangar : public Coupled {
+    std::shared_ptr<Selector> selector;
+    std::shared_ptr<StorageBank> storageBank;
+
 public:
-    Port<int> in;
-    Port<int> hangar_exit;
+    PooledPort<PlaneMsg> in;
+    PooledPort<PlaneMsg> hangar_exit;
 
-    Hangar(const std::string& id) : Coupled(id) {
-        in = addInPort<int>("in");
-        hangar_exit = addOutPort<int>("hangar_exit");
+    Hangar(const std::string& id, const DwellConfig& dwell = DwellConfig()) : Coupled(id) {
+        in = addPooledInPort<PlaneMsg>(this, "in");
+        hangar_exit = addPooledOutPort<PlaneMsg>(this, "hangar_exit");
 
-        auto selector = addComponent<Selector>("Selector");
-        auto storageBank = addComponent<StorageBank>("StorageBank");
+        selector = addComponent<Selector>("Selector");
+        storageBank = addComponent<StorageBank>("StorageBank", dwell);
 
         addCoupling(in, selector->in);
 
@@ -39,6 +44,12 @@ public:
 
         addCoupling(storageBank->out, hangar_exit);
     }
+
+    // back to the initial state for a new run, with new dwell options
+    void reset(const DwellConfig& dwell = DwellConfig()) {
+        selector->reset();
+        storageBank->reset(dwell);
+    }
 };
 
 #endif // HANGAR_HPP
@@ -0,0 +1,150 @@
+/*
+ * Static Airport Topologies
+ *
+ * The AirportSimulation tree (Generator feeding AirportTop, with its Hangar
+ * and StorageBank) written out as StaticKernel topologies: the same atomics
+ * with the same names and constructor arguments, and one Link for every
+ * chain of couplings between two atomics. Each coupled model is a part that
+ * starts at a given model index and names the ports the level above links
+ * to. AirportConfig picks the part list at run time through
+ * withStaticAirport, which builds the kernel and hands it to a callback.
+ *
+ * The planes leaving on out_takeoff / out_diverted and the tower's
+ * in_priority port are not coupled to anything in AirportSimulation, so
+ * they have no Link here either.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef STATIC_AIRPORT_HPP
+#define STATIC_AIRPORT_HPP
+
+#include "../simulation/static_kernel.hpp"
+#include "../atomics/planeGenerator.hpp"
+#include "airportTop.hpp"
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+// StorageBank from model index B: Bay1..Bay4, then the Merger
+template <std::size_t B>
+struct StaticStorageBank : Topology<ModelList<StorageBay, StorageBay, StorageBay, StorageBay, Merger>,
+                                    LinkList<Link<B, &StorageBay::out, B + 4, &Merger::in1>,
+                                             Link<B + 1, &StorageBay::out, B + 4, &Merger::in2>,
+                                             Link<B + 2, &StorageBay::out, B + 4, &Merger::in3>,
+                                             Link<B + 3, &StorageBay::out, B + 4, &Merger::in4>>> {
+    static constexpr std::size_t exit = B + 4;
+    static constexpr auto exit_port = &Merger::out;
+
+    static auto args(const DwellConfig& dwell) {
+        return std::make_tuple(std::make_tuple(std::string("Bay1"), dwell), std::make_tuple(std::string("Bay2"), dwell),
+                               std::make_tuple(std::string("Bay3"), dwell), std::make_tuple(std::string("Bay4"), dwell),
+                               std::make_tuple(std::string("Merger")));
+    }
+};
+
+// Hangar from model index H: the Selector, then its StorageBank
+template <std::size_t H>
+struct StaticHangar : Join<Topology<ModelList<Selector>,
+                                    LinkList<Link<H, &Selector::out1, H + 1, &StorageBay::in>,
+                                             Link<H, &Selector::out2, H + 2, &StorageBay::in>,
+                                             Link<H, &Selector::out3, H + 3, &StorageBay::in>,
+                                             Link<H, &Selector::out4, H + 4, &StorageBay::in>>>,
+                           StaticStorageBank<H + 1>> {
+    static constexpr std::size_t size = 6;
+    static constexpr std::size_t in = H;
+    static constexpr auto in_port = &Selector::in;
+    static constexpr std::size_t exit = StaticStorageBank<H + 1>::exit;
+    static constexpr auto exit_port = StaticStorageBank<H + 1>::exit_port;
+
+    static auto args(const DwellConfig& dwell) {
+        return std::tuple_cat(std::make_tuple(std::make_tuple(std::string("Selector"))),
+                              StaticStorageBank<H + 1>::args(dwell));
+    }
+};
+
+// AggregateHangar at model index H
+template <std::size_t H>
+struct StaticAggregateHangar : Topology<ModelList<AggregateHangar>, LinkList<>> {
+    static constexpr std::size_t size = 1;
+    static constexpr std::size_t in = H;
+    static constexpr auto in_port = &AggregateHangar::in;
+    static constexpr std::size_t exit = H;
+    static constexpr auto exit_port = &AggregateHangar::hangar_exit;
+
+    static auto args(const DwellConfig& dwell) {
+        return std::make_tuple(std::make_tuple(std::string("Hangar"), dwell));
+    }
+};
+
+// Generator and AirportTop; the landing queue comes last and only without priority scheduling
+template <template <std::size_t> class HangarPart, bool Priority>
+struct StaticAirport {
+    static constexpr std::size_t GENERATOR = 0, TOWER = 1, TAKEOFF_QUEUE = 2, RUNWAY = 3, HANGAR = 4;
+    using Hangar = HangarPart<HANGAR>;
+    static constexpr std::size_t LANDING_QUEUE = HANGAR + Hangar::size;
+
+    using Core = Topology<ModelList<PlaneGenerator, ControlTower, Queue, Runway>,
+                          LinkList<Link<TAKEOFF_QUEUE, &Queue::out, TOWER, &ControlTower::in_takeoff>,
+                                   Link<TOWER, &ControlTower::stop_takeoff, TAKEOFF_QUEUE, &Queue::stop>,
+                                   Link<TOWER, &ControlTower::done_takeoff, TAKEOFF_QUEUE, &Queue::done>,
+                                   Link<TOWER, &ControlTower::land, RUNWAY, &Runway::land>,
+                                   Link<TOWER, &ControlTower::takeoff, RUNWAY, &Runway::takeoff>,
+                                   Link<RUNWAY, &Runway::landing_exit, Hangar::in, Hangar::in_port>,
+                                   Link<Hangar::exit, Hangar::exit_port, TAKEOFF_QUEUE, &Queue::in>>>;
+
+    using PriorityArrivals = Topology<ModelList<>,
+                                      LinkList<Link<GENERATOR, &PlaneGenerator::out, TOWER, &ControlTower::in_landing>>>;
+
+    using QueuedArrivals = Topology<ModelList<Queue>,
+                                    LinkList<Link<GENERATOR, &PlaneGenerator::out, LANDING_QUEUE, &Queue::in>,
+                                             Link<LANDING_QUEUE, &Queue::out, TOWER, &ControlTower::in_landing>,
+                                             Link<TOWER, &ControlTower::stop_landing, LANDING_QUEUE, &Queue::stop>,
+                                             Link<TOWER, &ControlTower::done_landing, LANDING_QUEUE, &Queue::done>>>;
+
+    using type = Join<Join<Core, Hangar>, std::conditional_t<Priority, PriorityArrivals, QueuedArrivals>>;
+
+    static auto args(const char* input_file, const AirportConfig& config) {
+        auto queue = [&](const char* id) {
+            return std::make_tuple(std::string(id), config.queue_capacity, config.queue_overflow);
+        };
+        auto core = std::make_tuple(std::make_tuple(std::string("Generator"), input_file),
+                                    std::make_tuple(std::string("ControlTower"), config.scheduling, config.signalling),
+                                    queue("takeoff_queue"), std::make_tuple(std::string("Runway")));
+        auto hangar = Hangar::args(config.hangar_dwell);
+        if constexpr (Priority) {
+            return std::tuple_cat(core, hangar);
+        } else {
+            return std::tuple_cat(core, hangar, std::make_tuple(queue("landing_queue")));
+        }
+    }
+};
+
+template <typename Airport, typename F>
+void runStaticAirport(const Coupled& reference, const char* input_file, const AirportConfig& config, F& run) {
+    StaticKernel<typename Airport::type> kernel(reference, Airport::args(input_file, config));
+    run(kernel);
+}
+
+// builds the static kernel for config and calls run(kernel); reference is the
+// Cadmium AirportSimulation with the same config, for model ids and log order
+template <typename F>
+void withStaticAirport(const Coupled& reference, const char* input_file, const AirportConfig& config, F&& run) {
+    bool priority = (config.scheduling == TowerScheduling::PRIORITY);
+    if (config.hangar == HangarModel::AGGREGATE) {
+        if (priority) {
+            runStaticAirport<StaticAirport<StaticAggregateHangar, true>>(reference, input_file, config, run);
+        } else {
+            runStaticAirport<StaticAirport<StaticAggregateHangar, false>>(reference, input_file, config, run);
+        }
+    } else if (priority) {
+        runStaticAirport<StaticAirport<StaticHangar, true>>(reference, input_file, config, run);
+    } else {
+        runStaticAirport<StaticAirport<StaticHangar, false>>(reference, input_file, config, run);
+    }
+}
+
+#endif // STATIC_AIRPORT_HPP
@@ -3,6 +3,7 @@
  *
  * Contains 4 storage bays and a merger. Each bay receives planes
  * from a specific selector output and drains to the merger.
+ * A DwellConfig turns on turnaround times in every bay.
  *
  * Authors: Hasib Khodayar & Hajar Assim
  * Course: SYSC 4906G, Winter 2026
@@ -12,28 +13,37 @@
 #define STORAGE_BANK_HPP
 
 #include <cadmium/modeling/devs/coupled.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
 #include "../atomics/storageBay.hpp"
 #include "../atomics/merger.hpp"
 
 using namespace cadmium;
 
 class StorageBank : public Coupled {
+    std::shared_ptr<StorageBay> bays[4];
+    std::shared_ptr<Merger> merger;
+
 public:
-    Port<int> in1, in2, in3, in4;
-    Port<int> out;
-
-    StorageBank(const std::string& id) : Coupled(id) {
-        in1 = addInPort<int>("in1");
-        in2 = addInPort<int>("in2");
-        in3 = addInPort<int>("in3");
-        in4 = addInPort<int>("in4");
-        out = addOutPort<int>("out");
-
-        auto bay1 = addComponent<StorageBay>("Bay1");
-        auto bay2 = addComponent<StorageBay>("Bay2");
-        auto bay3 = addComponent<StorageBay>("Bay3");
-        auto bay4 = addComponent<StorageBay>("Bay4");
-        auto merger = addComponent<Merger>("Merger");
+    PooledPort<PlaneMsg> in1, in2, in3, in4;
+    PooledPort<PlaneMsg> out;
+
+    StorageBank(const std::string& id, const DwellConfig& dwell = DwellConfig()) : Coupled(id) {
+        in1 = addPooledInPort<PlaneMsg>(this, "in1");
+        in2 = addPooledInPort<PlaneMsg>(this, "in2");
+        in3 = addPooledInPort<PlaneMsg>(this, "in3");
+        in4 = addPooledInPort<PlaneMsg>(this, "in4");
+        out = addPooledOutPort<PlaneMsg>(this, "out");
+
+        auto bay1 = addComponent<StorageBay>("Bay1", dwell);
+        auto bay2 = addComponent<StorageBay>("Bay2", dwell);
+        auto bay3 = addComponent<StorageBay>("Bay3", dwell);
+        auto bay4 = addComponent<StorageBay>("Bay4", dwell);
+        merger = addComponent<Merger>("Merger");
+        bays[0] = bay1;
+        bays[1] = bay2;
+        bays[2] = bay3;
+        bays[3] = bay4;
 
         // external input couplings
         addCoupling(in1, bay1->in);
@@ -50,6 +60,12 @@ public:
         // external output coupling
         addCoupling(merger->out, out);
     }
+
+    // every bay and the merger back to their initial state, with new dwell options
+    void reset(const DwellConfig& dwell = DwellConfig()) {
+        for (auto& bay : bays) bay->reset(dwell);
+        merger->reset();
+    }
 };
 
 #endif // STORAGE_BANK_HPP
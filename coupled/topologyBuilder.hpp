@@ -0,0 +1,602 @@
+/*
+ * Topology Builder
+ *
+ * Builds a coupled model at run time from a CD++ style .ma file, the
+ * format visualization/Airport.ma and the ViewerLogger use, instead of
+ * hand-wiring it in C++:
+ *
+ *   [top]                          the model built; other sections are
+ *   components : Generator@Generator   coupled models it instantiates
+ *   components : Airport           a coupled child, built from [Airport]
+ *   components : North@Airport     a coupled child named North, from [Airport]
+ *   in : in_landing in_priority    ports of the model itself; ports used in
+ *   out : out_takeoff              a link are created without this
+ *   Link : out@Generator in_landing@Airport   port@component, or a port of
+ *   Link : out_takeoff@Airport out_takeoff    the model itself
+ *
+ *   [landing_queue]                parameters for every atomic of that name,
+ *   queue-capacity : 4             as the --option=value of the command line
+ *
+ * A component type after @ is a section of the file or one of the atomics
+ * in the AtomicRegistry: Generator (PlaneGenerator, reading the input
+ * file), Queue, ControlTower, Runway, Selector, StorageBay, Merger and
+ * AggregateHangar, built from the AirportConfig as AirportTop builds them.
+ * Comments start with % or #.
+ *
+ * Repeated blocks generate large layouts without writing them out:
+ *
+ *   repeat : i 1 1000
+ *   components : Airport{i}@Airport
+ *   Link : out@Generator in_landing@Airport{i}
+ *   end
+ *
+ * {i} is the loop value and {i+1} / {i-1} its neighbours, in any name;
+ * repeats nest. The components of a section are all built, in file
+ * order, before its links are made, so a link may name a component
+ * declared further down. A port of the model itself takes the message
+ * type of the port it is first linked to.
+ *
+ * The file is parsed once into a statement tree and every instance of a
+ * section replays it. Links go straight into the coupling lists with the
+ * ports looked up in hash maps: Cadmium's addCoupling checks each
+ * coupling against every port and coupling of the model, which is
+ * quadratic in a model with thousands of components.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef TOPOLOGY_BUILDER_HPP
+#define TOPOLOGY_BUILDER_HPP
+
+#include <cadmium/modeling/devs/coupled.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../atomics/planeGenerator.hpp"
+#include "../atomics/controlTower.hpp"
+#include "../atomics/queue.hpp"
+#include "../atomics/runway.hpp"
+#include "../atomics/selector.hpp"
+#include "../atomics/storageBay.hpp"
+#include "../atomics/merger.hpp"
+#include "../atomics/aggregateHangar.hpp"
+#include "airportTop.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace cadmium;
+
+// what the registered atomics are built from
+struct AtomicParameters {
+    AirportConfig config;
+    std::string input_file;  // read by every Generator
+};
+
+// atomic class name -> factory
+class AtomicRegistry {
+public:
+    using Factory = std::function<std::shared_ptr<Component>(const std::string& id, const AtomicParameters&)>;
+
+private:
+    std::unordered_map<std::string, Factory> factories;
+
+public:
+    void add(const std::string& name, Factory factory) { factories[name] = std::move(factory); }
+
+    [[nodiscard]] const Factory* find(const std::string& name) const {
+        auto it = factories.find(name);
+        return it == factories.end() ? nullptr : &it->second;
+    }
+
+    // the airport's atomics, with the arguments AirportTop gives them
+    static AtomicRegistry airport() {
+        AtomicRegistry registry;
+        auto generator = [](const std::string& id, const AtomicParameters& p) -> std::shared_ptr<Component> {
+            return std::make_shared<PlaneGenerator>(id, p.input_file.c_str());
+        };
+        registry.add("Generator", generator);
+        registry.add("PlaneGenerator", generator);
+        registry.add("Queue", [](const std::string& id, const AtomicParameters& p) -> std::shared_ptr<Component> {
+            return std::make_shared<Queue>(id, p.config.queue_capacity, p.config.queue_overflow);
+        });
+        registry.add("ControlTower", [](const std::string& id, const AtomicParameters& p) -> std::shared_ptr<Component> {
+            return std::make_shared<ControlTower>(id, p.config.scheduling, p.config.signalling);
+        });
+        registry.add("Runway", [](const std::string& id, const AtomicParameters&) -> std::shared_ptr<Component> {
+            return std::make_shared<Runway>(id);
+        });
+        registry.add("Selector", [](const std::string& id, const AtomicParameters&) -> std::shared_ptr<Component> {
+            return std::make_shared<Selector>(id);
+        });
+        registry.add("StorageBay", [](const std::string& id, const AtomicParameters& p) -> std::shared_ptr<Component> {
+            return std::make_shared<StorageBay>(id, p.config.hangar_dwell);
+        });
+        registry.add("Merger", [](const std::string& id, const AtomicParameters&) -> std::shared_ptr<Component> {
+            return std::make_shared<Merger>(id);
+        });
+        registry.add("AggregateHangar", [](const std::string& id, const AtomicParameters& p) -> std::shared_ptr<Component> {
+            return std::make_shared<AggregateHangar>(id, p.config.hangar_dwell);
+        });
+        return registry;
+    }
+};
+
+// "Bay{i+1}": literal text and references to the enclosing repeats' values
+struct NameTemplate {
+    struct Part {
+        std::string text;
+        int depth = -1;   // repeat nesting level whose value goes here, -1 for text
+        long offset = 0;
+    };
+    std::vector<Part> parts;
+
+    [[nodiscard]] std::string expand(const std::vector<long>& values) const {
+        if (parts.size() == 1 && parts[0].depth < 0) return parts[0].text;
+        std::string name;
+        for (const auto& part : parts) {
+            if (part.depth < 0) {
+                name += part.text;
+            } else {
+                name += std::to_string(values[static_cast<std::size_t>(part.depth)] + part.offset);
+            }
+        }
+        return name;
+    }
+};
+
+// port@component, or a port of the model itself when component is empty
+struct TopologyEndpoint {
+    NameTemplate port;
+    NameTemplate component;
+    bool own = false;
+};
+
+struct TopologyStatement {
+    enum class Kind { COMPONENT, IN, OUT, LINK, REPEAT };
+    Kind kind = Kind::COMPONENT;
+    int line = 0;
+    NameTemplate name;        // component or port
+    std::string type;         // component type, empty for a section of the same name
+    TopologyEndpoint from, to;
+    long first = 0, last = 0; // repeat range, inclusive
+    std::vector<TopologyStatement> body;
+};
+
+struct TopologySection {
+    std::string name;
+    int line = 0;
+    std::vector<TopologyStatement> statements;
+    std::vector<std::pair<std::string, std::string>> parameters;  // key : value lines
+
+    [[nodiscard]] bool coupled() const { return !statements.empty(); }
+};
+
+// a parsed .ma file
+class TopologyFile {
+    std::string source;  // file name for messages
+    std::unordered_map<std::string, TopologySection> sections;
+
+    [[noreturn]] void fail(int line, const std::string& message) const {
+        throw CadmiumModelException(source + ":" + std::to_string(line) + ": " + message);
+    }
+
+    static std::string_view trim(std::string_view text) {
+        std::size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos) return {};
+        std::size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    static std::vector<std::string_view> words(std::string_view text) {
+        std::vector<std::string_view> result;
+        std::size_t i = 0;
+        while (i < text.size()) {
+            std::size_t begin = text.find_first_not_of(" \t", i);
+            if (begin == std::string_view::npos) break;
+            std::size_t end = text.find_first_of(" \t", begin);
+            if (end == std::string_view::npos) end = text.size();
+            result.push_back(text.substr(begin, end - begin));
+            i = end;
+        }
+        return result;
+    }
+
+    NameTemplate nameTemplate(std::string_view text, const std::vector<std::string>& scope, int line) const {
+        NameTemplate name;
+        std::size_t i = 0;
+        while (i < text.size()) {
+            std::size_t open = text.find('{', i);
+            if (open == std::string_view::npos) open = text.size();
+            if (open > i) name.parts.push_back(NameTemplate::Part{std::string(text.substr(i, open - i)), -1, 0});
+            if (open == text.size()) break;
+            std::size_t close = text.find('}', open);
+            if (close == std::string_view::npos) fail(line, "missing } in " + std::string(text));
+            std::string_view ref = text.substr(open + 1, close - open - 1);
+            std::size_t sign = ref.find_first_of("+-");
+            std::string var(trim(ref.substr(0, sign)));
+            long offset = 0;
+            if (sign != std::string_view::npos) {
+                std::string number(trim(ref.substr(sign + 1)));
+                char* end = nullptr;
+                offset = std::strtol(number.c_str(), &end, 10);
+                if (number.empty() || *end != '\0') fail(line, "bad offset in {" + std::string(ref) + "}");
+                if (ref[sign] == '-') offset = -offset;
+            }
+            int depth = -1;
+            for (std::size_t d = 0; d < scope.size(); d++) {
+                if (scope[d] == var) depth = static_cast<int>(d);
+            }
+            if (depth < 0) fail(line, "{" + var + "} is not a repeat variable here");
+            name.parts.push_back(NameTemplate::Part{std::string(), depth, offset});
+            i = close + 1;
+        }
+        if (name.parts.empty()) fail(line, "empty name");
+        return name;
+    }
+
+    TopologyEndpoint endpoint(std::string_view text, const std::vector<std::string>& scope, int line) const {
+        TopologyEndpoint end;
+        std::size_t at = text.find('@');
+        end.own = (at == std::string_view::npos);
+        end.port = nameTemplate(text.substr(0, at), scope, line);
+        if (!end.own) end.component = nameTemplate(text.substr(at + 1), scope, line);
+        return end;
+    }
+
+public:
+    static TopologyFile parse(const std::string& text, const std::string& source = "topology") {
+        TopologyFile file;
+        file.source = source;
+        TopologySection* section = nullptr;
+        std::vector<std::vector<TopologyStatement>*> blocks;  // statement lists being filled, innermost last
+        std::vector<std::string> scope;                        // repeat variables, outermost first
+        std::vector<int> repeat_lines;
+
+        std::string_view rest(text);
+        int line = 0;
+        while (!rest.empty()) {
+            std::size_t nl = rest.find('\n');
+            std::string_view raw = rest.substr(0, nl);
+            rest = (nl == std::string_view::npos) ? std::string_view() : rest.substr(nl + 1);
+            line++;
+            std::size_t comment = raw.find_first_of("%#");
+            std::string_view content = trim(raw.substr(0, comment));
+            if (content.empty()) continue;
+
+            if (content.front() == '[') {
+                if (!scope.empty()) file.fail(repeat_lines.back(), "repeat without end");
+                if (content.back() != ']') file.fail(line, "bad section header");
+                std::string name(trim(content.substr(1, content.size() - 2)));
+                auto inserted = file.sections.emplace(name, TopologySection());
+                if (!inserted.second) file.fail(line, "section [" + name + "] defined twice");
+                section = &inserted.first->second;
+                section->name = name;
+                section->line = line;
+                blocks.assign(1, &section->statements);
+                continue;
+            }
+            if (section == nullptr) file.fail(line, "line outside any [section]");
+
+            if (content == "end") {
+                if (scope.empty()) file.fail(line, "end without repeat");
+                scope.pop_back();
+                repeat_lines.pop_back();
+                blocks.pop_back();
+                continue;
+            }
+            std::size_t colon = content.find(':');
+            if (colon == std::string_view::npos) file.fail(line, "expected key : value");
+            std::string key(trim(content.substr(0, colon)));
+            std::string_view value = trim(content.substr(colon + 1));
+            std::vector<std::string_view> items = words(value);
+            std::vector<TopologyStatement>& block = *blocks.back();
+
+            if (key == "components") {
+                for (std::string_view item : items) {
+                    TopologyStatement s;
+                    s.kind = TopologyStatement::Kind::COMPONENT;
+                    s.line = line;
+                    std::size_t at = item.find('@');
+                    s.name = file.nameTemplate(item.substr(0, at), scope, line);
+                    if (at != std::string_view::npos) s.type = std::string(item.substr(at + 1));
+                    block.push_back(std::move(s));
+                }
+            } else if (key == "in" || key == "out") {
+                for (std::string_view item : items) {
+                    TopologyStatement s;
+                    s.kind = (key == "in") ? TopologyStatement::Kind::IN : TopologyStatement::Kind::OUT;
+                    s.line = line;
+                    s.name = file.nameTemplate(item, scope, line);
+                    block.push_back(std::move(s));
+                }
+            } else if (key == "Link" || key == "link") {
+                if (items.size() != 2) file.fail(line, "a link needs two endpoints");
+                TopologyStatement s;
+                s.kind = TopologyStatement::Kind::LINK;
+                s.line = line;
+                s.from = file.endpoint(items[0], scope, line);
+                s.to = file.endpoint(items[1], scope, line);
+                block.push_back(std::move(s));
+            } else if (key == "repeat") {
+                TopologyStatement s;
+                s.kind = TopologyStatement::Kind::REPEAT;
+                s.line = line;
+                char* end1 = nullptr;
+                char* end2 = nullptr;
+                std::string first = items.size() == 3 ? std::string(items[1]) : "";
+                std::string last = items.size() == 3 ? std::string(items[2]) : "";
+                s.first = std::strtol(first.c_str(), &end1, 10);
+                s.last = std::strtol(last.c_str(), &end2, 10);
+                if (items.size() != 3 || first.empty() || last.empty() || *end1 != '\0' || *end2 != '\0') {
+                    file.fail(line, "repeat needs a variable and a first and last value");
+                }
+                block.push_back(std::move(s));
+                scope.emplace_back(items[0]);
+                repeat_lines.push_back(line);
+                blocks.push_back(&block.back().body);
+            } else {
+                if (!scope.empty()) file.fail(line, "parameter " + key + " inside a repeat");
+                section->parameters.emplace_back(key, std::string(value));
+            }
+        }
+        if (!scope.empty()) file.fail(repeat_lines.back(), "repeat without end");
+        for (const auto& entry : file.sections) {
+            if (entry.second.coupled() && !entry.second.parameters.empty()) {
+                file.fail(entry.second.line, "[" + entry.first + "] has both components and parameters");
+            }
+        }
+        return file;
+    }
+
+    static TopologyFile load(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw CadmiumModelException("cannot read topology file " + path);
+        std::stringstream text;
+        text << in.rdbuf();
+        return parse(text.str(), path);
+    }
+
+    [[nodiscard]] const std::string& name() const { return source; }
+
+    [[nodiscard]] const TopologySection* section(const std::string& name) const {
+        auto it = sections.find(name);
+        return it == sections.end() ? nullptr : &it->second;
+    }
+
+    [[nodiscard]] const std::unordered_map<std::string, TopologySection>& allSections() const { return sections; }
+};
+
+// a coupled model built from a section, with its ports indexed by name
+class TopologyModel : public Coupled {
+    std::unordered_map<std::string, std::shared_ptr<PortInterface>> in_ports;
+    std::unordered_map<std::string, std::shared_ptr<PortInterface>> out_ports;
+
+    struct PairHash {
+        std::size_t operator()(const std::pair<const PortInterface*, const PortInterface*>& p) const {
+            return std::hash<const void*>()(p.first) * 31 + std::hash<const void*>()(p.second);
+        }
+    };
+    std::unordered_set<std::pair<const PortInterface*, const PortInterface*>, PairHash> couplings;
+
+public:
+    explicit TopologyModel(const std::string& id) : Coupled(id), in_ports(), out_ports(), couplings() {}
+
+    [[nodiscard]] std::shared_ptr<PortInterface> inPort(const std::string& name) const {
+        auto it = in_ports.find(name);
+        return it == in_ports.end() ? nullptr : it->second;
+    }
+
+    [[nodiscard]] std::shared_ptr<PortInterface> outPort(const std::string& name) const {
+        auto it = out_ports.find(name);
+        return it == out_ports.end() ? nullptr : it->second;
+    }
+
+    // a port of the message type of like, or a plane port without one
+    std::shared_ptr<PortInterface> addPort(bool input, const std::string& name,
+                                           const std::shared_ptr<PortInterface>& like = nullptr) {
+        auto port = like ? like->newCompatiblePort(name)
+                         : std::static_pointer_cast<PortInterface>(std::make_shared<_PooledPort<PlaneMsg>>(name));
+        if (input) {
+            addInPort(port);
+            in_ports.emplace(name, port);
+        } else {
+            addOutPort(port);
+            out_ports.emplace(name, port);
+        }
+        return port;
+    }
+
+    // same couplings as addCoupling, filed by who owns the ports instead of by searching
+    // this model's ports; false for a coupling made before
+    bool link(const std::shared_ptr<PortInterface>& from, const std::shared_ptr<PortInterface>& to) {
+        if (!from->compatible(to)) throw CadmiumModelException("ports are not compatible");
+        if (!couplings.emplace(from.get(), to.get()).second) return false;
+        if (from->getParent() == this) {
+            EIC.emplace_back(from, to);
+        } else if (to->getParent() == this) {
+            EOC.emplace_back(from, to);
+        } else {
+            IC.emplace_back(from, to);
+        }
+        return true;
+    }
+};
+
+struct TopologyStats {
+    std::size_t atomics = 0;
+    std::size_t coupled = 0;  // including the top model
+    std::size_t couplings = 0;
+};
+
+class TopologyBuilder {
+    const TopologyFile& file;
+    AtomicParameters parameters;
+    AtomicRegistry registry;
+    std::unordered_map<std::string, AtomicParameters> named;  // parameter sections, by atomic name
+    TopologyStats counts;
+    std::vector<long> values;                                 // current repeat values
+    std::vector<const TopologySection*> building;             // sections being built, to catch cycles
+
+    [[noreturn]] void fail(int line, const std::string& message) const {
+        throw CadmiumModelException(file.name() + ":" + std::to_string(line) + ": " + message);
+    }
+
+    // the component's port, searched among the ports of an atomic
+    static std::shared_ptr<PortInterface> findPort(const Component& component, const std::string& name, bool input) {
+        if (auto model = dynamic_cast<const TopologyModel*>(&component)) {
+            return input ? model->inPort(name) : model->outPort(name);
+        }
+        for (const auto& port : input ? component.getInPorts() : component.getOutPorts()) {
+            if (port->getId() == name) return port;
+        }
+        return nullptr;
+    }
+
+    void addComponents(TopologyModel& model, const std::vector<TopologyStatement>& statements) {
+        for (const auto& s : statements) {
+            if (s.kind == TopologyStatement::Kind::REPEAT) {
+                values.push_back(0);
+                for (long v = s.first; v <= s.last; v++) {
+                    values.back() = v;
+                    addComponents(model, s.body);
+                }
+                values.pop_back();
+            } else if (s.kind == TopologyStatement::Kind::IN || s.kind == TopologyStatement::Kind::OUT) {
+                bool input = (s.kind == TopologyStatement::Kind::IN);
+                std::string name = s.name.expand(values);
+                if (model.inPort(name) || model.outPort(name)) fail(s.line, "port " + name + " declared twice");
+                model.addPort(input, name);
+            } else if (s.kind == TopologyStatement::Kind::COMPONENT) {
+                std::string id = s.name.expand(values);
+                const std::string& type = s.type.empty() ? id : s.type;
+                if (model.getComponents().count(id) != 0) fail(s.line, "component " + id + " defined twice");
+                const TopologySection* section = file.section(type);
+                if (section != nullptr && section->coupled()) {
+                    model.addComponent(std::static_pointer_cast<Component>(instantiate(*section, id, s.line)));
+                } else if (const AtomicRegistry::Factory* factory = registry.find(type)) {
+                    auto it = named.find(id);
+                    model.addComponent((*factory)(id, it == named.end() ? parameters : it->second));
+                    counts.atomics++;
+                } else {
+                    fail(s.line, "no section [" + type + "] and no atomic named " + type);
+                }
+            }
+        }
+    }
+
+    void addLinks(TopologyModel& model, const std::vector<TopologyStatement>& statements) {
+        for (const auto& s : statements) {
+            if (s.kind == TopologyStatement::Kind::REPEAT) {
+                values.push_back(0);
+                for (long v = s.first; v <= s.last; v++) {
+                    values.back() = v;
+                    addLinks(model, s.body);
+                }
+                values.pop_back();
+            } else if (s.kind == TopologyStatement::Kind::LINK) {
+                link(model, s);
+            }
+        }
+    }
+
+    // a child's port, or nullptr if the endpoint is the model's own
+    std::shared_ptr<PortInterface> childPort(const TopologyModel& model, const TopologyEndpoint& end, bool input,
+                                             int line) {
+        if (end.own) return nullptr;
+        std::string id = end.component.expand(values);
+        auto it = model.getComponents().find(id);
+        if (it == model.getComponents().end()) fail(line, "no component " + id + " in [" + model.getId() + "]");
+        std::string name = end.port.expand(values);
+        auto port = findPort(*it->second, name, input);
+        if (port == nullptr) fail(line, id + " has no " + (input ? "input" : "output") + " port " + name);
+        return port;
+    }
+
+    void link(TopologyModel& model, const TopologyStatement& s) {
+        auto from = childPort(model, s.from, false, s.line);
+        auto to = childPort(model, s.to, true, s.line);
+        // ports of the model itself, created on first use with the type of the other end
+        if (s.from.own) {
+            std::string name = s.from.port.expand(values);
+            if (model.outPort(name)) fail(s.line, name + " is an output of the model, not an input");
+            from = model.inPort(name);
+            if (!from) from = model.addPort(true, name, to);
+        }
+        if (s.to.own) {
+            std::string name = s.to.port.expand(values);
+            if (model.inPort(name)) fail(s.line, name + " is an input of the model, not an output");
+            to = model.outPort(name);
+            if (!to) to = model.addPort(false, name, from);
+        }
+        try {
+            if (!model.link(from, to)) fail(s.line, "link made twice");
+        } catch (const CadmiumModelException& e) {
+            if (std::string(e.what()).rfind(file.name(), 0) == 0) throw;
+            fail(s.line, e.what());
+        }
+        counts.couplings++;
+    }
+
+    std::shared_ptr<TopologyModel> instantiate(const TopologySection& section, const std::string& id, int line) {
+        for (const auto* outer : building) {
+            if (outer == &section) fail(line, "[" + section.name + "] contains itself");
+        }
+        building.push_back(&section);
+        std::vector<long> outer_values;
+        outer_values.swap(values);  // repeat variables do not reach into other sections
+
+        auto model = std::make_shared<TopologyModel>(id);
+        addComponents(*model, section.statements);
+        addLinks(*model, section.statements);
+        counts.coupled++;
+
+        values.swap(outer_values);
+        building.pop_back();
+        return model;
+    }
+
+public:
+    TopologyBuilder(const TopologyFile& file, AtomicParameters parameters,
+                    AtomicRegistry registry = AtomicRegistry::airport())
+        : file(file), parameters(std::move(parameters)), registry(std::move(registry)), named(), counts(), values(),
+          building() {
+        for (const auto& entry : file.allSections()) {
+            const TopologySection& section = entry.second;
+            if (section.coupled()) continue;
+            AtomicParameters own = this->parameters;
+            for (const auto& [key, value] : section.parameters) {
+                bool known = false;
+                try {
+                    known = parseAirportOption("--" + key + "=" + value, own.config);
+                } catch (const std::exception&) {
+                }
+                if (!known) fail(section.line, "bad parameter " + key + " : " + value);
+            }
+            named.emplace(section.name, std::move(own));
+        }
+    }
+
+    // the model of section (default [top]) under the given id
+    std::shared_ptr<TopologyModel> build(const std::string& id, const std::string& section = "top") {
+        const TopologySection* top = file.section(section);
+        if (top == nullptr || !top->coupled()) {
+            throw CadmiumModelException(file.name() + ": no [" + section + "] section with components");
+        }
+        counts = TopologyStats();
+        return instantiate(*top, id, top->line);
+    }
+
+    [[nodiscard]] const TopologyStats& stats() const { return counts; }
+};
+
+#endif // TOPOLOGY_BUILDER_HPP
@@ -0,0 +1,156 @@
+/**
+ * Indexed Binary Heap
+ *
+ * Binary heap that hands out a stable handle for every element, so an
+ * element's key can be changed in O(log n) without searching for it.
+ * push, pop and update are all O(log n), top is O(1).
+ *
+ * Compare(a, b) returns true when key a must be served before key b.
+ * The default (std::greater) serves the highest key first. Equal keys
+ * are served in insertion order, and an update keeps the element's
+ * original place in that order.
+ *
+ * Handles of popped elements are recycled, storage is kept between
+ * uses so a heap at steady size does not allocate.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+template <typename T, typename Key = int, typename Compare = std::greater<Key>>
+class IndexedHeap {
+public:
+    using Handle = std::size_t;
+    static constexpr Handle NO_HANDLE = std::numeric_limits<Handle>::max();
+
+private:
+    struct Node {
+        T value;
+        Key key;
+        std::uint64_t seq;  // insertion order, breaks ties between equal keys
+    };
+
+    std::vector<Node> nodes;             // indexed by handle
+    std::vector<Handle> heap;            // heap order, holds handles
+    std::vector<std::size_t> position;   // handle -> index in heap, NO_HANDLE when free
+    std::vector<Handle> free_handles;
+    std::uint64_t next_seq;
+    Compare compare;
+
+    [[nodiscard]] bool before(Handle a, Handle b) const {
+        const Node& x = nodes[a];
+        const Node& y = nodes[b];
+        if (compare(x.key, y.key)) return true;
+        if (compare(y.key, x.key)) return false;
+        return x.seq < y.seq;
+    }
+
+    void place(std::size_t i, Handle h) {
+        heap[i] = h;
+        position[h] = i;
+    }
+
+    void siftUp(std::size_t i) {
+        Handle h = heap[i];
+        while (i > 0) {
+            std::size_t parent = (i - 1) / 2;
+            if (!before(h, heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, h);
+    }
+
+    void siftDown(std::size_t i) {
+        Handle h = heap[i];
+        std::size_t n = heap.size();
+        while (true) {
+            std::size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && before(heap[child + 1], heap[child])) child++;
+            if (!before(heap[child], h)) break;
+            place(i, heap[child]);
+            i = child;
+        }
+        place(i, h);
+    }
+
+    void removeAt(std::size_t i) {
+        Handle h = heap[i];
+        Handle last = heap.back();
+        heap.pop_back();
+        position[h] = NO_HANDLE;
+        free_handles.push_back(h);
+        if (i < heap.size()) {
+            place(i, last);
+            siftDown(i);
+            siftUp(position[last]);
+        }
+    }
+
+public:
+    IndexedHeap() : nodes(), heap(), position(), free_handles(), next_seq(0), compare() {}
+
+    [[nodiscard]] bool empty() const { return heap.empty(); }
+    [[nodiscard]] std::size_t size() const { return heap.size(); }
+
+    Handle push(const T& value, Key key) {
+        Handle h;
+        if (!free_handles.empty()) {
+            h = free_handles.back();
+            free_handles.pop_back();
+            nodes[h] = Node{value, key, next_seq++};
+        } else {
+            h = nodes.size();
+            nodes.push_back(Node{value, key, next_seq++});
+            position.push_back(NO_HANDLE);
+        }
+        heap.push_back(h);
+        position[h] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+        return h;
+    }
+
+    [[nodiscard]] const T& top() const { return nodes[heap.front()].value; }
+    [[nodiscard]] Key topKey() const { return nodes[heap.front()].key; }
+    [[nodiscard]] Handle topHandle() const { return heap.front(); }
+
+    void pop() { removeAt(0); }
+
+    [[nodiscard]] bool contains(Handle h) const {
+        return h < position.size() && position[h] != NO_HANDLE;
+    }
+
+    [[nodiscard]] const T& get(Handle h) const { return nodes[h].value; }
+    [[nodiscard]] T& get(Handle h) { return nodes[h].value; }
+    [[nodiscard]] Key key(Handle h) const { return nodes[h].key; }
+
+    // change the key of a queued element, O(log n)
+    void update(Handle h, Key key) {
+        nodes[h].key = key;
+        siftUp(position[h]);
+        siftDown(position[h]);
+    }
+
+    void erase(Handle h) { removeAt(position[h]); }
+
+    // drop all elements but keep the storage
+    void clear() {
+        for (Handle h : heap) {
+            position[h] = NO_HANDLE;
+            free_handles.push_back(h);
+        }
+        heap.clear();
+    }
+};
+
+#endif // INDEXED_HEAP_HPP
@@ -0,0 +1,114 @@
+/**
+ * Line Reader
+ *
+ * Splits the bytes read from a file descriptor into lines using one
+ * fixed-size buffer, for input that arrives a piece at a time from a
+ * pipe, FIFO or socket. A line split across reads is kept until its
+ * newline arrives, so the caller only ever sees whole lines. Lines
+ * longer than the buffer are dropped and counted rather than grown into.
+ *
+ * Works on blocking and non-blocking descriptors: next() returns AGAIN
+ * when a non-blocking descriptor has no complete line yet. A last line
+ * without a newline is returned when the writer closes.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef LINE_READER_HPP
+#define LINE_READER_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <unistd.h>
+
+class LineReader {
+public:
+    enum class Status { LINE, AGAIN, END };
+
+    static constexpr std::size_t BUFFER_SIZE = 4096;
+
+private:
+    int fd;
+    char buffer[BUFFER_SIZE];
+    std::size_t begin;     // first unread byte
+    std::size_t end;       // one past the last buffered byte
+    bool closed;           // writer closed, nothing more will arrive
+    bool skipping;         // discarding the rest of an overlong line
+    unsigned long dropped;
+
+public:
+    explicit LineReader(int fd) : fd(fd), buffer(), begin(0), end(0), closed(false), skipping(false), dropped(0) {}
+
+    [[nodiscard]] int descriptor() const { return fd; }
+    [[nodiscard]] bool isClosed() const { return closed && begin == end; }
+    [[nodiscard]] unsigned long droppedLines() const { return dropped; }
+
+    // swap in a new descriptor (a reconnecting client), dropping any partial line
+    void reset(int new_fd) {
+        fd = new_fd;
+        begin = end = 0;
+        closed = false;
+        skipping = false;
+    }
+
+    // next complete line without its newline, valid until the next call
+    Status next(std::string_view& line) {
+        while (true) {
+            // complete line already buffered
+            const char* start = buffer + begin;
+            const void* nl = std::memchr(start, '\n', end - begin);
+            if (nl != nullptr) {
+                std::size_t length = static_cast<const char*>(nl) - start;
+                begin += length + 1;
+                if (skipping) {
+                    skipping = false;
+                    continue;
+                }
+                if (length > 0 && start[length - 1] == '\r') length--;
+                line = std::string_view(start, length);
+                return Status::LINE;
+            }
+
+            if (closed) {
+                // last line had no newline
+                if (begin == end || skipping) {
+                    begin = end;
+                    return Status::END;
+                }
+                line = std::string_view(start, end - begin);
+                begin = end;
+                return Status::LINE;
+            }
+
+            // make room: move the partial line to the front, or drop it if it fills the buffer
+            if (begin > 0) {
+                std::memmove(buffer, buffer + begin, end - begin);
+                end -= begin;
+                begin = 0;
+            }
+            if (end == BUFFER_SIZE) {
+                if (!skipping) dropped++;
+                skipping = true;
+                begin = end = 0;
+            }
+
+            ssize_t n = ::read(fd, buffer + end, BUFFER_SIZE - end);
+            if (n > 0) {
+                end += static_cast<std::size_t>(n);
+            } else if (n == 0) {
+                closed = true;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return Status::AGAIN;
+            } else {
+                closed = true;
+            }
+        }
+    }
+};
+
+#endif // LINE_READER_HPP
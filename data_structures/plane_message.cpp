@@ -1,9 +1,9 @@
 /**
  * Plane Message Implementation
  *
- * Currently empty as all functionality is in the header.
- * This file exists for consistency with ABP repo structure
- * and for potential future extensions.
+ * Stream operators for PlaneMessage. They live here rather than in the
+ * header so every binary can include plane_message.hpp from several
+ * translation units and link against plane_message.o once.
  *
  * Authors: Hasib Khodayar & Hajar Assim
  * Course: SYSC 4906G, Winter 2026
@@ -11,5 +11,86 @@
 
 #include "plane_message.hpp"
 
-// all functionality is header only for now
-// this file can be extended if more complex message handling is needed
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <string>
+
+std::ostream& operator<<(std::ostream& out, const PlaneMessage& msg) {
+    out << msg.plane_id;
+    return out;
+}
+
+namespace {
+
+// next whitespace separated field of a line, empty at the end
+std::string_view nextField(std::string_view& rest) {
+    std::size_t start = rest.find_first_not_of(" \t");
+    if (start == std::string_view::npos) {
+        rest = std::string_view();
+        return rest;
+    }
+    std::size_t stop = rest.find_first_of(" \t", start);
+    if (stop == std::string_view::npos) stop = rest.size();
+    std::string_view field = rest.substr(start, stop - start);
+    rest.remove_prefix(stop);
+    return field;
+}
+
+template <typename Number>
+bool toNumber(std::string_view field, Number& value) {
+    if (field.empty()) return false;
+    auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    return result.ec == std::errc() && result.ptr == field.data() + field.size();
+}
+
+// the columns after the ID: a missing or malformed one keeps the rest at
+// their defaults, one out of range rejects the line (a priority above
+// emergency would outrank it, a wrapped class, fuel or dwell would be
+// another plane)
+bool parseColumns(std::string_view rest, PlaneMessage& msg) {
+    int plane_class, priority, fuel;
+    double dwell;
+    if (!toNumber(nextField(rest), plane_class)) return true;
+    if (plane_class < 0 || plane_class > static_cast<int>(PlaneClass::HEAVY)) return false;
+    msg.plane_class = static_cast<PlaneClass>(plane_class);
+    if (!toNumber(nextField(rest), priority)) return true;
+    if (priority < 0 || priority > PlaneMessage::PRIORITY_EMERGENCY) return false;
+    msg.priority = static_cast<std::uint8_t>(priority);
+    if (!toNumber(nextField(rest), fuel)) return true;
+    if (fuel < 0 || fuel > std::numeric_limits<std::uint16_t>::max()) return false;
+    msg.fuel = static_cast<std::uint16_t>(fuel);
+    if (!toNumber(nextField(rest), dwell)) return true;
+    if (!std::isfinite(dwell) || dwell < 0 || dwell > std::numeric_limits<float>::max()) return false;
+    msg.dwell_time = static_cast<float>(dwell);
+    return true;
+}
+
+}  // namespace
+
+// reads "plane_id [class priority fuel dwell]", the extra columns are the rest of the
+// line and read as parsePlaneLine reads them; a column out of range fails the stream
+std::istream& operator>>(std::istream& in, PlaneMessage& msg) {
+    msg = PlaneMessage();
+    if (!(in >> msg.plane_id)) return in;
+
+    // the newline is left for the next read, a line without one ends the stream here
+    std::string rest;
+    for (int c = in.eof() ? '\n' : in.peek(); c != '\n' && c != std::char_traits<char>::eof(); c = in.peek()) {
+        rest.push_back(static_cast<char>(in.get()));
+    }
+    if (!parseColumns(rest, msg)) in.setstate(std::ios::failbit);
+    return in;
+}
+
+bool parsePlaneLine(std::string_view line, double& time, PlaneMessage& msg) {
+    msg = PlaneMessage();
+    int id;
+    if (!toNumber(nextField(line), time) || !toNumber(nextField(line), id)) return false;
+    msg.plane_id = id;
+    return parseColumns(line, msg);
+}
+
+bool parsePlaneLine(std::string_view line, double& time, int& plane) {
+    return toNumber(nextField(line), time) && toNumber(nextField(line), plane);
+}
@@ -1,9 +1,10 @@
 /**
  * Plane Message Data Structure
  *
- * Simple wrapper for plane ID used in airport simulation.
- * We use int directly for plane IDs, but this file exists for
- * consistency with the AlternatingBitProtocol repo structure.
+ * Record carried on every plane port of the airport model. It is a
+ * trivially-copyable 24 byte struct, so bags and model buffers
+ * copy it like a plain int and no side tables are needed for timing or
+ * priority or hangar dwell information.
  *
  * Plane IDs range from 0-999 and determine storage bay assignment:
  *   - Bay 1: IDs 0-249
@@ -11,6 +12,16 @@
  *   - Bay 3: IDs 500-749
  *   - Bay 4: IDs 750-999
  *
+ * Input format (one arrival per line, extra columns optional):
+ *   time plane_id [class priority fuel dwell]
+ * Lines with just time and ID take the cheap path and use the defaults.
+ * A class, priority, fuel or dwell outside its range rejects the line.
+ *
+ * Building with -DAIRPORT_INT_MESSAGES switches PlaneMsg back to a bare
+ * int ID, which the benchmarks use as the reference build. Models only
+ * read messages through the planeId/planePriority helpers so both
+ * builds compile from the same source.
+ *
  * Authors: Hasib Khodayar & Hajar Assim
  * Course: SYSC 4906G, Winter 2026
  */
@@ -18,33 +29,76 @@
 #ifndef PLANE_MESSAGE_HPP
 #define PLANE_MESSAGE_HPP
 
+#include <cstdint>
 #include <iostream>
+#include <string_view>
+#include <type_traits>
+
+enum class PlaneClass : std::uint8_t { LIGHT = 0, MEDIUM = 1, HEAVY = 2 };
 
 /**
- * PlaneMessage - Optional wrapper for plane ID
+ * PlaneMessage - plane ID plus the metadata the models schedule on
  *
- * The simulation primarily uses int directly for plane IDs.
- * This struct is provided for future extensibility if additional
- * metadata (fuel level, priority, etc.) needs to be added.
+ * Fields are ordered largest first so the only padding is at the end.
+ * Priority: 0 is normal traffic, higher values are served first
+ * by models that schedule on priority.
  */
 struct PlaneMessage {
-    int plane_id;
+    double arrival_time;       // simulation time the plane entered the airport
+    std::int32_t plane_id;
+    float dwell_time;          // seconds to park in the hangar, 0 = bay default
+    std::uint16_t fuel;        // minutes of fuel left, 0 when unknown
+    PlaneClass plane_class;
+    std::uint8_t priority;
 
-    PlaneMessage() : plane_id(0) {}
-    PlaneMessage(int id) : plane_id(id) {}
+    static constexpr std::uint8_t PRIORITY_NORMAL = 0;
+    static constexpr std::uint8_t PRIORITY_LOW_FUEL = 1;
+    static constexpr std::uint8_t PRIORITY_EMERGENCY = 2;
+
+    PlaneMessage()
+        : arrival_time(0), plane_id(0), dwell_time(0), fuel(0),
+          plane_class(PlaneClass::MEDIUM), priority(PRIORITY_NORMAL) {}
+    PlaneMessage(int id)
+        : arrival_time(0), plane_id(id), dwell_time(0), fuel(0),
+          plane_class(PlaneClass::MEDIUM), priority(PRIORITY_NORMAL) {}
 
     // conversion to from int for compatibility
     operator int() const { return plane_id; }
 };
 
-std::ostream& operator<<(std::ostream& out, const PlaneMessage& msg) {
-    out << msg.plane_id;
-    return out;
-}
+static_assert(std::is_trivially_copyable<PlaneMessage>::value, "PlaneMessage must stay trivially copyable");
+static_assert(sizeof(PlaneMessage) <= 32, "PlaneMessage must fit in 32 bytes");
+
+// logged as the bare ID so traces stay comparable with the int build
+std::ostream& operator<<(std::ostream& out, const PlaneMessage& msg);
+std::istream& operator>>(std::istream& in, PlaneMessage& msg);
+
+// parse "time plane_id [class priority fuel dwell]" from one input line
+// without copying it, false if the line has no time and ID or a class,
+// priority, fuel or dwell out of range
+bool parsePlaneLine(std::string_view line, double& time, PlaneMessage& msg);
+bool parsePlaneLine(std::string_view line, double& time, int& plane);
+
+#ifdef AIRPORT_INT_MESSAGES
+using PlaneMsg = int;
+#else
+using PlaneMsg = PlaneMessage;
+#endif
+
+// accessors shared by the int and PlaneMessage builds
+inline int planeId(int plane) { return plane; }
+inline int planeId(const PlaneMessage& plane) { return plane.plane_id; }
+
+inline int planePriority(int) { return PlaneMessage::PRIORITY_NORMAL; }
+inline int planePriority(const PlaneMessage& plane) { return plane.priority; }
+
+inline double planeDwell(int) { return 0.0; }
+inline double planeDwell(const PlaneMessage& plane) { return plane.dwell_time; }
+
+inline void setPlanePriority(int&, int) {}
+inline void setPlanePriority(PlaneMessage& plane, int priority) { plane.priority = static_cast<std::uint8_t>(priority); }
 
-std::istream& operator>>(std::istream& in, PlaneMessage& msg) {
-    in >> msg.plane_id;
-    return in;
-}
+inline void stampArrival(int&, double) {}
+inline void stampArrival(PlaneMessage& plane, double time) { plane.arrival_time = time; }
 
 #endif // PLANE_MESSAGE_HPP
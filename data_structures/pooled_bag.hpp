@@ -0,0 +1,63 @@
+/**
+ * Pooled Message Bag
+ *
+ * Small-buffer container used as the message bag of the model ports.
+ * The first N messages are stored inline in the bag itself, so the usual
+ * one-message-per-cycle case never touches the heap. Bigger bags spill
+ * into a vector whose storage is kept when the bag is cleared, so a port
+ * stops allocating once it has seen its largest bag.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef POOLED_BAG_HPP
+#define POOLED_BAG_HPP
+
+#include <cstddef>
+#include <vector>
+
+template <typename T, std::size_t N = 1>
+class PooledBag {
+    T local[N];          // inline storage for the common small bags
+    std::vector<T> spill;  // overflow storage, capacity kept across cycles
+    std::size_t count;
+    bool spilled;
+
+public:
+    PooledBag() : local(), spill(), count(0), spilled(false) {}
+
+    [[nodiscard]] const T* begin() const { return spilled ? spill.data() : local; }
+    [[nodiscard]] const T* end() const { return begin() + count; }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] std::size_t capacity() const { return spilled ? spill.capacity() : N; }
+
+    [[nodiscard]] const T& operator[](std::size_t i) const { return begin()[i]; }
+    [[nodiscard]] const T& front() const { return begin()[0]; }
+    [[nodiscard]] const T& back() const { return begin()[count - 1]; }
+
+    void push_back(const T& value) {
+        if (!spilled) {
+            if (count < N) {
+                local[count++] = value;
+                return;
+            }
+            // first time past the inline buffer, move everything to the spill
+            spill.assign(local, local + N);
+            spilled = true;
+        }
+        spill.push_back(value);
+        count++;
+    }
+
+    // vector clear keeps its capacity so the next big bag reuses it
+    void clear() {
+        spill.clear();
+        count = 0;
+        spilled = false;
+    }
+};
+
+#endif // POOLED_BAG_HPP
@@ -0,0 +1,90 @@
+/**
+ * Pooled Port
+ *
+ * Cadmium port whose message bag is a PooledBag instead of a std::vector.
+ * It derives from the regular _Port<T> so couplings from plain ports (for
+ * example the IEStream generator output) still pass the compatibility
+ * check, and it accepts messages from both pooled and plain ports.
+ *
+ * Plain ports cannot read a pooled bag, so a coupling from a pooled port
+ * to a plain one is refused by compatible() and addCoupling throws. All
+ * atomic and coupled models in this repo create their ports with
+ * addPooledInPort/addPooledOutPort.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef POOLED_PORT_HPP
+#define POOLED_PORT_HPP
+
+#include <cadmium/modeling/devs/component.hpp>
+#include <cadmium/modeling/devs/port.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "pooled_bag.hpp"
+
+template <typename T>
+class _PooledPort : public cadmium::_Port<T> {
+    PooledBag<T> pool;
+
+public:
+    explicit _PooledPort(std::string id) : cadmium::_Port<T>(std::move(id)), pool() {}
+
+    // hides _Port<T>::getBag, models reach this through PooledPort<T>
+    [[nodiscard]] const PooledBag<T>& getBag() const { return pool; }
+
+    void addMessage(const T message) { pool.push_back(message); }
+
+    void clear() override { pool.clear(); }
+    [[nodiscard]] bool empty() const override { return pool.empty(); }
+    [[nodiscard]] std::size_t size() const override { return pool.size(); }
+
+    [[nodiscard]] std::string logMessage(std::size_t i) const override {
+        std::stringstream ss;
+        ss << pool[i];
+        return ss.str();
+    }
+
+    // only a pooled port can receive from this one, a plain one would read its empty base bag
+    [[nodiscard]] bool compatible(const std::shared_ptr<const cadmium::PortInterface>& other) const override {
+        return dynamic_cast<const _PooledPort<T>*>(other.get()) != nullptr;
+    }
+
+    [[nodiscard]] std::shared_ptr<cadmium::PortInterface> newCompatiblePort(std::string portId) const override {
+        return std::make_shared<_PooledPort<T>>(std::move(portId));
+    }
+
+    void propagate(const std::shared_ptr<const cadmium::PortInterface>& portFrom) override {
+        // raw casts avoid touching the shared_ptr ref count on every hop
+        if (auto pooled = dynamic_cast<const _PooledPort<T>*>(portFrom.get())) {
+            for (const auto& msg : pooled->getBag()) pool.push_back(msg);
+            return;
+        }
+        auto typed = dynamic_cast<const cadmium::_Port<T>*>(portFrom.get());
+        if (typed == nullptr) {
+            throw cadmium::CadmiumModelException("invalid port type");
+        }
+        for (const auto& msg : typed->getBag()) pool.push_back(msg);
+    }
+};
+
+template <typename T>
+using PooledPort = std::shared_ptr<_PooledPort<T>>;
+
+template <typename T>
+PooledPort<T> addPooledInPort(cadmium::Component* component, std::string id) {
+    auto port = std::make_shared<_PooledPort<T>>(std::move(id));
+    component->addInPort(port);
+    return port;
+}
+
+template <typename T>
+PooledPort<T> addPooledOutPort(cadmium::Component* component, std::string id) {
+    auto port = std::make_shared<_PooledPort<T>>(std::move(id));
+    component->addOutPort(port);
+    return port;
+}
+
+#endif // POOLED_PORT_HPP
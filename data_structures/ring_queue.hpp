@@ -0,0 +1,80 @@
+/**
+ * Ring Queue
+ *
+ * FIFO with the same push/pop/front interface as std::queue, backed by
+ * a power-of-two ring buffer that only ever grows. std::queue sits on a
+ * std::deque, which frees and allocates a chunk every few hundred
+ * push/pop pairs even at constant size. The ring keeps its storage, so
+ * a model buffer at steady occupancy does not allocate at all.
+ * reserve() sizes the ring up front for buffers with a fixed bound.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef RING_QUEUE_HPP
+#define RING_QUEUE_HPP
+
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class RingQueue {
+    std::vector<T> buffer;  // size is always zero or a power of two
+    std::size_t head;
+    std::size_t count;
+
+    void grow() {
+        resize(buffer.empty() ? 8 : buffer.size() * 2);
+    }
+
+    void resize(std::size_t new_capacity) {
+        std::vector<T> bigger(new_capacity);
+        for (std::size_t i = 0; i < count; i++) {
+            bigger[i] = buffer[(head + i) & (buffer.size() - 1)];
+        }
+        buffer.swap(bigger);
+        head = 0;
+    }
+
+public:
+    RingQueue() : buffer(), head(0), count(0) {}
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] std::size_t capacity() const { return buffer.size(); }
+
+    [[nodiscard]] T& front() { return buffer[head]; }
+    [[nodiscard]] const T& front() const { return buffer[head]; }
+    [[nodiscard]] T& back() { return buffer[(head + count - 1) & (buffer.size() - 1)]; }
+    [[nodiscard]] const T& back() const { return buffer[(head + count - 1) & (buffer.size() - 1)]; }
+
+    // i-th element from the front
+    [[nodiscard]] const T& operator[](std::size_t i) const { return buffer[(head + i) & (buffer.size() - 1)]; }
+
+    void push(const T& value) {
+        if (count == buffer.size()) grow();
+        buffer[(head + count) & (buffer.size() - 1)] = value;
+        count++;
+    }
+
+    void pop() {
+        head = (head + 1) & (buffer.size() - 1);
+        count--;
+    }
+
+    // make room for at least n elements, rounded up to a power of two
+    void reserve(std::size_t n) {
+        std::size_t new_capacity = buffer.empty() ? 8 : buffer.size();
+        while (new_capacity < n) new_capacity *= 2;
+        if (new_capacity != buffer.size()) resize(new_capacity);
+    }
+
+    // drop the contents but keep the storage
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+};
+
+#endif // RING_QUEUE_HPP
@@ -0,0 +1,232 @@
+/**
+ * Timer Wheel
+ *
+ * Hierarchical timing wheel for values that expire at integer ticks.
+ * Four levels of 256 slots each cover the 2^32 tick block the current
+ * tick is in; level L holds the entries whose expiry first differs from
+ * the current tick in byte L, and a far list holds anything in a later
+ * block. Scheduling is O(1), and each entry is moved down at most three
+ * times before it expires, so release is O(1) amortized however many
+ * entries are parked.
+ *
+ * A 256-bit occupancy map per level finds the next busy slot without
+ * walking empty ones. Entries live in one pooled node array linked by
+ * index, so a wheel holding millions of values makes no allocation per
+ * schedule once the pool has grown. Entries with the same expiry come
+ * out in the order they were scheduled.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template <typename T>
+class TimerWheel {
+public:
+    using Tick = std::uint64_t;
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOTS = 256;
+    static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Node {
+        Tick expiry;
+        std::uint32_t next;
+        T value;
+    };
+
+    struct Slot {
+        std::uint32_t head = NIL;
+        std::uint32_t tail = NIL;
+    };
+
+    std::vector<Node> nodes;
+    std::uint32_t free_head;
+    Slot slots[LEVELS][SLOTS];
+    Slot far;  // expiries beyond the current 2^32 tick block
+    std::uint64_t occupied[LEVELS][SLOTS / 64];
+    Tick current;
+    std::size_t count;
+    mutable Tick next_cache;
+    mutable bool next_valid;
+
+    static int byteAt(Tick t, int level) { return static_cast<int>((t >> (8 * level)) & 0xFF); }
+
+    // level is the highest byte where the expiry differs from now, LEVELS for the far list
+    int levelFor(Tick expiry) const {
+        Tick diff = expiry ^ current;
+        int level = 0;
+        while (level < LEVELS && (diff >> (8 * (level + 1))) != 0) level++;
+        return level;
+    }
+
+    static void append(Slot& s, std::vector<Node>& nodes, std::uint32_t index) {
+        nodes[index].next = NIL;
+        if (s.tail == NIL) {
+            s.head = index;
+        } else {
+            nodes[s.tail].next = index;
+        }
+        s.tail = index;
+    }
+
+    void link(std::uint32_t index) {
+        Tick expiry = nodes[index].expiry;
+        int level = levelFor(expiry);
+        if (level == LEVELS) {
+            append(far, nodes, index);
+            return;
+        }
+        int slot = byteAt(expiry, level);
+        occupied[level][slot >> 6] |= std::uint64_t(1) << (slot & 63);
+        append(slots[level][slot], nodes, index);
+    }
+
+    // relink every entry of a list relative to the current tick
+    void relink(Slot& s) {
+        std::uint32_t index = s.head;
+        s.head = NIL;
+        s.tail = NIL;
+        while (index != NIL) {
+            std::uint32_t next = nodes[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+    static Tick minExpiry(const Slot& s, const std::vector<Node>& nodes) {
+        Tick best = ~Tick(0);
+        for (std::uint32_t i = s.head; i != NIL; i = nodes[i].next) {
+            if (nodes[i].expiry < best) best = nodes[i].expiry;
+        }
+        return best;
+    }
+
+    // first occupied slot at or after from, -1 if none
+    int firstOccupied(int level, int from) const {
+        for (int word = from >> 6; word < SLOTS / 64; word++) {
+            std::uint64_t bits = occupied[level][word];
+            if (word == (from >> 6)) bits &= ~std::uint64_t(0) << (from & 63);
+            if (bits != 0) return (word << 6) + __builtin_ctzll(bits);
+        }
+        return -1;
+    }
+
+    // move every entry of a higher level slot down relative to the new tick
+    void cascade(int level, int slot) {
+        occupied[level][slot >> 6] &= ~(std::uint64_t(1) << (slot & 63));
+        relink(slots[level][slot]);
+    }
+
+public:
+    TimerWheel() : nodes(), free_head(NIL), slots(), far(), occupied(), current(0), count(0),
+                   next_cache(0), next_valid(false) {}
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] Tick now() const { return current; }
+
+    // schedule a value, past ticks expire at the current tick
+    void schedule(Tick expiry, const T& value) {
+        if (expiry < current) expiry = current;
+
+        std::uint32_t index;
+        if (free_head != NIL) {
+            index = free_head;
+            free_head = nodes[index].next;
+            nodes[index].expiry = expiry;
+            nodes[index].value = value;
+        } else {
+            index = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back(Node{expiry, NIL, value});
+        }
+        link(index);
+        count++;
+        if (next_valid && expiry < next_cache) next_cache = expiry;
+    }
+
+    // earliest expiry, the wheel must not be empty
+    [[nodiscard]] Tick nextExpiry() const {
+        if (next_valid) return next_cache;
+        int slot = firstOccupied(0, byteAt(current, 0));
+        if (slot >= 0) {
+            next_cache = (current & ~Tick(0xFF)) | static_cast<Tick>(slot);
+        } else {
+            // lowest busy higher level slot, scan it for the exact minimum
+            next_cache = ~Tick(0);
+            int level = 1;
+            for (; level < LEVELS; level++) {
+                slot = firstOccupied(level, byteAt(current, level));
+                if (slot < 0) continue;
+                next_cache = minExpiry(slots[level][slot], nodes);
+                break;
+            }
+            if (level == LEVELS) next_cache = minExpiry(far, nodes);
+        }
+        next_valid = true;
+        return next_cache;
+    }
+
+    // move to tick, which must not be past nextExpiry()
+    void advance(Tick tick) {
+        if (tick <= current) return;
+        Tick old = current;
+        current = tick;
+        // only the slot the new tick falls in can hold anything, and only
+        // for levels whose byte (or a higher one) changed
+        if ((old >> (8 * LEVELS)) != (tick >> (8 * LEVELS))) relink(far);
+        for (int level = LEVELS - 1; level > 0; level--) {
+            if ((old >> (8 * level)) != (tick >> (8 * level))) {
+                cascade(level, byteAt(tick, level));
+            }
+        }
+    }
+
+    // hand every value due at the current tick to fn, in schedule order
+    template <typename F>
+    std::size_t expire(F&& fn) {
+        int slot = byteAt(current, 0);
+        Slot& s = slots[0][slot];
+        std::size_t expired = 0;
+        std::uint32_t index = s.head;
+        s.head = NIL;
+        s.tail = NIL;
+        occupied[0][slot >> 6] &= ~(std::uint64_t(1) << (slot & 63));
+        while (index != NIL) {
+            std::uint32_t next = nodes[index].next;
+            fn(nodes[index].value);
+            nodes[index].next = free_head;
+            free_head = index;
+            index = next;
+            expired++;
+        }
+        count -= expired;
+        next_valid = false;
+        return expired;
+    }
+
+    // drop every entry but keep the node pool
+    void clear() {
+        nodes.clear();
+        free_head = NIL;
+        for (auto& level : slots) {
+            for (auto& s : level) s = Slot();
+        }
+        far = Slot();
+        for (auto& level : occupied) {
+            for (auto& word : level) word = 0;
+        }
+        current = 0;
+        count = 0;
+        next_valid = false;
+    }
+};
+
+#endif // TIMER_WHEEL_HPP
@@ -0,0 +1,164 @@
+/**
+ * Delta State Codec
+ *
+ * Encoding shared by the DeltaLogger and trace_expand. A delta log has
+ * the CSV logger's columns (time;model_id;model_name;port_name;data) and
+ * port messages are written unchanged. State records come in two kinds:
+ *
+ *   keyframe   the full state, exactly as the CSV logger writes it
+ *                {phase=ACTIVE, size=2, sigma=0}
+ *   delta      '~' and only the fields that changed since the model's
+ *              previous state record, in state order
+ *                ~{size=3}
+ *              ~{} means the state did not change at all
+ *
+ * A model's state is written as a keyframe on its first record, every
+ * keyframe-th record after that, and whenever it is not in the
+ * {key=value, ...} form or its keys differ from the previous record.
+ * A reader that starts anywhere in the log can therefore rebuild every
+ * model's state from that model's next keyframe on. A full state that
+ * itself starts with '~' is written with a second '~' in front.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef DELTA_CODEC_HPP
+#define DELTA_CODEC_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+constexpr char DELTA_MARKER = '~';
+
+using DeltaField = std::pair<std::string_view, std::string_view>;
+
+// {a=1, b={x, y}} to (a,1) (b,{x, y}), false if the state is not in that form
+inline bool splitDeltaState(std::string_view state, std::vector<DeltaField>& fields) {
+    fields.clear();
+    if (state.size() < 2 || state.front() != '{' || state.back() != '}') return false;
+    std::string_view body = state.substr(1, state.size() - 2);
+    if (body.empty()) return true;
+    int depth = 0;
+    std::size_t start = 0;
+    std::size_t equals = std::string_view::npos;
+    for (std::size_t i = 0; i <= body.size(); i++) {
+        char c = (i < body.size()) ? body[i] : ',';
+        if (c == '{' || c == '[' || c == '(') depth++;
+        else if (c == '}' || c == ']' || c == ')') depth--;
+        else if (depth == 0 && c == '=' && equals == std::string_view::npos) equals = i;
+        else if (depth == 0 && c == ',' && (i == body.size() || (i + 1 < body.size() && body[i + 1] == ' '))) {
+            if (equals == std::string_view::npos) return false;
+            fields.emplace_back(body.substr(start, equals - start), body.substr(equals + 1, i - equals - 1));
+            start = i + 2;
+            equals = std::string_view::npos;
+        }
+    }
+    return depth == 0;
+}
+
+// keyframe-th record of a model is written in full, 1 writes every state in full
+class DeltaEncoder {
+    struct Track {
+        std::string state;                  // last state written, fields point into it
+        std::vector<DeltaField> fields;
+        std::uint64_t since_keyframe = 0;
+        bool seen = false;
+        bool structured = false;
+    };
+
+    std::uint64_t keyframe;
+    std::unordered_map<long, Track> tracks;
+    std::vector<DeltaField> scratch;
+
+public:
+    explicit DeltaEncoder(std::uint64_t keyframe) : keyframe(keyframe == 0 ? 1 : keyframe), tracks(), scratch() {}
+
+    void reset() { tracks.clear(); }
+
+    // the data field to log for this state in out, true for a keyframe
+    bool encode(long modelId, const std::string& state, std::string& out) {
+        Track& track = tracks[modelId];
+        bool structured = splitDeltaState(state, scratch);
+        bool full = !track.seen || !structured || !track.structured || track.fields.size() != scratch.size() ||
+               ++track.since_keyframe >= keyframe;
+        for (std::size_t i = 0; !full && i < scratch.size(); i++) full = scratch[i].first != track.fields[i].first;
+
+        out.clear();
+        if (full) {
+            if (!state.empty() && state.front() == DELTA_MARKER) out += DELTA_MARKER;
+            out += state;
+            track.since_keyframe = 0;
+        } else {
+            out += DELTA_MARKER;
+            out += '{';
+            bool first = true;
+            for (std::size_t i = 0; i < scratch.size(); i++) {
+                if (scratch[i].second == track.fields[i].second) continue;
+                if (!first) out += ", ";
+                out.append(scratch[i].first).append("=").append(scratch[i].second);
+                first = false;
+            }
+            out += '}';
+        }
+        track.state = state;
+        track.seen = true;
+        track.structured = splitDeltaState(track.state, track.fields);
+        return full;
+    }
+};
+
+class DeltaDecoder {
+    struct Track {
+        std::vector<std::pair<std::string, std::string>> fields;
+        bool known = false;       // a keyframe has been seen
+        bool structured = false;  // in {key=value, ...} form, deltas can apply
+    };
+
+    std::unordered_map<long, Track> tracks;
+    std::vector<DeltaField> scratch;
+
+    static void join(const Track& track, std::string& out) {
+        out = "{";
+        for (std::size_t i = 0; i < track.fields.size(); i++) {
+            if (i > 0) out += ", ";
+            out.append(track.fields[i].first).append("=").append(track.fields[i].second);
+        }
+        out += '}';
+    }
+
+public:
+    // the full state for this data field, false for a delta with no keyframe before it
+    bool decode(long modelId, std::string_view data, std::string& out) {
+        Track& track = tracks[modelId];
+        bool delta = !data.empty() && data.front() == DELTA_MARKER;
+        if (delta && data.size() > 1 && data[1] == DELTA_MARKER) {
+            data.remove_prefix(1);
+            delta = false;
+        }
+        if (!delta) {
+            out.assign(data);
+            track.known = true;
+            track.structured = splitDeltaState(data, scratch);
+            track.fields.clear();
+            for (const auto& [key, value] : scratch) track.fields.emplace_back(key, value);
+            return true;
+        }
+        if (!track.known || !track.structured || !splitDeltaState(data.substr(1), scratch)) return false;
+        // changed fields come in state order, one pass over the model's fields
+        std::size_t at = 0;
+        for (const auto& [key, value] : scratch) {
+            while (at < track.fields.size() && track.fields[at].first != key) at++;
+            if (at == track.fields.size()) return false;
+            track.fields[at].second.assign(value);
+        }
+        join(track, out);
+        return true;
+    }
+};
+
+#endif // DELTA_CODEC_HPP
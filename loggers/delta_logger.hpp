@@ -0,0 +1,66 @@
+/**
+ * Delta Logger
+ *
+ * Cadmium logger that writes the CSV logger's file, except that a
+ * model's state record only carries the fields that changed since that
+ * model's previous record (encoding in delta_codec.hpp). Every
+ * keyframe-th state of a model is written in full, so the log can be
+ * decoded from any point; TRACE_EXPAND turns it back into the CSV
+ * logger's output byte for byte.
+ *
+ * Records go through a large stream buffer and are not flushed line by
+ * line, unlike the CSV logger.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef DELTA_LOGGER_HPP
+#define DELTA_LOGGER_HPP
+
+#include <cadmium/simulation/logger/logger.hpp>
+#include "delta_codec.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class DeltaLogger : public cadmium::Logger {
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+    std::string filepath;
+    std::string sep;
+    std::vector<char> buffer;
+    std::ofstream file;
+    DeltaEncoder encoder;
+    std::string encoded;
+
+public:
+    DeltaLogger(std::string filepath, std::string sep, std::uint64_t keyframe)
+        : cadmium::Logger(), filepath(std::move(filepath)), sep(std::move(sep)), buffer(), file(),
+          encoder(keyframe), encoded() {}
+
+    void start() override {
+        buffer.resize(BUFFER_SIZE);
+        file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.open(filepath);
+        if (!file) throw std::runtime_error("DeltaLogger: cannot write " + filepath);
+        file << "sep=" << sep << '\n';
+        file << "time" << sep << "model_id" << sep << "model_name" << sep << "port_name" << sep << "data" << '\n';
+        encoder.reset();
+    }
+
+    void stop() override { file.close(); }
+
+    void logOutput(double time, long modelId, const std::string& modelName, const std::string& portName, const std::string& output) override {
+        file << time << sep << modelId << sep << modelName << sep << portName << sep << output << '\n';
+    }
+
+    void logState(double time, long modelId, const std::string& modelName, const std::string& state) override {
+        encoder.encode(modelId, state, encoded);
+        file << time << sep << modelId << sep << modelName << sep << sep << encoded << '\n';
+    }
+};
+
+#endif // DELTA_LOGGER_HPP
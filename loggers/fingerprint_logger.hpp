@@ -0,0 +1,165 @@
+/**
+ * Trace Fingerprint Logger
+ *
+ * Cadmium logger that folds every state change and port message into a
+ * rolling 64-bit FNV-1a hash instead of writing them out. Two runs with
+ * the same fingerprint produced the same trace (time, model, port, data
+ * and the state after each transition, in order), so a regression check
+ * is one integer compare instead of a diff over the CSV files.
+ *
+ * Every `interval` records the logger also saves a checkpoint (record
+ * count, time, hash so far). The hash is rolling, so once two runs
+ * diverge every later checkpoint differs too; firstDivergence() binary
+ * searches two checkpoint lists for the window holding the first
+ * difference. Rerun both sides with the CSV logger up to that window to
+ * see it.
+ *
+ * Checkpoint files hold one "records time hash" line per checkpoint,
+ * hash in hex, and the final fingerprint as the last line.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef FINGERPRINT_LOGGER_HPP
+#define FINGERPRINT_LOGGER_HPP
+
+#include <cadmium/simulation/logger/logger.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+struct FingerprintCheckpoint {
+    std::uint64_t records;  // records folded in so far
+    double time;            // simulation time of the last one
+    std::uint64_t hash;
+
+    bool operator==(const FingerprintCheckpoint& other) const {
+        return records == other.records && hash == other.hash;
+    }
+};
+
+// result of a run, filled in by FingerprintLogger
+struct TraceFingerprint {
+    std::uint64_t interval = 0;  // records between checkpoints, 0 for none
+    std::uint64_t records = 0;
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    double time = 0;
+    std::vector<FingerprintCheckpoint> checkpoints;
+
+    void reset() {
+        records = 0;
+        hash = FNV_OFFSET_BASIS;
+        time = 0;
+        checkpoints.clear();
+    }
+
+    [[nodiscard]] FingerprintCheckpoint final() const {
+        return FingerprintCheckpoint{records, time, hash};
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& out, const FingerprintCheckpoint& c) {
+    std::ios_base::fmtflags flags = out.flags();
+    char fill = out.fill('0');
+    out << c.records << ' ' << c.time << ' ' << std::hex << std::setw(16) << c.hash;
+    out.flags(flags);
+    out.fill(fill);
+    return out;
+}
+
+inline std::istream& operator>>(std::istream& in, FingerprintCheckpoint& c) {
+    std::ios_base::fmtflags flags = in.flags();
+    in >> c.records >> c.time >> std::hex >> c.hash;
+    in.flags(flags);
+    return in;
+}
+
+// checkpoints then the final fingerprint, one per line
+inline void writeCheckpoints(std::ostream& out, const TraceFingerprint& fingerprint) {
+    for (const auto& c : fingerprint.checkpoints) out << c << '\n';
+    out << fingerprint.final() << '\n';
+}
+
+inline std::vector<FingerprintCheckpoint> readCheckpoints(std::istream& in) {
+    std::vector<FingerprintCheckpoint> checkpoints;
+    FingerprintCheckpoint c{};
+    while (in >> c) checkpoints.push_back(c);
+    return checkpoints;
+}
+
+// index of the first checkpoint that differs, a.size() or b.size() (the shorter) if none does
+inline std::size_t firstDivergence(const std::vector<FingerprintCheckpoint>& a,
+                                   const std::vector<FingerprintCheckpoint>& b) {
+    std::size_t n = std::min(a.size(), b.size());
+    std::size_t lo = 0, hi = n;
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (a[mid] == b[mid]) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+class FingerprintLogger : public cadmium::Logger {
+    std::shared_ptr<TraceFingerprint> result;
+
+    void fold(const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t h = result->hash;
+        for (std::size_t i = 0; i < size; i++) {
+            h ^= bytes[i];
+            h *= FNV_PRIME;
+        }
+        result->hash = h;
+    }
+
+    // strings end with a 0 byte so ("ab", "c") and ("a", "bc") hash apart
+    void fold(const std::string& text) {
+        fold(text.data(), text.size() + 1);
+    }
+
+    void record(char kind, double time, const std::string& modelName,
+                const std::string& portName, const std::string& data) {
+        fold(&kind, 1);
+        fold(&time, sizeof(time));
+        fold(modelName);
+        fold(portName);
+        fold(data);
+        result->time = time;
+        result->records++;
+        if (result->interval > 0 && result->records % result->interval == 0) {
+            result->checkpoints.push_back(result->final());
+        }
+    }
+
+public:
+    // the fingerprint lands in result, which the caller keeps after the coordinator is gone
+    explicit FingerprintLogger(std::shared_ptr<TraceFingerprint> result) : cadmium::Logger(), result(std::move(result)) {}
+
+    void start() override {
+        result->reset();
+    }
+
+    void stop() override {}
+
+    // model ids depend on construction order, so only names go into the hash
+    void logOutput(double time, long modelId, const std::string& modelName, const std::string& portName, const std::string& output) override {
+        record('o', time, modelName, portName, output);
+    }
+
+    void logState(double time, long modelId, const std::string& modelName, const std::string& state) override {
+        record('s', time, modelName, std::string(), state);
+    }
+};
+
+#endif // FINGERPRINT_LOGGER_HPP
@@ -0,0 +1,117 @@
+/**
+ * Metrics Logger
+ *
+ * Cadmium logger that passes every record on to another logger and, on
+ * the way, keeps the AirportMetrics counters (simulation/metrics_publisher.hpp)
+ * up to date. The counters come from the records the simulation logs
+ * anyway:
+ *   - every state record is one model transition; its time is the
+ *     simulated time
+ *   - landing_queue / takeoff_queue states give the queue depths
+ *   - ControlTower states give the phase and the pendingL / pendingT counts
+ *   - ControlTower land messages count planes cleared to land, Runway
+ *     takeoff_exit messages count planes that left
+ *
+ * The role of a model is looked up once per model id, so a record of
+ * any other model costs one vector lookup and a few relaxed stores on
+ * top of the wrapped logger.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef METRICS_LOGGER_HPP
+#define METRICS_LOGGER_HPP
+
+#include <cadmium/simulation/logger/logger.hpp>
+#include "../simulation/metrics_publisher.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MetricsLogger : public cadmium::Logger {
+    enum class Role : unsigned char { UNSEEN, OTHER, LANDING_QUEUE, TAKEOFF_QUEUE, TOWER, RUNWAY };
+
+    std::shared_ptr<cadmium::Logger> inner;
+    std::shared_ptr<AirportMetrics> metrics;
+    std::vector<Role> roles;  // by model id
+
+    Role role(long modelId, const std::string& modelName) {
+        if (modelId < 0) return Role::OTHER;
+        auto id = static_cast<std::size_t>(modelId);
+        if (id >= roles.size()) roles.resize(id + 1, Role::UNSEEN);
+        if (roles[id] == Role::UNSEEN) {
+            if (modelName == "landing_queue") roles[id] = Role::LANDING_QUEUE;
+            else if (modelName == "takeoff_queue") roles[id] = Role::TAKEOFF_QUEUE;
+            else if (modelName == "ControlTower") roles[id] = Role::TOWER;
+            else if (modelName == "Runway") roles[id] = Role::RUNWAY;
+            else roles[id] = Role::OTHER;
+        }
+        return roles[id];
+    }
+
+    // only the simulation thread writes, so a plain load and store is enough
+    template <typename T>
+    static void bump(std::atomic<T>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // integer after "key=" in a {key=value, ...} state, or 0
+    static std::int64_t field(const std::string& state, const char* key) {
+        std::size_t at = state.find(key);
+        return at == std::string::npos ? 0 : std::strtoll(state.c_str() + at + std::strlen(key), nullptr, 10);
+    }
+
+    static int towerPhase(const std::string& state) {
+        std::size_t at = state.find("phase=");
+        if (at == std::string::npos) return 0;
+        at += 6;
+        std::size_t length = state.find_first_of(",}", at) - at;
+        for (int i = 1; i < static_cast<int>(std::size(METRICS_TOWER_PHASES)); i++) {
+            if (state.compare(at, length, METRICS_TOWER_PHASES[i]) == 0) return i;
+        }
+        return 0;
+    }
+
+public:
+    MetricsLogger(std::shared_ptr<cadmium::Logger> inner, std::shared_ptr<AirportMetrics> metrics)
+        : cadmium::Logger(), inner(std::move(inner)), metrics(std::move(metrics)), roles() {}
+
+    void start() override { inner->start(); }
+
+    void stop() override { inner->stop(); }
+
+    void logOutput(double time, long modelId, const std::string& modelName, const std::string& portName, const std::string& output) override {
+        inner->logOutput(time, modelId, modelName, portName, output);
+        Role r = role(modelId, modelName);
+        if (r == Role::TOWER && portName == "land") bump(metrics->landed);
+        else if (r == Role::RUNWAY && portName == "takeoff_exit") bump(metrics->departed);
+    }
+
+    void logState(double time, long modelId, const std::string& modelName, const std::string& state) override {
+        inner->logState(time, modelId, modelName, state);
+        metrics->sim_time.store(time, std::memory_order_relaxed);
+        bump(metrics->events);
+        switch (role(modelId, modelName)) {
+            case Role::LANDING_QUEUE:
+                metrics->landing_queue.store(field(state, "size="), std::memory_order_relaxed);
+                break;
+            case Role::TAKEOFF_QUEUE:
+                metrics->takeoff_queue.store(field(state, "size="), std::memory_order_relaxed);
+                break;
+            case Role::TOWER:
+                metrics->tower_phase.store(towerPhase(state), std::memory_order_relaxed);
+                metrics->pending_landings.store(field(state, "pendingL="), std::memory_order_relaxed);
+                metrics->pending_takeoffs.store(field(state, "pendingT="), std::memory_order_relaxed);
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+#endif // METRICS_LOGGER_HPP
@@ -0,0 +1,128 @@
+/**
+ * Plane Timing Logger
+ *
+ * Cadmium logger that follows each plane through the airport by its port
+ * messages and sums the delays the estimator predicts, instead of writing
+ * a trace. Per plane ID (in order, so an ID may come back):
+ *   Generator.out          arrival
+ *   ControlTower.land      cleared to land      -> landing wait
+ *   Merger.out             out of the hangar (Hangar.hangar_exit when it
+ *                          is the aggregate model)
+ *   ControlTower.takeoff   cleared to take off  -> takeoff wait
+ *   Runway.takeoff_exit    gone                 -> time in system
+ * Planes still inside when the run stops are not counted.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef PLANE_TIMING_LOGGER_HPP
+#define PLANE_TIMING_LOGGER_HPP
+
+#include <cadmium/simulation/logger/logger.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// result of a run, filled in by PlaneTimingLogger
+struct PlaneTimings {
+    std::uint64_t arrivals = 0;
+    std::uint64_t departures = 0;        // planes followed from arrival to takeoff_exit
+    std::uint64_t runway_operations = 0;
+    double first_arrival = std::numeric_limits<double>::infinity();
+    double last_arrival = 0;
+    double last_departure = 0;
+    double landing_wait = 0;             // sums over departed planes, seconds
+    double takeoff_wait = 0;
+    double time_in_system = 0;
+
+    // arrivals per hour over the arrival span, 0 with fewer than two arrivals
+    [[nodiscard]] double arrivalsPerHour() const {
+        return (arrivals > 1 && last_arrival > first_arrival) ? arrivals * 3600.0 / (last_arrival - first_arrival) : 0.0;
+    }
+};
+
+class PlaneTimingLogger : public cadmium::Logger {
+    enum Stage { ARRIVED, LANDING, PARKED_OUT, TAKING_OFF };
+
+    struct Plane {
+        Stage stage;
+        double arrival;
+        double landing_wait;
+        double hangar_exit;
+        double takeoff_wait;
+    };
+
+    std::shared_ptr<PlaneTimings> timings;
+    std::unordered_map<long, std::deque<Plane>> planes;  // by plane ID, oldest first
+
+    // the oldest plane with this ID at this stage
+    Plane* find(long id, Stage stage) {
+        auto it = planes.find(id);
+        if (it == planes.end()) return nullptr;
+        for (auto& plane : it->second) {
+            if (plane.stage == stage) return &plane;
+        }
+        return nullptr;
+    }
+
+public:
+    explicit PlaneTimingLogger(std::shared_ptr<PlaneTimings> timings)
+        : cadmium::Logger(), timings(std::move(timings)), planes() {}
+
+    void start() override {
+        *timings = PlaneTimings();
+        planes.clear();
+    }
+
+    void stop() override {}
+
+    void logOutput(double time, long modelId, const std::string& modelName, const std::string& portName, const std::string& output) override {
+        long id = std::strtol(output.c_str(), nullptr, 10);
+        if (modelName == "Generator" && portName == "out") {
+            planes[id].push_back(Plane{ARRIVED, time, 0, 0, 0});
+            timings->arrivals++;
+            timings->first_arrival = std::min(timings->first_arrival, time);
+            timings->last_arrival = time;
+        } else if (modelName == "ControlTower" && portName == "land") {
+            timings->runway_operations++;
+            if (Plane* plane = find(id, ARRIVED)) {
+                plane->landing_wait = time - plane->arrival;
+                plane->stage = LANDING;
+            }
+        } else if ((modelName == "Merger" && portName == "out") || (modelName == "Hangar" && portName == "hangar_exit")) {
+            if (Plane* plane = find(id, LANDING)) {
+                plane->hangar_exit = time;
+                plane->stage = PARKED_OUT;
+            }
+        } else if (modelName == "ControlTower" && portName == "takeoff") {
+            timings->runway_operations++;
+            if (Plane* plane = find(id, PARKED_OUT)) {
+                plane->takeoff_wait = time - plane->hangar_exit;
+                plane->stage = TAKING_OFF;
+            }
+        } else if (modelName == "Runway" && portName == "takeoff_exit") {
+            auto it = planes.find(id);
+            if (it == planes.end()) return;
+            for (auto plane = it->second.begin(); plane != it->second.end(); ++plane) {
+                if (plane->stage != TAKING_OFF) continue;
+                timings->departures++;
+                timings->landing_wait += plane->landing_wait;
+                timings->takeoff_wait += plane->takeoff_wait;
+                timings->time_in_system += time - plane->arrival;
+                timings->last_departure = time;
+                it->second.erase(plane);
+                break;
+            }
+        }
+    }
+
+    void logState(double time, long modelId, const std::string& modelName, const std::string& state) override {}
+};
+
+#endif // PLANE_TIMING_LOGGER_HPP
@@ -0,0 +1,218 @@
+/**
+ * Segmented Log Format
+ *
+ * Layout of the compressed, rotated logs the SegmentLogger writes and
+ * TRACE_UNPACK reads. A run is a directory holding one manifest and any
+ * number of segment files:
+ *
+ *   manifest.txt   one line per finished segment, appended as soon as the
+ *                  segment is on disk, and an end line once the run stops
+ *       segment <index> <file> <first_time> <last_time> <records>
+ *               <raw_bytes> <stored_bytes> <fnv1a of the raw bytes, hex>
+ *       end <segments> <records>
+ *   NNNNN.seg      SEGMENT_MAGIC ("AIRSEG01"), then blocks of
+ *       u32 raw_len     bytes of CSV text in the block, at most SEGMENT_BLOCK
+ *       u32 stored_len  bytes that follow; equal to raw_len for a block
+ *                       stored uncompressed
+ *       stored_len bytes of LZ data (format below)
+ *
+ * Decompressed and concatenated in index order, the segments are the CSV
+ * logger's file byte for byte (segment 0 starts with the sep= and column
+ * lines). Every segment holds whole records, so segments can be read,
+ * decompressed or analysed independently and in parallel, and a reader
+ * can start on the segments listed while the run is still going.
+ *
+ * LZ block format (LZ4 style, 64 KB window): a sequence of
+ *   token          high nibble literal count, low nibble match length - 4,
+ *                  a nibble of 15 continues in bytes of 255 plus a last one
+ *   literals
+ *   u16 offset     back-reference distance, little endian
+ * The last sequence has literals only and ends the block.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef SEGMENT_FORMAT_HPP
+#define SEGMENT_FORMAT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <vector>
+
+constexpr char SEGMENT_MAGIC[8] = {'A', 'I', 'R', 'S', 'E', 'G', '0', '1'};
+constexpr std::size_t SEGMENT_BLOCK = 1 << 20;
+constexpr const char* SEGMENT_MANIFEST = "manifest.txt";
+
+// one manifest line
+struct SegmentInfo {
+    std::uint64_t index = 0;
+    std::string file;
+    double first_time = 0;
+    double last_time = 0;
+    std::uint64_t records = 0;
+    std::uint64_t raw_bytes = 0;
+    std::uint64_t stored_bytes = 0;
+    std::uint64_t checksum = 0;
+};
+
+struct SegmentManifest {
+    std::vector<SegmentInfo> segments;
+    bool complete = false;  // the end line is there, the run has stopped
+    std::uint64_t records = 0;
+};
+
+inline std::uint64_t segmentChecksum(const char* data, std::size_t size) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;  // FNV-1a, as the trace fingerprint
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// reads the lines written so far, a half-written last line is ignored
+inline SegmentManifest readManifest(std::istream& in) {
+    SegmentManifest manifest;
+    std::string kind;
+    while (in >> kind) {
+        if (kind == "segment") {
+            SegmentInfo info;
+            if (!(in >> info.index >> info.file >> info.first_time >> info.last_time >> info.records >>
+                  info.raw_bytes >> info.stored_bytes >> std::hex >> info.checksum >> std::dec)) break;
+            manifest.segments.push_back(info);
+        } else if (kind == "end") {
+            std::uint64_t segments;
+            if (in >> segments >> manifest.records) manifest.complete = true;
+            break;
+        } else {
+            break;
+        }
+    }
+    if (!manifest.complete) {
+        for (const auto& info : manifest.segments) manifest.records += info.records;
+    }
+    return manifest;
+}
+
+// LZ compressor, clears its hash table for every block so each block decodes on its own
+class LzCompressor {
+    static constexpr int HASH_BITS = 14;
+    static constexpr std::size_t MIN_MATCH = 4;
+    static constexpr std::size_t MAX_OFFSET = 65535;
+
+    std::vector<std::uint32_t> table;  // position + 1 of the last 4 bytes with this hash, 0 for none
+
+    static std::uint32_t load32(const char* p) {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static std::uint32_t hash(std::uint32_t v) { return (v * 2654435761U) >> (32 - HASH_BITS); }
+
+    static void putLength(std::string& out, std::size_t length) {
+        for (; length >= 255; length -= 255) out += static_cast<char>(255);
+        out += static_cast<char>(length);
+    }
+
+    static void putSequence(std::string& out, const char* literals, std::size_t literal_count,
+                            std::size_t offset, std::size_t match) {
+        std::size_t match_code = match - MIN_MATCH;
+        out += static_cast<char>((std::min<std::size_t>(literal_count, 15) << 4) | std::min<std::size_t>(match_code, 15));
+        if (literal_count >= 15) putLength(out, literal_count - 15);
+        out.append(literals, literal_count);
+        out += static_cast<char>(offset & 0xff);
+        out += static_cast<char>(offset >> 8);
+        if (match_code >= 15) putLength(out, match_code - 15);
+    }
+
+    // bytes equal at a and b, b ahead of a, up to end
+    static std::size_t matchLength(const char* a, const char* b, const char* end) {
+        const char* start = b;
+        while (b + 8 <= end) {
+            std::uint64_t x, y;
+            std::memcpy(&x, a, 8);
+            std::memcpy(&y, b, 8);
+            if (x != y) return static_cast<std::size_t>(b - start) + (__builtin_ctzll(x ^ y) >> 3);
+            a += 8;
+            b += 8;
+        }
+        while (b < end && *a == *b) a++, b++;
+        return static_cast<std::size_t>(b - start);
+    }
+
+public:
+    LzCompressor() : table(std::size_t(1) << HASH_BITS) {}
+
+    // appends the compressed form of src to out
+    void compress(const char* src, std::size_t size, std::string& out) {
+        std::fill(table.begin(), table.end(), 0);
+        std::size_t anchor = 0;
+        std::size_t i = 0;
+        while (i + MIN_MATCH <= size) {
+            std::uint32_t h = hash(load32(src + i));
+            std::size_t candidate = table[h];
+            table[h] = static_cast<std::uint32_t>(i + 1);
+            if (candidate == 0 || i - (candidate - 1) > MAX_OFFSET || load32(src + candidate - 1) != load32(src + i)) {
+                i += 1 + ((i - anchor) >> 6);  // step faster through data that does not compress
+                continue;
+            }
+            candidate--;
+            std::size_t match = MIN_MATCH + matchLength(src + candidate + MIN_MATCH, src + i + MIN_MATCH, src + size);
+            putSequence(out, src + anchor, i - anchor, i - candidate, match);
+            i += match;
+            anchor = i;
+            if (i >= 2 && i + 2 <= size) table[hash(load32(src + i - 2))] = static_cast<std::uint32_t>(i - 1);
+        }
+        std::size_t literal_count = size - anchor;
+        out += static_cast<char>(std::min<std::size_t>(literal_count, 15) << 4);
+        if (literal_count >= 15) putLength(out, literal_count - 15);
+        out.append(src + anchor, literal_count);
+    }
+};
+
+// false if the block is corrupt or does not decode to exactly raw_len bytes
+inline bool lzDecompress(const char* src, std::size_t size, char* dst, std::size_t raw_len) {
+    const auto* in = reinterpret_cast<const unsigned char*>(src);
+    const unsigned char* end = in + size;
+    std::size_t out = 0;
+    auto length = [&](std::size_t nibble, std::size_t& value) {
+        value = nibble;
+        if (nibble != 15) return true;
+        for (;;) {
+            if (in == end) return false;
+            unsigned char b = *in++;
+            value += b;
+            if (b != 255) return true;
+        }
+    };
+    while (in < end) {
+        unsigned char token = *in++;
+        std::size_t literals, match;
+        if (!length(token >> 4, literals) || literals > static_cast<std::size_t>(end - in) || literals > raw_len - out) return false;
+        std::memcpy(dst + out, in, literals);
+        in += literals;
+        out += literals;
+        if (in == end) break;
+        if (end - in < 2) return false;
+        std::size_t offset = in[0] | (std::size_t(in[1]) << 8);
+        in += 2;
+        if (!length(token & 15, match)) return false;
+        match += 4;
+        if (offset == 0 || offset > out || match > raw_len - out) return false;
+        const char* from = dst + out - offset;
+        if (offset >= match) {
+            std::memcpy(dst + out, from, match);
+        } else {
+            for (std::size_t k = 0; k < match; k++) dst[out + k] = from[k];
+        }
+        out += match;
+    }
+    return out == raw_len;
+}
+
+#endif // SEGMENT_FORMAT_HPP
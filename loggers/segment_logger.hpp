@@ -0,0 +1,245 @@
+/**
+ * Segment Logger
+ *
+ * Cadmium logger that writes the CSV logger's records as a directory of
+ * compressed segments with a manifest (format in segment_format.hpp),
+ * so long runs can be archived in pieces and analysed while they are
+ * still going. A segment is closed once it holds segment_bytes of CSV
+ * text, or, with segment_time set, when the simulation time crosses the
+ * next multiple of segment_time.
+ *
+ * The simulation thread only formats records into the open segment. A
+ * closed segment is handed to a writer thread that compresses it, writes
+ * the file and appends its manifest line. At most two closed segments
+ * are queued or being written; beyond that the simulation waits, so
+ * about three segments are held in memory at any time.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef SEGMENT_LOGGER_HPP
+#define SEGMENT_LOGGER_HPP
+
+#include <cadmium/simulation/logger/logger.hpp>
+#include "segment_format.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+
+class SegmentLogger : public cadmium::Logger {
+    static constexpr std::size_t MAX_PENDING = 2;
+
+    struct Segment {
+        SegmentInfo info;
+        std::string text;
+    };
+
+    std::string directory;
+    std::string sep;
+    std::uint64_t segment_bytes;
+    double segment_time;  // 0 rotates on size only
+
+    Segment open;
+    double open_slot;  // floor(time / segment_time) of the open segment
+    std::uint64_t next_index;
+    std::uint64_t records;
+
+    std::ofstream manifest;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Segment> pending;
+    bool closing;
+    std::string error;  // first writer failure, reported on the simulation thread
+
+    static std::string segmentName(std::uint64_t index) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%05llu.seg", static_cast<unsigned long long>(index));
+        return name;
+    }
+
+    // removes the NNNNN.seg files an earlier run left, the new manifest would not list them
+    void removeStaleSegments() const {
+        DIR* dir = ::opendir(directory.c_str());
+        if (dir == nullptr) return;
+        while (const dirent* entry = ::readdir(dir)) {
+            std::string name = entry->d_name;
+            std::size_t digits = name.size() > 4 ? name.size() - 4 : 0;
+            if (digits == 0 || name.compare(digits, 4, ".seg") != 0 ||
+                name.find_first_not_of("0123456789") != digits) {
+                continue;
+            }
+            std::remove((directory + "/" + name).c_str());
+        }
+        ::closedir(dir);
+    }
+
+    // compresses and writes one segment, returns an error message or ""
+    std::string store(Segment& segment, LzCompressor& compressor, std::string& block) {
+        SegmentInfo& info = segment.info;
+        std::string path = directory + "/" + info.file;
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) return "cannot write " + path;
+        file.write(SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+        info.stored_bytes = sizeof(SEGMENT_MAGIC);
+        for (std::size_t at = 0; at < segment.text.size(); at += SEGMENT_BLOCK) {
+            std::size_t raw = std::min(SEGMENT_BLOCK, segment.text.size() - at);
+            block.clear();
+            compressor.compress(segment.text.data() + at, raw, block);
+            bool compressed = block.size() < raw;
+            std::uint32_t lengths[2] = {static_cast<std::uint32_t>(raw),
+                                        static_cast<std::uint32_t>(compressed ? block.size() : raw)};
+            file.write(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+            if (compressed) file.write(block.data(), static_cast<std::streamsize>(block.size()));
+            else file.write(segment.text.data() + at, static_cast<std::streamsize>(raw));
+            info.stored_bytes += sizeof(lengths) + lengths[1];
+        }
+        file.close();
+        if (!file) return "failed writing " + path;
+
+        info.raw_bytes = segment.text.size();
+        info.checksum = segmentChecksum(segment.text.data(), segment.text.size());
+        manifest << "segment " << info.index << ' ' << info.file << ' ' << std::setprecision(17) << info.first_time
+                 << ' ' << info.last_time << ' ' << info.records << ' ' << info.raw_bytes << ' '
+                 << info.stored_bytes << ' ' << std::hex << std::setw(16) << std::setfill('0') << info.checksum
+                 << std::dec << std::setfill(' ') << std::endl;
+        return manifest ? "" : "failed writing the manifest";
+    }
+
+    void writeLoop() {
+        LzCompressor compressor;
+        std::string block;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            changed.wait(lock, [this] { return closing || !pending.empty(); });
+            if (pending.empty()) return;
+            Segment segment = std::move(pending.front());
+            lock.unlock();
+            std::string failure = store(segment, compressor, block);
+            lock.lock();
+            pending.pop_front();
+            if (!failure.empty() && error.empty()) error = failure;
+            changed.notify_all();
+        }
+    }
+
+    void checkError() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error.empty()) throw std::runtime_error("SegmentLogger: " + error);
+    }
+
+    // hands the open segment to the writer and starts the next one,
+    // an empty segment only if forced (a run with no records at all)
+    void rotate(bool force = false) {
+        if (open.info.records == 0 && !force) return;
+        open.info.file = segmentName(open.info.index);
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return pending.size() < MAX_PENDING; });
+        pending.push_back(std::move(open));
+        changed.notify_all();
+        lock.unlock();
+
+        open = Segment();
+        open.info.index = ++next_index;
+        open.text.reserve(segment_bytes + 4096);
+    }
+
+    void append(double time, long modelId, const std::string& modelName, const std::string& portName, const std::string& data) {
+        if (segment_time > 0) {
+            double slot = std::floor(time / segment_time);
+            if (slot != open_slot) {
+                rotate();
+                open_slot = slot;
+            }
+        }
+        if (open.info.records == 0) open.info.first_time = time;
+        open.info.last_time = time;
+        open.info.records++;
+        records++;
+
+        // same text as the CSV logger, whose ostream prints doubles as %g
+        char number[32];
+        int length = std::snprintf(number, sizeof(number), "%g", time);
+        std::string& text = open.text;
+        text.append(number, static_cast<std::size_t>(length));
+        text += sep;
+        auto [end, ec] = std::to_chars(number, number + sizeof(number), modelId);
+        text.append(number, end);
+        text.append(sep).append(modelName).append(sep).append(portName).append(sep).append(data);
+        text += '\n';
+        if (text.size() >= segment_bytes) rotate();
+    }
+
+public:
+    // directory is created if needed; segment_time 0 rotates on size only
+    SegmentLogger(std::string directory, std::string sep, std::uint64_t segment_bytes, double segment_time)
+        : cadmium::Logger(), directory(std::move(directory)), sep(std::move(sep)), segment_bytes(segment_bytes),
+          segment_time(segment_time), open(), open_slot(0), next_index(0), records(0), manifest(), writer(), mutex(),
+          changed(), pending(), closing(false), error() {}
+
+    ~SegmentLogger() override {
+        if (writer.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closing = true;
+            }
+            changed.notify_all();
+            writer.join();
+        }
+    }
+
+    void start() override {
+        if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            throw std::runtime_error("SegmentLogger: cannot create " + directory);
+        }
+        removeStaleSegments();
+        manifest.open(directory + "/" + SEGMENT_MANIFEST, std::ios::trunc);
+        if (!manifest) throw std::runtime_error("SegmentLogger: cannot write " + directory + "/" + SEGMENT_MANIFEST);
+        open = Segment();
+        open.text.reserve(segment_bytes + 4096);
+        open_slot = 0;
+        next_index = 0;
+        records = 0;
+        closing = false;
+        error.clear();
+        open.text += "sep=" + sep + "\n";
+        open.text += "time" + sep + "model_id" + sep + "model_name" + sep + "port_name" + sep + "data" + "\n";
+        writer = std::thread(&SegmentLogger::writeLoop, this);
+    }
+
+    void stop() override {
+        rotate(next_index == 0);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        changed.notify_all();
+        writer.join();
+        manifest << "end " << next_index << ' ' << records << std::endl;
+        manifest.close();
+        checkError();
+    }
+
+    void logOutput(double time, long modelId, const std::string& modelName, const std::string& portName, const std::string& output) override {
+        append(time, modelId, modelName, portName, output);
+    }
+
+    void logState(double time, long modelId, const std::string& modelName, const std::string& state) override {
+        append(time, modelId, modelName, "", state);
+    }
+};
+
+#endif // SEGMENT_LOGGER_HPP
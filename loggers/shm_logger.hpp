@@ -0,0 +1,115 @@
+/**
+ * Shared-Memory Logger
+ *
+ * Cadmium logger that publishes every state change and port message
+ * into a POSIX shared-memory ring (layout in shm_ring.hpp) instead of a
+ * file, so live dashboards can follow a run with no file I/O on the
+ * simulation side. Publishing a record is a fixed-size copy into the
+ * next slot; the writer never waits for readers.
+ *
+ * The segment is recreated at start() and marked closed at stop(). It
+ * is left in place afterwards so late readers can drain it; remove it
+ * with shm_unlink or rm /dev/shm/<name>.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef SHM_LOGGER_HPP
+#define SHM_LOGGER_HPP
+
+#include <cadmium/simulation/logger/logger.hpp>
+#include "shm_ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+class ShmLogger : public cadmium::Logger {
+    std::string name;
+    std::uint64_t slot_count;
+    ShmRingHeader* header;
+    ShmRingSlot* slots;
+    std::uint64_t next_seq;
+
+    void publish(ShmRecordKind kind, double time, long modelId, const std::string& modelName,
+                 const std::string& portName, const std::string& data) {
+        std::uint64_t n = next_seq++;
+        ShmRingSlot& slot = slots[n & (slot_count - 1)];
+        slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.time = time;
+        slot.model_id = modelId;
+        slot.kind = kind;
+        std::size_t room = sizeof(slot.text);
+        std::size_t name_len = std::min<std::size_t>({modelName.size(), 255, room});
+        std::size_t port_len = std::min<std::size_t>({portName.size(), 255, room - name_len});
+        std::size_t data_len = std::min<std::size_t>(data.size(), room - name_len - port_len);
+        std::memcpy(slot.text, modelName.data(), name_len);
+        std::memcpy(slot.text + name_len, portName.data(), port_len);
+        std::memcpy(slot.text + name_len + port_len, data.data(), data_len);
+        slot.name_len = static_cast<std::uint8_t>(name_len);
+        slot.port_len = static_cast<std::uint8_t>(port_len);
+        slot.data_len = static_cast<std::uint16_t>(data_len);
+
+        slot.seq.store(2 * n + 2, std::memory_order_release);
+        header->write_seq.store(n + 1, std::memory_order_release);
+    }
+
+public:
+    // name is the POSIX shm name ("/airport"), slot_count is rounded up to a power of two
+    explicit ShmLogger(std::string name, std::uint64_t slot_count = 65536)
+        : cadmium::Logger(), name(std::move(name)), slot_count(1), header(nullptr), slots(nullptr), next_seq(0) {
+        if (this->name.empty() || this->name[0] != '/') this->name.insert(0, "/");
+        while (this->slot_count < slot_count) this->slot_count *= 2;
+    }
+
+    ~ShmLogger() override {
+        if (header != nullptr) ::munmap(header, shmRingBytes(slot_count));
+    }
+
+    void start() override {
+        // fresh segment per run, readers of an old one see it closed
+        ::shm_unlink(name.c_str());
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) throw std::runtime_error("ShmLogger: cannot create shared memory " + name);
+        std::size_t bytes = shmRingBytes(slot_count);
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("ShmLogger: cannot size shared memory " + name);
+        }
+        void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) throw std::runtime_error("ShmLogger: cannot map shared memory " + name);
+
+        // ftruncate zero fills, so every slot seq starts at 0 (never written)
+        header = static_cast<ShmRingHeader*>(base);
+        slots = shmRingSlots(header);
+        header->version = SHM_RING_VERSION;
+        header->slot_size = SHM_RING_SLOT_SIZE;
+        header->slot_count = slot_count;
+        header->write_seq.store(0, std::memory_order_relaxed);
+        header->closed.store(0, std::memory_order_relaxed);
+        // magic last, readers wait for it before trusting the header
+        header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+    }
+
+    void stop() override {
+        if (header != nullptr) header->closed.store(1, std::memory_order_release);
+    }
+
+    void logOutput(double time, long modelId, const std::string& modelName, const std::string& portName, const std::string& output) override {
+        publish(SHM_RECORD_OUTPUT, time, modelId, modelName, portName, output);
+    }
+
+    void logState(double time, long modelId, const std::string& modelName, const std::string& state) override {
+        publish(SHM_RECORD_STATE, time, modelId, modelName, std::string(), state);
+    }
+};
+
+#endif // SHM_LOGGER_HPP
@@ -0,0 +1,86 @@
+/**
+ * Shared-Memory Log Ring
+ *
+ * Layout of the POSIX shared-memory ring the ShmLogger publishes into
+ * and shm_tail reads from. One writer, any number of readers; readers
+ * never block the writer, a reader that falls more than a ring behind
+ * just loses the records that were overwritten.
+ *
+ * Segment layout (all integers little endian, as mapped):
+ *
+ *   offset 0    ShmRingHeader, 64 bytes
+ *     u64 magic        SHM_RING_MAGIC ("AIRLOG01"), set last (atomic, release)
+ *     u32 version      SHM_RING_VERSION
+ *     u32 slot_size    bytes per slot, SHM_RING_SLOT_SIZE
+ *     u64 slot_count   power of two
+ *     u64 write_seq    records published so far (atomic, release)
+ *     u32 closed       1 once the simulation has stopped (atomic)
+ *   offset 64   slot_count slots of slot_size bytes; record n lives in
+ *               slot n & (slot_count - 1)
+ *
+ *   ShmRingSlot:
+ *     u64 seq          seqlock: 2n+1 while record n is written, 2n+2 when done
+ *     f64 time         simulation time
+ *     i64 model_id
+ *     u8  kind         0 = state, 1 = port output
+ *     u8  name_len, port_len, reserved
+ *     u16 data_len
+ *     char text[]      model name, port name and data back to back,
+ *                      truncated to fit the slot
+ *
+ * Reading record n: check write_seq > n, load slot seq (acquire), copy
+ * the slot, fence, load seq again. The copy is good only if both loads
+ * are 2n+2; anything larger means the writer lapped the reader.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef SHM_RING_HPP
+#define SHM_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+constexpr std::uint64_t SHM_RING_MAGIC = 0x3130474F'4C524941ULL;  // "AIRLOG01"
+constexpr std::uint32_t SHM_RING_VERSION = 1;
+constexpr std::uint32_t SHM_RING_SLOT_SIZE = 256;
+
+struct alignas(64) ShmRingHeader {
+    std::atomic<std::uint64_t> magic;  // written last, once the header is valid
+    std::uint32_t version;
+    std::uint32_t slot_size;
+    std::uint64_t slot_count;
+    std::atomic<std::uint64_t> write_seq;
+    std::atomic<std::uint32_t> closed;
+};
+
+struct ShmRingSlot {
+    std::atomic<std::uint64_t> seq;
+    double time;
+    std::int64_t model_id;
+    std::uint8_t kind;
+    std::uint8_t name_len;
+    std::uint8_t port_len;
+    std::uint8_t reserved;
+    std::uint16_t data_len;
+    char text[SHM_RING_SLOT_SIZE - 30];
+};
+
+enum ShmRecordKind : std::uint8_t { SHM_RECORD_STATE = 0, SHM_RECORD_OUTPUT = 1 };
+
+static_assert(sizeof(ShmRingHeader) == 64, "header is one cache line");
+static_assert(sizeof(ShmRingSlot) == SHM_RING_SLOT_SIZE, "slot layout must match SHM_RING_SLOT_SIZE");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared atomics must be lock free");
+
+// bytes to map for a ring with slot_count slots
+inline std::size_t shmRingBytes(std::uint64_t slot_count) {
+    return sizeof(ShmRingHeader) + slot_count * sizeof(ShmRingSlot);
+}
+
+inline ShmRingSlot* shmRingSlots(ShmRingHeader* header) {
+    return reinterpret_cast<ShmRingSlot*>(header + 1);
+}
+
+#endif // SHM_RING_HPP
@@ -0,0 +1,208 @@
+/**
+ * Web Viewer Logger
+ *
+ * Cadmium logger that writes the DEVS web viewer's input files while
+ * the simulation runs, so no second pass over the CSV trace is needed:
+ *
+ *   <prefix>_output_messages.txt   one block per time with output:
+ *       00:01:00:000
+ *       [out: {100}] generated by model Generator
+ *   <prefix>_output_state.txt      one block per time with a state change,
+ *       listing the latest state of every model, sorted by name:
+ *       00:01:00:000
+ *       State for model Runway is phase: LANDING & plane: 100 & sigma: 60
+ *   <prefix>.ma                    the model structure, written at start()
+ *       from the live couplings of the top model and its coupled children
+ *
+ * Only models whose state prints as {key=value, ...} appear in the state
+ * file; the generator's state is a bare time advance and is left out, as
+ * in the hand-made viewer files. A state block is written once its time
+ * is over (the next time is logged, or stop()), and both files go
+ * through large stream buffers, so the cost per record is a few appends.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef VIEWER_LOGGER_HPP
+#define VIEWER_LOGGER_HPP
+
+#include <cadmium/simulation/logger/logger.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+class ViewerLogger : public cadmium::Logger {
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+    std::string prefix;
+    std::shared_ptr<cadmium::Coupled> model;
+    std::vector<char> messages_buffer;
+    std::vector<char> state_buffer;
+    std::ofstream messages;
+    std::ofstream states;
+    std::map<std::string, std::string> latest;  // model name -> state in viewer form
+    double current_time;
+    bool messages_open;  // a message block is open for current_time
+    bool states_dirty;   // some state changed at current_time
+
+    // seconds to HH:MM:SS:mmm
+    static std::string timestamp(double time) {
+        long long ms = std::llround(time * 1000.0);
+        char text[32];
+        std::snprintf(text, sizeof(text), "%02lld:%02lld:%02lld:%03lld",
+                      ms / 3600000, (ms / 60000) % 60, (ms / 1000) % 60, ms % 1000);
+        return text;
+    }
+
+    // {a=1, b=2} to a: 1 & b: 2, false if the state is not in that form
+    static bool viewerState(const std::string& state, std::string& out) {
+        if (state.size() < 2 || state.front() != '{' || state.back() != '}') return false;
+        out.clear();
+        int depth = 0;
+        for (std::size_t i = 1; i + 1 < state.size(); i++) {
+            char c = state[i];
+            if (c == '{' || c == '[' || c == '(') depth++;
+            else if (c == '}' || c == ']' || c == ')') depth--;
+            if (depth == 0 && c == '=') {
+                out += ": ";
+            } else if (depth == 0 && c == ',' && i + 1 < state.size() && state[i + 1] == ' ') {
+                out += " & ";
+                i++;
+            } else {
+                out += c;
+            }
+        }
+        return true;
+    }
+
+    static std::string className(const cadmium::Component& component) {
+        const char* mangled = typeid(component).name();
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+        std::string name = (status == 0 && demangled != nullptr) ? demangled : mangled;
+        std::free(demangled);
+        return name;
+    }
+
+    // port@Model, or just the port when it belongs to the coupled model itself
+    static std::string endpoint(const cadmium::PortInterface& port, const cadmium::Coupled& owner) {
+        const cadmium::Component* parent = port.getParent();
+        if (parent == nullptr || parent == &owner) return port.getId();
+        return port.getId() + "@" + parent->getId();
+    }
+
+    // one [section] per coupled model, children after their parent
+    static void writeSection(std::ostream& out, const cadmium::Coupled& coupled, const std::string& section) {
+        std::vector<std::string> names;
+        for (const auto& entry : coupled.getComponents()) names.push_back(entry.first);
+        std::sort(names.begin(), names.end());
+
+        out << "[" << section << "]" << std::endl;
+        std::vector<const cadmium::Coupled*> children;
+        for (const auto& name : names) {
+            const auto& component = coupled.getComponents().at(name);
+            if (auto child = dynamic_cast<const cadmium::Coupled*>(component.get())) {
+                out << "components : " << name << std::endl;
+                children.push_back(child);
+            } else {
+                out << "components : " << name << "@" << className(*component) << std::endl;
+            }
+        }
+        out << std::endl;
+        for (const auto* couplings : {&coupled.getEICs(), &coupled.getICs(), &coupled.getEOCs()}) {
+            for (const auto& [from, to] : *couplings) {
+                out << "Link : " << endpoint(*from, coupled) << " " << endpoint(*to, coupled) << std::endl;
+            }
+        }
+        for (const auto* child : children) {
+            out << std::endl;
+            writeSection(out, *child, child->getId());
+        }
+    }
+
+    void writeStructure() const {
+        std::ofstream ma(prefix + ".ma");
+        if (!ma) throw std::runtime_error("ViewerLogger: cannot write " + prefix + ".ma");
+        writeSection(ma, *model, "top");
+    }
+
+    // close the block for current_time before logging at a new time
+    void advance(double time) {
+        if (time == current_time) return;
+        flushStates();
+        current_time = time;
+        messages_open = false;
+    }
+
+    void flushStates() {
+        if (!states_dirty) return;
+        states << timestamp(current_time) << '\n';
+        for (const auto& [name, state] : latest) {
+            states << "State for model " << name << " is " << state << '\n';
+        }
+        states_dirty = false;
+    }
+
+    static void openBuffered(std::ofstream& file, std::vector<char>& buffer, const std::string& path) {
+        buffer.resize(BUFFER_SIZE);
+        file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.open(path);
+        if (!file) throw std::runtime_error("ViewerLogger: cannot write " + path);
+    }
+
+public:
+    // prefix is the path without suffix, e.g. "visualization/Airport"
+    ViewerLogger(std::string prefix, std::shared_ptr<cadmium::Coupled> model)
+        : cadmium::Logger(), prefix(std::move(prefix)), model(std::move(model)), messages_buffer(), state_buffer(),
+          messages(), states(), latest(), current_time(-1), messages_open(false), states_dirty(false) {}
+
+    void start() override {
+        writeStructure();
+        openBuffered(messages, messages_buffer, prefix + "_output_messages.txt");
+        openBuffered(states, state_buffer, prefix + "_output_state.txt");
+        latest.clear();
+        current_time = -1;
+        messages_open = false;
+        states_dirty = false;
+    }
+
+    void stop() override {
+        flushStates();
+        messages.close();
+        states.close();
+    }
+
+    void logOutput(double time, long modelId, const std::string& modelName, const std::string& portName, const std::string& output) override {
+        advance(time);
+        if (!messages_open) {
+            messages << timestamp(time) << '\n';
+            messages_open = true;
+        }
+        messages << '[' << portName << ": ";
+        if (!output.empty() && output.front() == '{') messages << output;
+        else messages << '{' << output << '}';
+        messages << "] generated by model " << modelName << '\n';
+    }
+
+    void logState(double time, long modelId, const std::string& modelName, const std::string& state) override {
+        advance(time);
+        std::string converted;
+        if (!viewerState(state, converted)) return;
+        latest[modelName] = std::move(converted);
+        states_dirty = true;
+    }
+};
+
+#endif // VIEWER_LOGGER_HPP
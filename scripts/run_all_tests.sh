@@ -34,4 +34,7 @@ echo "=== Running Coupled Tests ==="
 ./bin/COUPLED_TEST > simulation_results/coupled_output.txt 2>&1
 cat simulation_results/coupled_output.txt
 
+echo "=== Running Fingerprint Tests ==="
+./bin/FINGERPRINT_TEST
+
 echo "=== All Tests Complete ==="
@@ -0,0 +1,107 @@
+/*
+ * Airport Estimator
+ *
+ * Closed-form queueing approximations of the airport model, for quick
+ * capacity questions before a full simulation. Every plane uses the
+ * runway twice, once to land and once to take off, and the ControlTower
+ * always clears waiting landings first without interrupting a runway
+ * operation. The runway is therefore treated as a non-preemptive
+ * two-class priority M/D/1 queue (Cobham's formula) with service time
+ * RunwayState::RUNWAY_TIME, landings as the high class and takeoffs as
+ * the low one, both at the arrival rate. The Selector is a plain M/D/1
+ * queue with service time SelectorState::ROUTING_TIME. Bay occupancy
+ * follows from Little's law with the share of plane IDs in each
+ * Selector bay range.
+ *
+ * With arrival rate l, runway time D and rho = l * D per class:
+ *   residual work      W0 = 2 l D^2 / 2
+ *   landing wait       W0 / (1 - rho)
+ *   takeoff wait       W0 / ((1 - rho) (1 - 2 rho))
+ *   queue lengths      l * wait
+ * The estimate assumes Poisson arrivals in steady state. Takeoff requests
+ * really follow landings by a fixed routing delay, and the T scenarios
+ * are short bursts, so compare with calibrate before trusting it near
+ * saturation (2 rho close to 1).
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef AIRPORT_ESTIMATOR_HPP
+#define AIRPORT_ESTIMATOR_HPP
+
+#include "../atomics/runway.hpp"
+#include "../atomics/selector.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+struct AirportEstimate {
+    double arrivals_per_hour = 0;
+    double runway_utilization = 0;     // both classes, saturated at 1 or more
+    bool stable = false;                // runway and selector both below 1
+    double landing_wait = 0;            // seconds in landing_queue / tower before clearance
+    double takeoff_wait = 0;            // seconds in takeoff_queue / tower before clearance
+    double landing_queue = 0;           // mean planes waiting to land
+    double takeoff_queue = 0;           // mean planes waiting to take off
+    double selector_wait = 0;           // seconds waiting for the selector
+    double time_in_system = 0;          // arrival to the end of the takeoff
+    std::array<double, 4> bay_planes{}; // mean planes parked per bay
+};
+
+// dwell is the mean hangar time per plane in seconds, 0 when planes leave at once
+inline AirportEstimate estimateAirport(double arrivals_per_hour, double dwell = 0.0) {
+    constexpr double D = RunwayState::RUNWAY_TIME;
+    constexpr double R = SelectorState::ROUTING_TIME;
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    constexpr int BAY_MAX[4] = {SelectorState::BAY1_MAX, SelectorState::BAY2_MAX,
+                                SelectorState::BAY3_MAX, SelectorState::BAY4_MAX};
+
+    AirportEstimate e;
+    e.arrivals_per_hour = arrivals_per_hour;
+    double rate = arrivals_per_hour / 3600.0;
+    double rho = rate * D;            // per class
+    double rho_selector = rate * R;
+    e.runway_utilization = 2 * rho;
+    e.stable = (2 * rho < 1) && (rho_selector < 1);
+
+    double residual = rate * D * D;   // sum over both classes of l D^2 / 2
+    e.landing_wait = (rho < 1) ? residual / (1 - rho) : INF;
+    e.takeoff_wait = (2 * rho < 1) ? residual / ((1 - rho) * (1 - 2 * rho)) : INF;
+    e.landing_queue = (rho < 1) ? rate * e.landing_wait : INF;
+    e.takeoff_queue = (2 * rho < 1) ? rate * e.takeoff_wait : INF;
+    e.selector_wait = (rho_selector < 1) ? rho_selector * R / (2 * (1 - rho_selector)) : INF;
+    e.time_in_system = e.landing_wait + D + e.selector_wait + R + dwell + e.takeoff_wait + D;
+
+    // plane IDs taken as uniform over the selector's range
+    int low = 0;
+    for (int i = 0; i < 4; i++) {
+        double share = static_cast<double>(BAY_MAX[i] - low + 1) / (SelectorState::BAY4_MAX + 1);
+        e.bay_planes[i] = share * rate * dwell;
+        low = BAY_MAX[i] + 1;
+    }
+    return e;
+}
+
+// the estimator's own assumption as an input file: Poisson arrivals at
+// arrivals_per_hour with plane IDs uniform over the selector's range
+inline std::string poissonArrivals(double arrivals_per_hour, int planes, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::exponential_distribution<double> gap(arrivals_per_hour / 3600.0);
+    std::uniform_int_distribution<int> id(1, SelectorState::BAY4_MAX);
+    std::ostringstream lines;
+    lines << std::fixed << std::setprecision(3);
+    double time = 0;
+    for (int i = 0; i < planes; i++) {
+        time += gap(rng);
+        lines << time << " " << id(rng) << "\n";
+    }
+    return lines.str();
+}
+
+#endif // AIRPORT_ESTIMATOR_HPP
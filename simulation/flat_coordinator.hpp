@@ -0,0 +1,390 @@
+/*
+ * Flat Coordinator
+ *
+ * Drop-in replacement for Cadmium's RootCoordinator (same start /
+ * simulate / stop / setLogger calls) that flattens the model tree once
+ * instead of walking it through a coordinator per coupled model on every
+ * step. It keeps:
+ *   - the atomics in the order Cadmium visits them, with the same model ids
+ *   - the couplings in the order Cadmium propagates them: IC and EOC
+ *     bottom-up for the outputs, then EIC top-down for the inputs
+ * so every bag fills in the same order and the logger sees the same
+ * records in the same order as with RootCoordinator.
+ *
+ * With threads > 1 the output functions of the imminent models, and then
+ * the transitions of the models that fire, run in parallel on a
+ * WorkStealingPool whenever at least min_width models take part in the
+ * step. Each model only touches its own state and ports in those calls.
+ * Routing and logging stay on the calling thread, in model order, after
+ * each parallel phase, so the trace is identical to the sequential one.
+ * Narrow steps, which is every step of the default airport, run
+ * sequentially because waking the pool costs more than the models.
+ *
+ * The SCAN scheduler looks at every atomic and every coupling on every
+ * step, which is cheapest for a model the size of the airport. The
+ * CALENDAR scheduler keeps each atomic's next time in an IndexedHeap and
+ * only touches what the step uses: it pops the imminent atomics, follows
+ * the couplings out of their ports (and on through coupled ports) in
+ * propagation order, and updates the heap for the atomics that changed.
+ * A coupling only ever feeds couplings later in that order, so the live
+ * ones come out of a min-heap of coupling indexes in the same order the
+ * scan routes them. The cost of a step then grows with the atomics it
+ * touches, not with the size of the model.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef FLAT_COORDINATOR_HPP
+#define FLAT_COORDINATOR_HPP
+
+#include <cadmium/modeling/devs/atomic.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+#include <cadmium/simulation/logger/logger.hpp>
+#include "work_stealing_pool.hpp"
+#include "../data_structures/indexed_heap.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// how the next atomics to fire are found
+enum class FlatScheduler { SCAN, CALENDAR };
+
+struct ParallelOptions {
+    unsigned threads = 1;        // 1 = flat but sequential
+    std::size_t min_width = 8;   // fewest models in a step worth running in parallel
+    FlatScheduler scheduler = FlatScheduler::SCAN;
+};
+
+class FlatCoordinator {
+    using Calendar = IndexedHeap<std::size_t, double, std::less<double>>;
+
+    struct Model {
+        std::shared_ptr<cadmium::AtomicInterface> atomic;
+        long id;
+        double time_last;
+        double time_next;
+        bool imminent;   // this step
+        bool active;     // fires this step
+        Calendar::Handle handle;             // CALENDAR only
+        std::vector<std::size_t> outgoing;   // couplings out of its ports, CALENDAR only
+    };
+
+    struct Coupling {
+        std::shared_ptr<const cadmium::PortInterface> from;
+        std::shared_ptr<cadmium::PortInterface> to;
+        long target;     // index of the receiving atomic, -1 for a coupled model's port
+        std::vector<std::size_t> next;       // couplings out of a coupled port, CALENDAR only
+    };
+
+    std::shared_ptr<cadmium::Coupled> top;
+    std::vector<Model> models;
+    std::vector<cadmium::Coupled*> coupled_models;
+    std::vector<Coupling> output_couplings;  // IC and EOC, bottom-up
+    std::vector<Coupling> input_couplings;   // EIC, top-down
+    std::shared_ptr<cadmium::Logger> logger;
+    bool log_states;
+    ParallelOptions options;
+    std::unique_ptr<WorkStealingPool> pool;
+    double time_last;
+    double time_next;
+
+    std::vector<std::size_t> imminent;
+    std::vector<std::size_t> active;
+    std::function<void(std::size_t)> output_task;
+    std::function<void(std::size_t)> transition_task;
+    double step_time;
+
+    Calendar calendar;
+    std::vector<std::size_t> live;           // min-heap of coupling indexes to route
+    std::vector<char> queued;                // coupling already in live
+    std::vector<cadmium::PortInterface*> filled;  // coupled ports written this step
+
+    // same id order as Coordinator::setModelId
+    long flatten(cadmium::Coupled& coupled, long next, std::unordered_map<const cadmium::Component*, long>& index) {
+        next++;
+        coupled_models.push_back(&coupled);
+        for (const auto& [from, to] : coupled.getEICs()) input_couplings.push_back(Coupling{from, to, -1, {}});
+        for (const auto& [name, component] : coupled.getComponents()) {
+            if (auto child = std::dynamic_pointer_cast<cadmium::Coupled>(component)) {
+                next = flatten(*child, next, index);
+            } else if (auto atomic = std::dynamic_pointer_cast<cadmium::AtomicInterface>(component)) {
+                index[atomic.get()] = static_cast<long>(models.size());
+                models.push_back(Model{atomic, next++, time_last, time_last + atomic->timeAdvance(), false, false,
+                                       Calendar::NO_HANDLE, {}});
+            }
+        }
+        for (const auto* couplings : {&coupled.getICs(), &coupled.getEOCs()}) {
+            for (const auto& [from, to] : *couplings) output_couplings.push_back(Coupling{from, to, -1, {}});
+        }
+        return next;
+    }
+
+    void route(std::vector<Coupling>& couplings) {
+        for (auto& coupling : couplings) {
+            if (coupling.from->empty()) continue;
+            coupling.to->propagate(coupling.from);
+            if (coupling.target >= 0) models[static_cast<std::size_t>(coupling.target)].active = true;
+        }
+    }
+
+    // outputs first, then inputs: the order both schedulers route in
+    Coupling& coupling(std::size_t i) {
+        return i < output_couplings.size() ? output_couplings[i] : input_couplings[i - output_couplings.size()];
+    }
+
+    void queue(const std::vector<std::size_t>& couplings) {
+        for (std::size_t i : couplings) {
+            if (queued[i]) continue;
+            queued[i] = true;
+            live.push_back(i);
+            std::push_heap(live.begin(), live.end(), std::greater<std::size_t>());
+        }
+    }
+
+    // CALENDAR: route from the imminent atomics' ports only, collecting the atomics that receive
+    void routeLive() {
+        for (std::size_t i : imminent) queue(models[i].outgoing);
+        while (!live.empty()) {
+            std::pop_heap(live.begin(), live.end(), std::greater<std::size_t>());
+            std::size_t index = live.back();
+            live.pop_back();
+            queued[index] = false;
+            Coupling& c = coupling(index);
+            if (c.from->empty()) continue;
+            c.to->propagate(c.from);
+            if (c.target >= 0) {
+                Model& model = models[static_cast<std::size_t>(c.target)];
+                if (!model.active) {
+                    model.active = true;
+                    active.push_back(static_cast<std::size_t>(c.target));
+                }
+            } else {
+                filled.push_back(c.to.get());
+                queue(c.next);
+            }
+        }
+    }
+
+    // CALENDAR: the atomics due now leave the calendar until they are rescheduled
+    void popImminent(double time) {
+        imminent.clear();
+        active.clear();
+        while (!calendar.empty() && calendar.topKey() <= time) {
+            std::size_t i = calendar.top();
+            calendar.pop();
+            models[i].handle = Calendar::NO_HANDLE;
+            models[i].imminent = true;
+            models[i].active = true;
+            imminent.push_back(i);
+            active.push_back(i);
+        }
+    }
+
+    void reschedule() {
+        for (std::size_t i : active) {
+            Model& model = models[i];
+            if (model.handle == Calendar::NO_HANDLE) {
+                model.handle = calendar.push(i, model.time_next);
+            } else {
+                calendar.update(model.handle, model.time_next);
+            }
+            model.imminent = false;
+            model.active = false;
+        }
+        for (auto* port : filled) port->clear();
+        filled.clear();
+        time_next = calendar.empty() ? std::numeric_limits<double>::infinity() : calendar.topKey();
+    }
+
+    // CALENDAR: every atomic in the heap, and which couplings leave each port
+    void buildCalendar() {
+        std::unordered_map<const cadmium::PortInterface*, std::vector<std::size_t>> from_port;
+        std::size_t count = output_couplings.size() + input_couplings.size();
+        for (std::size_t i = 0; i < count; i++) from_port[coupling(i).from.get()].push_back(i);
+        for (std::size_t i = 0; i < count; i++) {
+            Coupling& c = coupling(i);
+            if (c.target >= 0) continue;
+            auto it = from_port.find(c.to.get());
+            if (it != from_port.end()) c.next = it->second;
+        }
+        for (std::size_t i = 0; i < models.size(); i++) {
+            Model& model = models[i];
+            for (const auto& port : model.atomic->getOutPorts()) {
+                auto it = from_port.find(port.get());
+                if (it == from_port.end()) continue;
+                model.outgoing.insert(model.outgoing.end(), it->second.begin(), it->second.end());
+            }
+            std::sort(model.outgoing.begin(), model.outgoing.end());
+            model.handle = calendar.push(i, model.time_next);
+        }
+        queued.assign(count, false);
+    }
+
+    void runAll(const std::vector<std::size_t>& indexes, const std::function<void(std::size_t)>& task) {
+        if (pool && indexes.size() >= options.min_width) {
+            pool->run(indexes.size(), task, std::max<std::size_t>(1, indexes.size() / (pool->threads() * 4)));
+        } else {
+            for (std::size_t i = 0; i < indexes.size(); i++) task(i);
+        }
+    }
+
+    void advance(double time) {
+        if (logger != nullptr) logger->lock();
+        step_time = time;
+        bool scan = (options.scheduler == FlatScheduler::SCAN);
+
+        // outputs of the imminent models
+        if (scan) {
+            imminent.clear();
+            for (std::size_t i = 0; i < models.size(); i++) {
+                models[i].imminent = time >= models[i].time_next;
+                models[i].active = models[i].imminent;
+                if (models[i].imminent) imminent.push_back(i);
+            }
+        } else {
+            popImminent(time);
+        }
+        runAll(imminent, output_task);
+
+        // route in Cadmium's order, marking the models that receive
+        if (scan) {
+            route(output_couplings);
+            route(input_couplings);
+            active.clear();
+            for (std::size_t i = 0; i < models.size(); i++) {
+                if (models[i].active) active.push_back(i);
+            }
+        } else {
+            routeLive();
+            std::sort(active.begin(), active.end());
+        }
+        runAll(active, transition_task);
+
+        // log in model order, then clear what this step used
+        for (std::size_t i : active) {
+            Model& model = models[i];
+            if (logger != nullptr) {
+                if (model.imminent) {
+                    for (const auto& port : model.atomic->getOutPorts()) {
+                        for (std::size_t m = 0; m < port->size(); m++) {
+                            logger->logOutput(time, model.id, model.atomic->getId(), port->getId(), port->logMessage(m));
+                        }
+                    }
+                }
+                if (log_states) logger->logState(time, model.id, model.atomic->getId(), model.atomic->logState());
+            }
+            model.atomic->clearPorts();
+        }
+        if (scan) {
+            time_next = std::numeric_limits<double>::infinity();
+            for (const auto& model : models) time_next = std::min(time_next, model.time_next);
+            for (auto* coupled : coupled_models) coupled->clearPorts();
+        } else {
+            reschedule();
+        }
+        time_last = time;
+        if (logger != nullptr) logger->unlock();
+    }
+
+public:
+    FlatCoordinator(std::shared_ptr<cadmium::Coupled> model, const ParallelOptions& options = ParallelOptions(),
+                    double time = 0)
+        : top(std::move(model)), models(), coupled_models(), output_couplings(), input_couplings(), logger(),
+          log_states(true), options(options), pool(), time_last(time), time_next(std::numeric_limits<double>::infinity()),
+          imminent(), active(), output_task(), transition_task(), step_time(time), calendar(), live(), queued(),
+          filled() {
+        std::unordered_map<const cadmium::Component*, long> index;
+        flatten(*top, 0, index);
+        for (auto* couplings : {&output_couplings, &input_couplings}) {
+            for (auto& coupling : *couplings) {
+                auto it = index.find(coupling.to->getParent());
+                if (it != index.end()) coupling.target = it->second;
+            }
+        }
+        for (const auto& m : models) time_next = std::min(time_next, m.time_next);
+        if (options.scheduler == FlatScheduler::CALENDAR) buildCalendar();
+        if (options.threads > 1) pool = std::make_unique<WorkStealingPool>(options.threads);
+
+        output_task = [this](std::size_t i) { models[imminent[i]].atomic->output(); };
+        transition_task = [this](std::size_t i) {
+            Model& model = models[active[i]];
+            if (model.atomic->inEmpty()) {
+                model.atomic->internalTransition();
+            } else if (model.imminent) {
+                model.atomic->confluentTransition(step_time - model.time_last);
+            } else {
+                model.atomic->externalTransition(step_time - model.time_last);
+            }
+            model.time_last = step_time;
+            model.time_next = step_time + model.atomic->timeAdvance();
+        };
+    }
+
+    [[nodiscard]] double getTimeLast() const { return time_last; }
+    [[nodiscard]] double getTimeNext() const { return time_next; }
+    [[nodiscard]] std::size_t atomicCount() const { return models.size(); }
+
+    // start over at time once the atomics have been reset in place: only
+    // the schedule is rebuilt, the flattened tree is kept
+    void reset(double time = 0) {
+        time_last = time;
+        time_next = std::numeric_limits<double>::infinity();
+        calendar.clear();
+        for (std::size_t i = 0; i < models.size(); i++) {
+            Model& model = models[i];
+            model.time_last = time;
+            model.time_next = time + model.atomic->timeAdvance();
+            model.imminent = false;
+            model.active = false;
+            time_next = std::min(time_next, model.time_next);
+            if (options.scheduler == FlatScheduler::CALENDAR) model.handle = calendar.push(i, model.time_next);
+        }
+    }
+
+    void setLogger(const std::shared_ptr<cadmium::Logger>& log) { logger = log; }
+
+    // off for loggers that only read port messages (PlaneTimingLogger), so
+    // the states are not printed for nothing; the trace is then incomplete
+    void setLogStates(bool on) { log_states = on; }
+
+    template <typename T, typename... Args>
+    void setLogger(Args&&... args) {
+        setLogger(std::make_shared<T>(std::forward<Args>(args)...));
+    }
+
+    void start() {
+        if (logger == nullptr) return;
+        logger->start();
+        if (!log_states) return;
+        for (const auto& model : models) {
+            logger->logState(time_last, model.id, model.atomic->getId(), model.atomic->logState());
+        }
+    }
+
+    void stop() {
+        if (logger == nullptr) return;
+        for (const auto& model : models) {
+            if (!log_states) break;
+            logger->logState(time_last, model.id, model.atomic->getId(), model.atomic->logState());
+        }
+        logger->stop();
+    }
+
+    void simulate(long iterations) {
+        while (iterations-- > 0 && time_next < std::numeric_limits<double>::infinity()) advance(time_next);
+    }
+
+    void simulate(double interval) {
+        double time_final = time_last + interval;
+        while (time_next < time_final) advance(time_next);
+    }
+};
+
+#endif // FLAT_COORDINATOR_HPP
@@ -0,0 +1,144 @@
+/*
+ * Live Metrics
+ *
+ * Counters a running simulation keeps up to date (AirportMetrics) and a
+ * background thread that publishes them to a text file (MetricsPublisher),
+ * so a long run can be watched without stopping it.
+ *
+ * The simulation thread only does relaxed stores and adds on the
+ * counters. The publisher wakes every interval, reads them, and rewrites
+ * the file through a temporary and a rename, so a reader always sees a
+ * whole snapshot. Nothing is computed for a reader; cat the file, or
+ * point a Prometheus node_exporter textfile collector at it:
+ *
+ *   airport_sim_time_seconds 36120
+ *   airport_wall_time_seconds 12.5
+ *   airport_events_total 412803
+ *   airport_events_per_second 33102.4
+ *   airport_queue_depth{queue="landing_queue"} 2
+ *   airport_queue_depth{queue="takeoff_queue"} 0
+ *   airport_tower_phase{phase="WAIT"} 1
+ *   airport_tower_pending{kind="landing"} 1
+ *   airport_tower_pending{kind="takeoff"} 0
+ *   airport_planes_in_system 14
+ *   airport_running 1
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef METRICS_PUBLISHER_HPP
+#define METRICS_PUBLISHER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// tower phases as they appear in the ControlTower state, index 0 if not known
+constexpr const char* METRICS_TOWER_PHASES[] = {"UNKNOWN", "IDLE", "SIGNAL", "WAIT"};
+
+struct AirportMetrics {
+    std::atomic<double> sim_time{0};
+    std::atomic<std::uint64_t> events{0};          // model transitions
+    std::atomic<std::int64_t> landing_queue{0};
+    std::atomic<std::int64_t> takeoff_queue{0};
+    std::atomic<int> tower_phase{0};               // index into METRICS_TOWER_PHASES
+    std::atomic<std::int64_t> pending_landings{0};
+    std::atomic<std::int64_t> pending_takeoffs{0};
+    std::atomic<std::int64_t> landed{0};           // planes cleared to land
+    std::atomic<std::int64_t> departed{0};         // planes off the runway after takeoff
+
+    // waiting to land, plus landed and not yet departed
+    [[nodiscard]] std::int64_t planesInSystem() const {
+        return landing_queue.load(std::memory_order_relaxed) + pending_landings.load(std::memory_order_relaxed) +
+               landed.load(std::memory_order_relaxed) - departed.load(std::memory_order_relaxed);
+    }
+};
+
+class MetricsPublisher {
+    std::string path;
+    std::chrono::milliseconds interval;
+    const AirportMetrics& metrics;
+    std::chrono::steady_clock::time_point started;
+    std::uint64_t last_events;
+    std::chrono::steady_clock::time_point last_time;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+
+    void publish(bool running) {
+        auto now = std::chrono::steady_clock::now();
+        std::uint64_t events = metrics.events.load(std::memory_order_relaxed);
+        double since = std::chrono::duration<double>(now - last_time).count();
+        double rate = since > 0 ? static_cast<double>(events - last_events) / since : 0.0;
+        last_events = events;
+        last_time = now;
+        int phase = metrics.tower_phase.load(std::memory_order_relaxed);
+
+        std::string temporary = path + ".tmp";
+        std::FILE* file = std::fopen(temporary.c_str(), "w");
+        if (file == nullptr) return;
+        std::fprintf(file, "airport_sim_time_seconds %.17g\n", metrics.sim_time.load(std::memory_order_relaxed));
+        std::fprintf(file, "airport_wall_time_seconds %.3f\n", std::chrono::duration<double>(now - started).count());
+        std::fprintf(file, "airport_events_total %llu\n", static_cast<unsigned long long>(events));
+        std::fprintf(file, "airport_events_per_second %.1f\n", rate);
+        std::fprintf(file, "airport_queue_depth{queue=\"landing_queue\"} %lld\n",
+                     static_cast<long long>(metrics.landing_queue.load(std::memory_order_relaxed)));
+        std::fprintf(file, "airport_queue_depth{queue=\"takeoff_queue\"} %lld\n",
+                     static_cast<long long>(metrics.takeoff_queue.load(std::memory_order_relaxed)));
+        std::fprintf(file, "airport_tower_phase{phase=\"%s\"} 1\n", METRICS_TOWER_PHASES[phase]);
+        std::fprintf(file, "airport_tower_pending{kind=\"landing\"} %lld\n",
+                     static_cast<long long>(metrics.pending_landings.load(std::memory_order_relaxed)));
+        std::fprintf(file, "airport_tower_pending{kind=\"takeoff\"} %lld\n",
+                     static_cast<long long>(metrics.pending_takeoffs.load(std::memory_order_relaxed)));
+        std::fprintf(file, "airport_planes_in_system %lld\n", static_cast<long long>(metrics.planesInSystem()));
+        std::fprintf(file, "airport_running %d\n", running ? 1 : 0);
+        bool written = std::fclose(file) == 0;
+        if (written) std::rename(temporary.c_str(), path.c_str());
+    }
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+            lock.unlock();
+            publish(true);
+            lock.lock();
+        }
+    }
+
+public:
+    MetricsPublisher(std::string path, std::chrono::milliseconds interval, const AirportMetrics& metrics)
+        : path(std::move(path)), interval(interval), metrics(metrics), started(), last_events(0), last_time(),
+          thread(), mutex(), wake(), stopping(false) {}
+
+    ~MetricsPublisher() { stop(); }
+
+    void start() {
+        started = last_time = std::chrono::steady_clock::now();
+        last_events = metrics.events.load(std::memory_order_relaxed);
+        publish(true);
+        thread = std::thread(&MetricsPublisher::loop, this);
+    }
+
+    // last snapshot has airport_running 0
+    void stop() {
+        if (!thread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        thread.join();
+        publish(false);
+    }
+};
+
+#endif // METRICS_PUBLISHER_HPP
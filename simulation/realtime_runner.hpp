@@ -0,0 +1,336 @@
+/*
+ * Real-Time Runner
+ *
+ * Drives a root coordinator against the wall clock instead of as fast
+ * as possible, so the airport can run as a live shadow of the tower.
+ * One simulated second takes 1/speed wall seconds.
+ *
+ * Arrivals come in live over a named pipe (FIFO) or a Unix domain
+ * socket, one per line:
+ *   now  plane_id [class priority fuel dwell]   arrives at the current time
+ *   time plane_id [class priority fuel dwell]   arrives at that simulation time
+ * Timestamps in the past are applied at once and counted as late. The
+ * runner waits in poll on the input with the next event's wall deadline
+ * as the timeout, so an arrival wakes it immediately. The last
+ * millisecond before a deadline is slept precisely instead, since poll
+ * only counts whole milliseconds. The runner steps the root coordinator
+ * itself, so its logger is set through the runner (setLogger), which
+ * holds the logger's lock around each step as RootCoordinator does.
+ *
+ * Measured and printed at the end:
+ *   - latency: wall time from reading an arrival (or its due time, if it
+ *     was stamped ahead) to the end of the transition that took it in, in us
+ *   - overruns: steps that started more than the tolerance after their
+ *     wall deadline, with the worst lag
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef REALTIME_RUNNER_HPP
+#define REALTIME_RUNNER_HPP
+
+#include <cadmium/simulation/root_coordinator.hpp>
+#include "../data_structures/pooled_port.hpp"
+#include "../data_structures/plane_message.hpp"
+#include "../data_structures/indexed_heap.hpp"
+#include "../data_structures/line_reader.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <poll.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+using namespace cadmium;
+
+struct RealTimeOptions {
+    double speed = 1.0;                 // simulated seconds per wall second
+    std::string fifo_path;              // read arrivals from this named pipe
+    std::string socket_path;            // or accept them on this Unix socket
+    double overrun_tolerance_us = 1000.0;
+};
+
+struct RealTimeReport {
+    unsigned long steps = 0;
+    unsigned long arrivals = 0;
+    unsigned long late_arrivals = 0;    // stamped before the current simulation time
+    unsigned long rejected_lines = 0;   // unparsable or longer than the line buffer
+    double latency_max_us = 0;
+    double latency_total_us = 0;
+    unsigned long overruns = 0;
+    double overrun_max_us = 0;
+};
+
+std::ostream& operator<<(std::ostream& out, const RealTimeReport& r) {
+    out << "Steps: " << r.steps << std::endl;
+    out << "Arrivals: " << r.arrivals << " (" << r.late_arrivals << " late, "
+        << r.rejected_lines << " rejected lines)" << std::endl;
+    if (r.arrivals > 0) {
+        out << "Arrival latency: mean " << r.latency_total_us / r.arrivals
+            << " us, max " << r.latency_max_us << " us" << std::endl;
+    }
+    out << "Overruns: " << r.overruns;
+    if (r.overruns > 0) out << " (worst " << r.overrun_max_us << " us behind)";
+    out << std::endl;
+    return out;
+}
+
+class RealTimeRunner {
+    using Clock = std::chrono::steady_clock;
+
+    // arrival waiting for its simulation time
+    struct Pending {
+        PlaneMsg plane;
+        Clock::time_point received;
+    };
+
+    RootCoordinator& root;
+    std::shared_ptr<Logger> logger;  // root's, locked around each step
+    PooledPort<PlaneMsg> inject;
+    RealTimeOptions options;
+    int listen_fd;
+    int input_fd;
+    int fifo_keepalive;  // our own writer end so the FIFO never reports EOF
+    LineReader reader;
+    IndexedHeap<Pending, double, std::less<double>> pending;
+    std::vector<Clock::time_point> injected_at;  // reused by step()
+    RealTimeReport report;
+    Clock::time_point wall_start;
+    double sim_start;
+
+    [[nodiscard]] Clock::time_point wallAt(double t) const {
+        return wall_start + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>((t - sim_start) / options.speed));
+    }
+
+    [[nodiscard]] double simNow() const {
+        return sim_start + std::chrono::duration<double>(Clock::now() - wall_start).count() * options.speed;
+    }
+
+    static void setNonBlocking(int fd) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    static double micros(Clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
+
+    // parse one input line into the pending arrivals
+    void accept(std::string_view line, Clock::time_point received) {
+        std::istringstream fields{std::string(line)};
+        std::string when;
+        PlaneMsg plane;
+        if (!(fields >> when) || !(fields >> plane)) {
+            if (line.find_first_not_of(" \t") != std::string_view::npos) report.rejected_lines++;
+            return;
+        }
+
+        double last = root.getTopCoordinator()->getTimeLast();
+        double t;
+        if (when == "now") {
+            t = simNow();
+        } else {
+            char* end = nullptr;
+            t = std::strtod(when.c_str(), &end);
+            if (end == when.c_str() || *end != '\0') {
+                report.rejected_lines++;
+                return;
+            }
+        }
+        double now = simNow();
+        if (t < now && when != "now") {
+            report.late_arrivals++;
+            t = now;
+        }
+        if (t < last) t = last;
+        stampArrival(plane, t);
+        pending.push(Pending{plane, received}, t);
+    }
+
+    void readInput() {
+        std::string_view line;
+        while (true) {
+            LineReader::Status status = reader.next(line);
+            if (status == LineReader::Status::LINE) {
+                accept(line, Clock::now());
+                continue;
+            }
+            if (status == LineReader::Status::END) {
+                // socket client left, wait for the next one
+                ::close(input_fd);
+                input_fd = -1;
+            }
+            break;
+        }
+    }
+
+    // one simulation step at t with every arrival due by then
+    void step(double t) {
+        Clock::time_point start = Clock::now();
+        double lag = micros(start - wallAt(t));
+        if (lag > options.overrun_tolerance_us) {
+            report.overruns++;
+            if (lag > report.overrun_max_us) report.overrun_max_us = lag;
+        }
+
+        // stamped-ahead arrivals count from their due time, not from when they were read
+        injected_at.clear();
+        while (!pending.empty() && pending.topKey() <= t) {
+            inject->addMessage(pending.top().plane);
+            injected_at.push_back(std::max(pending.top().received, wallAt(t)));
+            pending.pop();
+        }
+
+        // locked as in RootCoordinator::simulationAdvance, so loggers that read on
+        // another thread (the metrics publisher) see whole steps
+        auto top = root.getTopCoordinator();
+        if (logger != nullptr) logger->lock();
+        top->collection(t);
+        top->transition(t);
+        top->clear();
+        if (logger != nullptr) logger->unlock();
+        report.steps++;
+
+        Clock::time_point done = Clock::now();
+        for (const auto& received : injected_at) {
+            double latency = micros(done - received);
+            report.latency_total_us += latency;
+            if (latency > report.latency_max_us) report.latency_max_us = latency;
+        }
+        report.arrivals += injected_at.size();
+    }
+
+public:
+    inline static volatile std::sig_atomic_t interrupted = 0;
+
+    RealTimeRunner(RootCoordinator& root, PooledPort<PlaneMsg> inject, const RealTimeOptions& options)
+        : root(root), logger(), inject(std::move(inject)), options(options),
+          listen_fd(-1), input_fd(-1), fifo_keepalive(-1), reader(-1),
+          pending(), injected_at(), report(), wall_start(), sim_start(0) {}
+
+    // set the root coordinator's logger through the runner, which steps the root itself
+    void setLogger(const std::shared_ptr<Logger>& log) {
+        logger = log;
+        root.setLogger(log);
+    }
+
+    template <typename T, typename... Args>
+    void setLogger(Args&&... args) {
+        setLogger(std::make_shared<T>(std::forward<Args>(args)...));
+    }
+
+    ~RealTimeRunner() {
+        if (input_fd >= 0) ::close(input_fd);
+        if (fifo_keepalive >= 0) ::close(fifo_keepalive);
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+            ::unlink(options.socket_path.c_str());
+        }
+    }
+
+    // create the FIFO or socket, false with a message on failure
+    bool open() {
+        if (!options.fifo_path.empty()) {
+            if (::mkfifo(options.fifo_path.c_str(), 0666) != 0 && errno != EEXIST) {
+                std::cerr << "Error: cannot create FIFO " << options.fifo_path << ": " << std::strerror(errno) << std::endl;
+                return false;
+            }
+            input_fd = ::open(options.fifo_path.c_str(), O_RDONLY | O_NONBLOCK);
+            if (input_fd >= 0) fifo_keepalive = ::open(options.fifo_path.c_str(), O_WRONLY | O_NONBLOCK);
+            if (input_fd < 0 || fifo_keepalive < 0) {
+                std::cerr << "Error: cannot open FIFO " << options.fifo_path << ": " << std::strerror(errno) << std::endl;
+                return false;
+            }
+            reader.reset(input_fd);
+            return true;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (options.socket_path.empty() || options.socket_path.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "Error: real-time mode needs a FIFO or socket path" << std::endl;
+            return false;
+        }
+        std::strncpy(addr.sun_path, options.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+        ::unlink(options.socket_path.c_str());
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd >= 0) setNonBlocking(listen_fd);
+        if (listen_fd < 0 || ::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listen_fd, 4) != 0) {
+            std::cerr << "Error: cannot listen on " << options.socket_path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // run until sim_time has passed on the wall clock or SIGINT
+    RealTimeReport run(double sim_time) {
+        auto top = root.getTopCoordinator();
+        sim_start = top->getTimeLast();
+        wall_start = Clock::now();
+        double sim_end = sim_start + sim_time;
+
+        while (!interrupted) {
+            double next = top->getTimeNext();
+            if (!pending.empty() && pending.topKey() < next) next = pending.topKey();
+            double deadline = std::min(next, sim_end);
+
+            // events already due run without waiting
+            if (next < sim_end && wallAt(next) <= Clock::now()) {
+                step(next);
+                continue;
+            }
+            if (deadline >= sim_end && simNow() >= sim_end) break;
+
+            // wait for input or the next deadline
+            pollfd fds[2];
+            nfds_t count = 0;
+            if (input_fd >= 0) fds[count++] = pollfd{input_fd, POLLIN, 0};
+            else if (listen_fd >= 0) fds[count++] = pollfd{listen_fd, POLLIN, 0};
+
+            int timeout_ms = -1;
+            if (deadline < std::numeric_limits<double>::infinity()) {
+                Clock::time_point wake = wallAt(deadline);
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(wake - Clock::now());
+                if (wait.count() < 2) {
+                    std::this_thread::sleep_until(wake);
+                    continue;
+                }
+                timeout_ms = static_cast<int>(wait.count()) - 1;
+            }
+
+            int ready = ::poll(fds, count, timeout_ms);
+            if (ready <= 0) continue;
+
+            if (input_fd < 0 && listen_fd >= 0) {
+                int client = ::accept(listen_fd, nullptr, nullptr);
+                if (client >= 0) {
+                    setNonBlocking(client);
+                    input_fd = client;
+                    reader.reset(client);
+                }
+            } else if (fds[0].revents != 0) {
+                readInput();
+            }
+        }
+        report.rejected_lines += reader.droppedLines();
+        return report;
+    }
+};
+
+#endif // REALTIME_RUNNER_HPP
@@ -0,0 +1,190 @@
+/*
+ * Result Cache
+ *
+ * Content-addressed store of finished batch runs, so rerunning an
+ * experiment whose inputs and model have not changed copies its log back
+ * instead of simulating it again.
+ *
+ * A RunKey is the text of everything the log depends on, one
+ * "name value" line each: the contents of the input file (and topology
+ * file) by hash, the simulation time, every airport option, the kind of
+ * log, and the model version. The model version is the hash of the
+ * simulator executable itself (/proc/self/exe), so any rebuild that
+ * changes the code misses the cache, while `make clean` and a rebuild of
+ * the same sources (which gives the same binary) still hits it. The entry
+ * is the directory named by the key's 64-bit hash under the cache root,
+ * with:
+ *
+ *   summary.txt   the key text, then "seconds S" (time the run took)
+ *                 and "bytes N" (size of the log)
+ *   log           the log file as the run wrote it
+ *
+ * restore() only accepts an entry whose summary holds exactly the same
+ * key text and whose log has the recorded size, so a hash collision or
+ * an entry cut short reads as a miss, and removes such an entry so the
+ * next store() can replace it. store() writes the entry under a
+ * temporary name and renames it into place, so concurrent runs of the
+ * same key never see half an entry.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include "../loggers/fingerprint_logger.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+// FNV-1a over the file's 8-byte words (then its last bytes); false if unreadable
+inline bool hashFile(const std::string& path, std::uint64_t& hash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    hash = FNV_OFFSET_BASIS;
+    char buffer[1 << 16];
+    while (in) {
+        in.read(buffer, sizeof(buffer));
+        std::size_t n = static_cast<std::size_t>(in.gcount());
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, buffer + i, 8);
+            hash = (hash ^ word) * FNV_PRIME;
+        }
+        for (; i < n; i++) hash = (hash ^ static_cast<unsigned char>(buffer[i])) * FNV_PRIME;
+    }
+    return !in.bad();
+}
+
+inline std::string hex16(std::uint64_t value) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << value;
+    return out.str();
+}
+
+// everything a run's log depends on, as "name value" lines
+class RunKey {
+    std::string lines;
+    bool readable = true;
+
+public:
+    RunKey& add(const std::string& name, const std::string& value) {
+        lines += name + " " + value + "\n";
+        return *this;
+    }
+
+    RunKey& add(const std::string& name, double value) {
+        std::ostringstream text;
+        text << std::setprecision(17) << value;
+        return add(name, text.str());
+    }
+
+    // a file by the hash of its contents; the key is invalid if it cannot be read
+    RunKey& addFile(const std::string& name, const std::string& path) {
+        std::uint64_t hash = 0;
+        if (!hashFile(path, hash)) readable = false;
+        return add(name, hex16(hash));
+    }
+
+    [[nodiscard]] bool valid() const { return readable; }
+    [[nodiscard]] const std::string& text() const { return lines; }
+
+    [[nodiscard]] std::uint64_t hash() const {
+        std::uint64_t h = FNV_OFFSET_BASIS;
+        for (char c : lines) h = (h ^ static_cast<unsigned char>(c)) * FNV_PRIME;
+        return h;
+    }
+};
+
+struct CachedRun {
+    std::string directory;
+    double seconds = 0;  // what the run took when it was stored
+};
+
+class ResultCache {
+    std::string root;
+
+    static bool copyFile(const std::string& from, const std::string& to) {
+        std::ifstream in(from, std::ios::binary);
+        std::ofstream out(to, std::ios::binary | std::ios::trunc);
+        if (!in || !out) return false;
+        if (in.peek() != std::ifstream::traits_type::eof()) out << in.rdbuf();
+        return static_cast<bool>(out.flush());
+    }
+
+    static void removeEntry(const std::string& directory) {
+        std::remove((directory + "/log").c_str());
+        std::remove((directory + "/summary.txt").c_str());
+        ::rmdir(directory.c_str());
+    }
+
+public:
+    explicit ResultCache(std::string root = "simulation_cache") : root(std::move(root)) {}
+
+    [[nodiscard]] std::string entry(const RunKey& key) const { return root + "/" + hex16(key.hash()); }
+
+    // copy the cached log of key to log_file, false on a miss
+    bool restore(const RunKey& key, const std::string& log_file, CachedRun& cached) const {
+        std::string directory = entry(key);
+        std::ifstream summary(directory + "/summary.txt");
+        if (!summary) return false;
+        std::string text(key.text().size(), '\0');
+        if (!summary.read(&text[0], static_cast<std::streamsize>(text.size())) || text != key.text()) {
+            removeEntry(directory);
+            return false;
+        }
+
+        double seconds = -1;
+        long long bytes = -1;
+        std::string name;
+        while (summary >> name) {
+            if (name == "seconds") summary >> seconds;
+            else if (name == "bytes") summary >> bytes;
+        }
+        struct stat log_stat;
+        if (bytes < 0 || ::stat((directory + "/log").c_str(), &log_stat) != 0 || log_stat.st_size != bytes) {
+            removeEntry(directory);
+            return false;
+        }
+        if (!copyFile(directory + "/log", log_file)) return false;
+        cached.directory = directory;
+        cached.seconds = seconds;
+        return true;
+    }
+
+    // keep log_file as the result of key, false if the entry could not be written
+    bool store(const RunKey& key, const std::string& log_file, double seconds) const {
+        struct stat log_stat;
+        if (::stat(log_file.c_str(), &log_stat) != 0) return false;
+        if (::mkdir(root.c_str(), 0755) != 0 && errno != EEXIST) return false;
+        std::string directory = entry(key);
+        std::string temporary = directory + ".tmp" + std::to_string(::getpid());
+        if (::mkdir(temporary.c_str(), 0755) != 0) return false;
+
+        bool written = copyFile(log_file, temporary + "/log");
+        std::ofstream summary(temporary + "/summary.txt");
+        summary << key.text() << "seconds " << seconds << "\nbytes " << log_stat.st_size << "\n";
+        written = written && static_cast<bool>(summary.flush());
+        summary.close();
+        // rename() cannot replace a non-empty directory; an entry still there
+        // is the same result stored by another run since restore() missed
+        if (!written || std::rename(temporary.c_str(), directory.c_str()) != 0) {
+            removeEntry(temporary);
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif // RESULT_CACHE_HPP
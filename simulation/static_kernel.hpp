@@ -0,0 +1,330 @@
+/*
+ * Static Kernel
+ *
+ * Simulation kernel for a topology fixed at compile time. The models are a
+ * type list, the couplings a list of Link<from, &From::port, to, &To::port>
+ * between model indexes, so routing a message is a direct bag-to-bag copy
+ * the compiler can see through, and every output / transition / timeAdvance
+ * is a qualified (non-virtual) call on a model of known type. The atomics
+ * are the regular Cadmium ones and run their own code unchanged; the kernel
+ * keeps all their states side by side in one tuple and passes them in, the
+ * copy inside each atomic is only the initial state.
+ *
+ * A topology lists only atomics: coupled models are flattened by hand, each
+ * chain of IC / EIC / EOC becoming one Link. Topologies compose with Join
+ * (see coupled/staticAirport.hpp). Bags fill in Link order, so a port fed
+ * by more than one Link must list them in the order Cadmium routes them.
+ *
+ * The Cadmium model of the same structure is passed in as a reference and
+ * walked once, to give every atomic its Cadmium model id and to log in the
+ * same order as RootCoordinator; its atomics are never run. With that the
+ * kernel is a drop-in for RootCoordinator (start / simulate / stop /
+ * setLogger) and gives the same trace.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef STATIC_KERNEL_HPP
+#define STATIC_KERNEL_HPP
+
+#include <cadmium/modeling/devs/atomic.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+#include <cadmium/simulation/logger/logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// the atomics of a topology, by index
+template <typename... Models>
+struct ModelList {};
+
+// coupling from an output port of model From to an input port of model To
+template <std::size_t From, auto FromPort, std::size_t To, auto ToPort>
+struct Link {};
+
+template <typename... Links>
+struct LinkList {};
+
+template <typename Models, typename Links>
+struct Topology {
+    using models = Models;
+    using links = Links;
+};
+
+// concatenates two ModelLists or two LinkLists
+template <typename A, typename B>
+struct JoinLists;
+
+template <template <typename...> class List, typename... A, typename... B>
+struct JoinLists<List<A...>, List<B...>> {
+    using type = List<A..., B...>;
+};
+
+// the models and links of B after those of A, B's indexes must already count A's models
+template <typename A, typename B>
+using Join = Topology<typename JoinLists<typename A::models, typename B::models>::type,
+                      typename JoinLists<typename A::links, typename B::links>::type>;
+
+// state type of a Cadmium atomic
+template <typename S>
+S atomicStateOf(const cadmium::Atomic<S>&);
+
+template <typename M>
+using AtomicState = decltype(atomicStateOf(std::declval<const M&>()));
+
+// class a pointer to member belongs to
+template <typename P>
+struct MemberClass;
+
+template <typename C, typename T>
+struct MemberClass<T C::*> {
+    using type = C;
+};
+
+// an atomic built in place from a tuple of constructor arguments, its
+// initial state readable by the kernel
+template <typename M>
+class StaticModel final : public M {
+    template <typename Args, std::size_t... I>
+    StaticModel(const Args& args, std::index_sequence<I...>) : M(std::get<I>(args)...) {}
+
+public:
+    using Model = M;
+
+    template <typename... Args>
+    explicit StaticModel(const std::tuple<Args...>& args) : StaticModel(args, std::index_sequence_for<Args...>()) {}
+
+    [[nodiscard]] const AtomicState<M>& initialState() const { return this->state; }
+};
+
+// Topo is a Topology, or a part deriving from one
+template <typename Topo, typename Models = typename Topo::models, typename Links = typename Topo::links>
+class StaticKernel;
+
+template <typename Topo, typename... Ms, typename... Ls>
+class StaticKernel<Topo, ModelList<Ms...>, LinkList<Ls...>> {
+    static constexpr std::size_t N = sizeof...(Ms);
+    using Indexes = std::index_sequence_for<Ms...>;
+
+    template <std::size_t I>
+    using ModelAt = std::tuple_element_t<I, std::tuple<Ms...>>;
+
+    std::tuple<StaticModel<Ms>...> models;
+    std::tuple<AtomicState<Ms>...> states;  // every model's state, in one place
+    std::array<double, N> model_time_last;
+    std::array<double, N> model_time_next;
+    std::array<bool, N> imminent;           // this step
+    std::array<bool, N> received;           // got input this step
+    std::array<long, N> ids;                // Cadmium model ids
+    std::vector<std::size_t> log_order;     // indexes in Cadmium's order
+    std::shared_ptr<cadmium::Logger> logger;
+    double time_last;
+    double time_next;
+
+    template <std::size_t I>
+    StaticModel<ModelAt<I>>& model() { return std::get<I>(models); }
+
+    template <std::size_t I>
+    AtomicState<ModelAt<I>>& state() { return std::get<I>(states); }
+
+    template <std::size_t... I>
+    std::tuple<AtomicState<Ms>...> initialStates(std::index_sequence<I...>) const {
+        return std::tuple<AtomicState<Ms>...>(std::get<I>(models).initialState()...);
+    }
+
+    template <std::size_t I>
+    double timeAdvance() {
+        using M = ModelAt<I>;
+        return model<I>().M::timeAdvance(state<I>());
+    }
+
+    template <std::size_t I>
+    void output(double time) {
+        imminent[I] = time >= model_time_next[I];
+        received[I] = false;
+        using M = ModelAt<I>;
+        if (imminent[I]) model<I>().M::output(state<I>());
+    }
+
+    template <std::size_t From, auto FromPort, std::size_t To, auto ToPort>
+    void route(Link<From, FromPort, To, ToPort>) {
+        static_assert(From < N && To < N, "link to a model outside the topology");
+        static_assert(std::is_base_of_v<typename MemberClass<decltype(FromPort)>::type, ModelAt<From>>,
+                      "link source port is not a port of the source model");
+        static_assert(std::is_base_of_v<typename MemberClass<decltype(ToPort)>::type, ModelAt<To>>,
+                      "link target port is not a port of the target model");
+        const auto& from = model<From>().*FromPort;
+        if (from->empty()) return;
+        const auto& to = model<To>().*ToPort;
+        for (const auto& message : from->getBag()) to->addMessage(message);
+        received[To] = true;
+    }
+
+    template <std::size_t I>
+    void transition(double time) {
+        if (!imminent[I] && !received[I]) return;
+        using M = ModelAt<I>;
+        auto& m = model<I>();
+        auto& s = state<I>();
+        if (!received[I]) {
+            m.M::internalTransition(s);
+        } else if (imminent[I]) {
+            m.M::confluentTransition(s, time - model_time_last[I]);
+        } else {
+            m.M::externalTransition(s, time - model_time_last[I]);
+        }
+        model_time_last[I] = time;
+        model_time_next[I] = time + timeAdvance<I>();
+    }
+
+    template <std::size_t I>
+    void logModel(double time, bool outputs) {
+        auto& m = model<I>();
+        if (outputs) {
+            for (const auto& port : m.getOutPorts()) {
+                for (std::size_t k = 0; k < port->size(); k++) {
+                    logger->logOutput(time, ids[I], m.getId(), port->getId(), port->logMessage(k));
+                }
+            }
+        }
+        std::ostringstream text;
+        text << state<I>();
+        logger->logState(time, ids[I], m.getId(), text.str());
+    }
+
+    // model i, picked at run time for the logger
+    template <std::size_t... I>
+    void logAt(std::size_t i, double time, bool outputs, std::index_sequence<I...>) {
+        using LogFn = void (StaticKernel::*)(double, bool);
+        static constexpr LogFn log[] = {&StaticKernel::logModel<I>...};
+        (this->*log[i])(time, outputs);
+    }
+
+    template <std::size_t I>
+    void clear() {
+        if (imminent[I] || received[I]) model<I>().clearPorts();
+    }
+
+    template <std::size_t... I>
+    void advance(double time, std::index_sequence<I...>) {
+        if (logger != nullptr) logger->lock();
+        (output<I>(time), ...);
+        (route(Ls()), ...);
+        (transition<I>(time), ...);
+        if (logger != nullptr) {
+            for (std::size_t i : log_order) {
+                if (imminent[i] || received[i]) logAt(i, time, imminent[i], Indexes());
+            }
+        }
+        (clear<I>(), ...);
+        time_last = time;
+        time_next = *std::min_element(model_time_next.begin(), model_time_next.end());
+        if (logger != nullptr) logger->unlock();
+    }
+
+    void logStates() {
+        for (std::size_t i : log_order) logAt(i, time_last, false, Indexes());
+    }
+
+    template <std::size_t... I>
+    std::size_t indexOf(const std::string& name, std::index_sequence<I...>) const {
+        std::size_t index = N;
+        ((index = (index == N && std::get<I>(models).getId() == name) ? I : index), ...);
+        return index;
+    }
+
+    // same id order as Coordinator::setModelId
+    long bind(const cadmium::Coupled& coupled, long next) {
+        next++;
+        for (const auto& [name, component] : coupled.getComponents()) {
+            if (auto child = std::dynamic_pointer_cast<cadmium::Coupled>(component)) {
+                next = bind(*child, next);
+            } else {
+                std::size_t index = indexOf(component->getId(), Indexes());
+                if (index == N) {
+                    throw cadmium::CadmiumSimulationException("static kernel has no model " + component->getId());
+                }
+                ids[index] = next++;
+                log_order.push_back(index);
+            }
+        }
+        return next;
+    }
+
+    template <std::size_t... I>
+    void initialSchedule(double time, std::index_sequence<I...>) {
+        ((model_time_next[I] = time + timeAdvance<I>()), ...);
+    }
+
+    template <typename Args, std::size_t... I>
+    StaticKernel(const cadmium::Coupled& reference, const Args& args, double time, std::index_sequence<I...>)
+        : models(std::get<I>(args)...), states(initialStates(Indexes())), model_time_last(), model_time_next(),
+          imminent(), received(), ids(), log_order(), logger(), time_last(time),
+          time_next(std::numeric_limits<double>::infinity()) {
+        model_time_last.fill(time);
+        imminent.fill(false);
+        received.fill(false);
+        ids.fill(-1);
+        initialSchedule(time, Indexes());
+        bind(reference, 0);
+        if (log_order.size() != N) {
+            throw cadmium::CadmiumSimulationException("static kernel and reference model have different atomics");
+        }
+        time_next = *std::min_element(model_time_next.begin(), model_time_next.end());
+    }
+
+public:
+    // args holds one tuple of constructor arguments per model, in list order
+    template <typename... Args>
+    StaticKernel(const cadmium::Coupled& reference, const std::tuple<Args...>& args, double time = 0)
+        : StaticKernel(reference, args, time, Indexes()) {
+        static_assert(sizeof...(Args) == N, "one argument tuple per model");
+    }
+
+    StaticKernel(const StaticKernel&) = delete;
+    StaticKernel& operator=(const StaticKernel&) = delete;
+
+    [[nodiscard]] double getTimeLast() const { return time_last; }
+    [[nodiscard]] double getTimeNext() const { return time_next; }
+    [[nodiscard]] static constexpr std::size_t atomicCount() { return N; }
+
+    void setLogger(const std::shared_ptr<cadmium::Logger>& log) { logger = log; }
+
+    template <typename T, typename... Args>
+    void setLogger(Args&&... args) {
+        setLogger(std::make_shared<T>(std::forward<Args>(args)...));
+    }
+
+    void start() {
+        if (logger == nullptr) return;
+        logger->start();
+        logStates();
+    }
+
+    void stop() {
+        if (logger == nullptr) return;
+        logStates();
+        logger->stop();
+    }
+
+    void simulate(long iterations) {
+        while (iterations-- > 0 && time_next < std::numeric_limits<double>::infinity()) advance(time_next, Indexes());
+    }
+
+    void simulate(double interval) {
+        double time_final = time_last + interval;
+        while (time_next < time_final) advance(time_next, Indexes());
+    }
+};
+
+#endif // STATIC_KERNEL_HPP
@@ -0,0 +1,489 @@
+/*
+ * What-If Server
+ *
+ * Long-lived server that answers scenario requests on a Unix domain
+ * socket, so tools asking "what if traffic doubles" or "what if the
+ * queues hold four planes" skip process start and model construction.
+ * Every worker thread keeps its own warm airports, built once and reset
+ * in place for each request (PlaneGenerator::resetFromText and
+ * AirportTop::reset), each with its own FlatCoordinator. The tower
+ * scheduling and the hangar model change the model structure, so a
+ * worker keeps one warm airport per structure, building it on first use.
+ *
+ * A request is a block of lines ended by "end" or a blank line:
+ *   options --tower=priority --dwell=600 ...   airport options, as on the command line
+ *   poisson RATE PLANES [SEED]                 Poisson arrivals, RATE per hour (seed 1)
+ *   time SECONDS                               simulation time (default 36000)
+ *   reply metrics|fingerprint                  what to answer (default metrics)
+ *   time plane_id [class priority fuel dwell]  an arrival, as in the input files
+ * Options apply on top of the ones the server was started with. The
+ * answer is one line, either
+ *   ok arrivals=N departures=N runway_ops=N landing_wait=S takeoff_wait=S time_in_system=S us=T
+ * with mean waits per departed plane (see PlaneTimingLogger), or
+ *   ok records=N hash=HEX time=S us=T
+ * with the trace fingerprint of the run (see FingerprintLogger), equal to
+ * --fingerprint on the same input and options; us is the time taken to
+ * reset and simulate. A bad request is answered "error MESSAGE". A client
+ * may send any number of requests on one connection.
+ *
+ * The thread that accepts clients also reads their requests, from every
+ * connection at once, and puts each whole request on a queue for the
+ * worker threads; so up to `workers` requests run at once, however many
+ * clients are connected. A client's next request is read only once its
+ * previous answer has been sent, so answers come back in order.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef WHAT_IF_SERVER_HPP
+#define WHAT_IF_SERVER_HPP
+
+#include <cadmium/modeling/devs/coupled.hpp>
+
+#include "../atomics/planeGenerator.hpp"
+#include "../coupled/airportTop.hpp"
+#include "../data_structures/line_reader.hpp"
+#include "../loggers/fingerprint_logger.hpp"
+#include "../loggers/plane_timing_logger.hpp"
+#include "airport_estimator.hpp"
+#include "flat_coordinator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <poll.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace cadmium;
+
+// same structure and names as AirportSimulation in top_model/main.cpp, arrivals from memory
+class ServedAirport : public Coupled {
+    std::shared_ptr<PlaneGenerator> generator;
+    std::shared_ptr<AirportTop> airport;
+
+public:
+    PooledPort<PlaneMsg> out_takeoff;
+
+    ServedAirport(const std::string& id, const AirportConfig& config) : Coupled(id) {
+        out_takeoff = addPooledOutPort<PlaneMsg>(this, "out_takeoff");
+
+        generator = addComponent<PlaneGenerator>("Generator", "/dev/null");
+        airport = addComponent<AirportTop>("Airport", config);
+
+        addCoupling(generator->out, airport->in_landing);
+        addCoupling(airport->out_takeoff, out_takeoff);
+    }
+
+    void reset(std::string arrivals, const AirportConfig& config) {
+        generator->resetFromText(std::move(arrivals));
+        airport->reset(config);
+    }
+};
+
+struct WhatIfRequest {
+    AirportConfig config;
+    std::string arrivals;       // input file lines
+    bool poisson = false;       // arrivals were generated by a poisson line
+    double sim_time = 36000.0;
+    bool fingerprint = false;
+};
+
+// apply one request line, false with a message if it is not understood
+inline bool parseRequestLine(std::string_view line, WhatIfRequest& request, std::string& error) {
+    std::istringstream fields{std::string(line)};
+    std::string word;
+    fields >> word;
+    if (word == "options") {
+        std::string option;
+        while (fields >> option) {
+            bool known = false;
+            try {
+                known = parseAirportOption(option, request.config);
+            } catch (const std::exception&) {
+            }
+            if (!known) {
+                error = "bad option " + option;
+                return false;
+            }
+        }
+    } else if (word == "poisson") {
+        double rate = 0;
+        int planes = 0;
+        std::uint64_t seed = 1;
+        if (!(fields >> rate >> planes) || rate <= 0 || planes < 0) {
+            error = "poisson needs a positive RATE and PLANES";
+            return false;
+        }
+        fields >> seed;
+        if (!request.arrivals.empty()) {
+            error = "poisson and arrival lines in one request";
+            return false;
+        }
+        request.arrivals = poissonArrivals(rate, planes, seed);
+        request.poisson = true;
+    } else if (word == "time") {
+        if (!(fields >> request.sim_time) || request.sim_time < 0) {
+            error = "time needs SECONDS";
+            return false;
+        }
+    } else if (word == "reply") {
+        fields >> word;
+        if (word != "metrics" && word != "fingerprint") {
+            error = "reply must be metrics or fingerprint";
+            return false;
+        }
+        request.fingerprint = (word == "fingerprint");
+    } else {
+        double time;
+        PlaneMsg plane;
+        if (!parsePlaneLine(line, time, plane)) {
+            error = "cannot read line: " + std::string(line.substr(0, 64));
+            return false;
+        }
+        if (request.poisson) {
+            error = "poisson and arrival lines in one request";
+            return false;
+        }
+        request.arrivals.append(line.data(), line.size());
+        request.arrivals.push_back('\n');
+    }
+    return true;
+}
+
+// one worker's airports, one per model structure, each reset in place for every request
+class WarmAirports {
+    struct Warm {
+        TowerScheduling scheduling;
+        HangarModel hangar;
+        std::shared_ptr<ServedAirport> model;
+        std::unique_ptr<FlatCoordinator> coordinator;
+    };
+
+    std::vector<Warm> warm;
+
+    Warm& airport(const AirportConfig& config) {
+        for (auto& w : warm) {
+            if (w.scheduling == config.scheduling && w.hangar == config.hangar) return w;
+        }
+        auto model = std::make_shared<ServedAirport>("AirportSimulation", config);
+        auto coordinator = std::make_unique<FlatCoordinator>(model);
+        warm.push_back(Warm{config.scheduling, config.hangar, std::move(model), std::move(coordinator)});
+        return warm.back();
+    }
+
+public:
+    explicit WarmAirports(const AirportConfig& config) : warm() { airport(config); }
+
+    // run the request and return the answer line, without its newline; a config
+    // airportConfigError refuses throws
+    std::string answer(WhatIfRequest& request) {
+        auto start = std::chrono::steady_clock::now();
+        // refused before any warm airport is touched, so a bad request cannot spoil the next
+        std::string error = airportConfigError(request.config);
+        if (!error.empty()) throw CadmiumModelException(error);
+        Warm& w = airport(request.config);
+        w.model->reset(std::move(request.arrivals), request.config);
+        w.coordinator->reset();
+
+        auto fingerprint = std::make_shared<TraceFingerprint>();
+        auto timings = std::make_shared<PlaneTimings>();
+        if (request.fingerprint) {
+            w.coordinator->setLogger<FingerprintLogger>(fingerprint);
+        } else {
+            w.coordinator->setLogger<PlaneTimingLogger>(timings);
+        }
+        w.coordinator->setLogStates(request.fingerprint);
+        w.coordinator->start();
+        w.coordinator->simulate(request.sim_time);
+        w.coordinator->stop();
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        std::ostringstream reply;
+        reply << "ok ";
+        if (request.fingerprint) {
+            reply << "records=" << fingerprint->records << " hash=" << std::hex << std::setw(16) << std::setfill('0')
+                  << fingerprint->hash << std::dec << " time=" << fingerprint->time;
+        } else {
+            double departed = timings->departures > 0 ? static_cast<double>(timings->departures) : 1.0;
+            reply << "arrivals=" << timings->arrivals << " departures=" << timings->departures
+                  << " runway_ops=" << timings->runway_operations
+                  << " landing_wait=" << timings->landing_wait / departed
+                  << " takeoff_wait=" << timings->takeoff_wait / departed
+                  << " time_in_system=" << timings->time_in_system / departed;
+        }
+        reply << " us=" << static_cast<long>(us);
+        return reply.str();
+    }
+};
+
+struct WhatIfOptions {
+    std::string socket_path;
+    unsigned workers = 1;
+    AirportConfig config;  // request options apply on top of this
+};
+
+struct WhatIfReport {
+    unsigned long connections = 0;
+    unsigned long requests = 0;
+    unsigned long errors = 0;
+};
+
+std::ostream& operator<<(std::ostream& out, const WhatIfReport& r) {
+    out << "Connections: " << r.connections << std::endl;
+    out << "Requests: " << r.requests << " (" << r.errors << " errors)" << std::endl;
+    return out;
+}
+
+class WhatIfServer {
+    // a client, read only by the accepting thread
+    struct Connection {
+        LineReader reader;
+        WhatIfRequest request;
+        std::string error;      // first bad line of the request being read
+        bool empty = true;      // no line of the next request read yet
+        bool busy = false;      // a request of this client is with the workers
+        bool closed = false;    // client closed its end
+
+        explicit Connection(int fd) : reader(fd), request(), error() {}
+    };
+
+    // a whole request, answered by a worker
+    struct Job {
+        int fd;
+        WhatIfRequest request;
+        std::string error;
+    };
+
+    WhatIfOptions options;
+    int listen_fd;
+    int wake[2];  // workers wake the accepting thread when a client is free again
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Job> jobs;
+    std::vector<int> done;  // clients whose answer was sent
+    std::atomic<bool> stopping;
+    std::atomic<unsigned long> requests;
+    std::atomic<unsigned long> errors;
+    unsigned long accepted;
+
+    static void setNonBlocking(int fd) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    // the whole reply, waiting for room on the non-blocking socket
+    bool send(int fd, const std::string& reply) {
+        std::size_t sent = 0;
+        while (sent < reply.size()) {
+            ssize_t n = ::send(fd, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+            if (n > 0) {
+                sent += static_cast<std::size_t>(n);
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && !stopping) {
+                pollfd out{fd, POLLOUT, 0};
+                ::poll(&out, 1, 100);
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void submit(int fd, Connection& c) {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(Job{fd, std::move(c.request), std::move(c.error)});
+        ready.notify_one();
+        c.request = WhatIfRequest();
+        c.request.config = options.config;
+        c.error.clear();
+        c.empty = true;
+        c.busy = true;
+    }
+
+    // read the client's lines up to its next whole request; false once it
+    // has left and can be closed
+    bool read(int fd, Connection& c) {
+        std::string_view line;
+        while (!c.busy && !c.closed) {
+            LineReader::Status status = c.reader.next(line);
+            if (status == LineReader::Status::AGAIN) break;
+            if (status == LineReader::Status::END) {
+                // a request cut short by the client closing its end is still answered
+                c.closed = true;
+                if (!c.empty) submit(fd, c);
+                break;
+            }
+            if (line.find_first_not_of(" \t") != std::string_view::npos && line != "end") {
+                if (c.error.empty()) parseRequestLine(line, c.request, c.error);
+                c.empty = false;
+            } else if (!c.empty) {
+                submit(fd, c);
+            }
+        }
+        return !(c.closed && !c.busy);
+    }
+
+    void work() {
+        WarmAirports airports(options.config);
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (stopping) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            std::string reply;
+            if (job.error.empty()) {
+                try {
+                    reply = airports.answer(job.request);
+                } catch (const std::exception& e) {
+                    job.error = e.what();
+                }
+            }
+            requests++;
+            if (!job.error.empty()) {
+                errors++;
+                reply = "error " + job.error;
+            }
+            send(job.fd, reply + "\n");
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.push_back(job.fd);
+            }
+            char byte = 0;
+            ssize_t ignored = ::write(wake[1], &byte, 1);
+            (void)ignored;
+        }
+    }
+
+    void close(int fd) {
+        ::close(fd);
+        connections.erase(fd);
+    }
+
+public:
+    inline static volatile std::sig_atomic_t interrupted = 0;
+
+    explicit WhatIfServer(const WhatIfOptions& options)
+        : options(options), listen_fd(-1), wake{-1, -1}, connections(), mutex(), ready(), jobs(), done(),
+          stopping(false), requests(0), errors(0), accepted(0) {}
+
+    ~WhatIfServer() {
+        for (const auto& c : connections) ::close(c.first);
+        for (int fd : wake) {
+            if (fd >= 0) ::close(fd);
+        }
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+            ::unlink(options.socket_path.c_str());
+        }
+    }
+
+    WhatIfServer(const WhatIfServer&) = delete;
+    WhatIfServer& operator=(const WhatIfServer&) = delete;
+
+    // create the socket, false with a message on failure
+    bool open() {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (options.socket_path.empty() || options.socket_path.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "Error: the server needs a socket path" << std::endl;
+            return false;
+        }
+        std::strncpy(addr.sun_path, options.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+        ::unlink(options.socket_path.c_str());
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0 || ::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listen_fd, 64) != 0 || ::pipe(wake) != 0) {
+            std::cerr << "Error: cannot listen on " << options.socket_path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        setNonBlocking(listen_fd);
+        setNonBlocking(wake[0]);
+        return true;
+    }
+
+    // ask run() to return, from another thread
+    void stop() { stopping = true; }
+
+    // accept clients and read their requests until stop() or SIGINT; the
+    // workers build their airports while the first clients connect
+    WhatIfReport run() {
+        std::vector<std::thread> workers;
+        for (unsigned i = 0; i < std::max(1u, options.workers); i++) workers.emplace_back([this] { work(); });
+
+        std::vector<pollfd> fds;
+        std::vector<int> finished;
+        while (!stopping && !interrupted) {
+            fds.clear();
+            fds.push_back(pollfd{listen_fd, POLLIN, 0});
+            fds.push_back(pollfd{wake[0], POLLIN, 0});
+            for (const auto& c : connections) {
+                if (!c.second->busy) fds.push_back(pollfd{c.first, POLLIN, 0});
+            }
+            if (::poll(fds.data(), fds.size(), 100) <= 0) continue;
+
+            for (std::size_t i = 2; i < fds.size(); i++) {
+                if (fds[i].revents != 0 && !read(fds[i].fd, *connections[fds[i].fd])) close(fds[i].fd);
+            }
+            if (fds[1].revents != 0) {
+                char bytes[64];
+                while (::read(wake[0], bytes, sizeof(bytes)) > 0) {
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished.swap(done);
+                }
+                // the next request may already be buffered, poll would not report it
+                for (int fd : finished) {
+                    Connection& c = *connections[fd];
+                    c.busy = false;
+                    if (!read(fd, c)) close(fd);
+                }
+                finished.clear();
+            }
+            if (fds[0].revents != 0) {
+                int client;
+                while ((client = ::accept(listen_fd, nullptr, nullptr)) >= 0) {
+                    setNonBlocking(client);
+                    auto c = std::make_unique<Connection>(client);
+                    c->request.config = options.config;
+                    connections[client] = std::move(c);
+                    accepted++;
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            ready.notify_all();
+        }
+        for (auto& worker : workers) worker.join();
+        return WhatIfReport{accepted, requests, errors};
+    }
+};
+
+#endif // WHAT_IF_SERVER_HPP
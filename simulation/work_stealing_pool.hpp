@@ -0,0 +1,155 @@
+/*
+ * Work-Stealing Pool
+ *
+ * Fixed set of threads for running one batch of independent tasks at a
+ * time, used by FlatCoordinator to run the models of one time step.
+ * run(n, task) splits the indexes 0..n-1 into chunks, deals them out
+ * round-robin to one deque per thread (the caller is thread 0) and
+ * returns when every index is done. Each thread takes chunks from the
+ * front of its own deque and, once that is empty, steals from the back
+ * of the others, so a few slow models do not leave the rest idle.
+ *
+ * Tasks of one batch must not touch each other's data; nothing is
+ * ordered between them.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class WorkStealingPool {
+    using Range = std::pair<std::size_t, std::size_t>;  // [first, last)
+
+    struct Deque {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    std::vector<std::unique_ptr<Deque>> deques;  // one per thread, 0 is the caller
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::uint64_t generation;
+    std::size_t busy;                            // workers inside the current batch
+    bool stopping;
+    const std::function<void(std::size_t)>* task;
+    std::atomic<std::size_t> remaining;
+
+    // next chunk for thread self, own deque first, then stolen
+    bool take(std::size_t self, Range& range) {
+        {
+            Deque& own = *deques[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.ranges.empty()) {
+                range = own.ranges.front();
+                own.ranges.pop_front();
+                return true;
+            }
+        }
+        for (std::size_t i = 1; i < deques.size(); i++) {
+            Deque& other = *deques[(self + i) % deques.size()];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (!other.ranges.empty()) {
+                range = other.ranges.back();
+                other.ranges.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(std::size_t self) {
+        Range range;
+        while (take(self, range)) {
+            for (std::size_t i = range.first; i < range.second; i++) (*task)(i);
+            if (remaining.fetch_sub(range.second - range.first) == range.second - range.first) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+
+    void loop(std::size_t self) {
+        std::uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            busy++;
+            lock.unlock();
+            work(self);
+            lock.lock();
+            busy--;
+            finished.notify_all();
+        }
+    }
+
+public:
+    // threads counts the caller, so 1 runs everything on the calling thread
+    explicit WorkStealingPool(unsigned threads)
+        : deques(), workers(), mutex(), wake(), finished(), generation(0), busy(0), stopping(false), task(nullptr),
+          remaining(0) {
+        threads = std::max(1u, threads);
+        for (unsigned i = 0; i < threads; i++) deques.push_back(std::make_unique<Deque>());
+        for (unsigned i = 1; i < threads; i++) workers.emplace_back(&WorkStealingPool::loop, this, i);
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    [[nodiscard]] std::size_t threads() const { return deques.size(); }
+
+    // task(i) for every i in 0..n-1, grain indexes per chunk
+    void run(std::size_t n, const std::function<void(std::size_t)>& batch, std::size_t grain = 1) {
+        if (n == 0) return;
+        grain = std::max<std::size_t>(1, grain);
+        if (workers.empty() || n <= grain) {
+            for (std::size_t i = 0; i < n; i++) batch(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &batch;
+            remaining.store(n);
+            std::size_t next = 0;
+            for (std::size_t first = 0; first < n; first += grain) {
+                Deque& deque = *deques[next++ % deques.size()];
+                std::lock_guard<std::mutex> deque_lock(deque.mutex);
+                deque.ranges.emplace_back(first, std::min(n, first + grain));
+            }
+            generation++;
+        }
+        wake.notify_all();
+        work(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return remaining.load() == 0 && busy == 0; });
+    }
+};
+
+#endif // WORK_STEALING_POOL_HPP
@@ -2,14 +2,18 @@
  * Test Driver for ControlTower Atomic Model
  *
  * Tests the air traffic control tower's handling of landing and takeoff requests.
- * Reads test inputs from files. Format: time port value
- * Port mapping: 0=landing, 1=takeoff
+ * Reads test inputs from files. Format: time port value [priority]
+ * Port mapping: 0=landing, 1=takeoff, 2=priority update for a holding plane
  *
  * Test Cases:
  *   CT-1: Single landing request
  *   CT-2: Single takeoff request
  *   CT-3: Sequential landing then takeoff
  *   CT-4: Concurrent requests (second ignored while busy)
+ *   CT-5: Priority scheduling, emergency served ahead of earlier arrivals
+ *   CT-6: Priority scheduling, holding plane upgraded on in_priority
+ *   CT-7: Coalesced signalling on the CT-4 input (no stop to the sender, handover done)
+ *   CT-8: Priority scheduling with plane ids near INT_MAX, one of them upgraded
  *
  * Authors: Hasib Khodayar & Hajar Assim
  * Course: SYSC 4906G, Winter 2026
@@ -21,6 +25,7 @@
 #include "../atomics/controlTower.hpp"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <limits>
 #include <vector>
 #include <tuple>
@@ -32,7 +37,7 @@ struct TowerInputState {
     double sigma;
     double elapsed;
     size_t current_event;
-    std::vector<std::tuple<double, int, int>> events;  // time port value
+    std::vector<std::tuple<double, int, PlaneMsg>> events;  // time port plane
 
     explicit TowerInputState() : sigma(std::numeric_limits<double>::infinity()), elapsed(0), current_event(0) {}
 };
@@ -45,19 +50,27 @@ std::ostream& operator<<(std::ostream &out, const TowerInputState& s) {
 // file-based input generator for control tower
 class TowerInputGenerator : public Atomic<TowerInputState> {
 public:
-    Port<int> out_landing;
-    Port<int> out_takeoff;
+    PooledPort<PlaneMsg> out_landing;
+    PooledPort<PlaneMsg> out_takeoff;
+    PooledPort<PlaneMsg> out_priority;
 
     TowerInputGenerator(const std::string& id, const char* input_file) : Atomic<TowerInputState>(id, TowerInputState()) {
-        out_landing = addOutPort<int>("out_landing");
-        out_takeoff = addOutPort<int>("out_takeoff");
+        out_landing = addPooledOutPort<PlaneMsg>(this, "out_landing");
+        out_takeoff = addPooledOutPort<PlaneMsg>(this, "out_takeoff");
+        out_priority = addPooledOutPort<PlaneMsg>(this, "out_priority");
 
-        // read events from file
+        // read events from file, priority column is optional
         std::ifstream file(input_file);
-        double time;
-        int port, value;
-        while (file >> time >> port >> value) {
-            state.events.push_back({time, port, value});
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            double time;
+            int port, value;
+            if (!(fields >> time >> port >> value)) continue;
+            PlaneMsg plane = value;
+            int priority;
+            if (fields >> priority) setPlanePriority(plane, priority);
+            state.events.push_back({time, port, plane});
         }
 
         if (!state.events.empty()) {
@@ -81,11 +94,13 @@ public:
         if (s.current_event < s.events.size()) {
             auto& evt = s.events[s.current_event];
             int port = std::get<1>(evt);
-            int value = std::get<2>(evt);
+            const PlaneMsg& plane = std::get<2>(evt);
             if (port == 0)
-                out_landing->addMessage(value);
+                out_landing->addMessage(plane);
+            else if (port == 1)
+                out_takeoff->addMessage(plane);
             else
-                out_takeoff->addMessage(value);
+                out_priority->addMessage(plane);
         }
     }
 
@@ -97,22 +112,26 @@ public:
 // test bench
 class TowerTestBench : public Coupled {
 public:
-    TowerTestBench(const std::string& id, const char* input_file) : Coupled(id) {
+    TowerTestBench(const std::string& id, const char* input_file, TowerScheduling scheduling,
+                   TowerSignalling signalling) : Coupled(id) {
         auto generator = addComponent<TowerInputGenerator>("Generator", input_file);
-        auto tower = addComponent<ControlTower>("ControlTower");
+        auto tower = addComponent<ControlTower>("ControlTower", scheduling, signalling);
 
         addCoupling(generator->out_landing, tower->in_landing);
         addCoupling(generator->out_takeoff, tower->in_takeoff);
+        addCoupling(generator->out_priority, tower->in_priority);
     }
 };
 
-void runTest(const std::string& test_id, const std::string& input_file, double sim_time) {
+void runTest(const std::string& test_id, const std::string& input_file, double sim_time,
+             TowerScheduling scheduling = TowerScheduling::FIFO,
+             TowerSignalling signalling = TowerSignalling::FULL) {
     std::cout << "========================================" << std::endl;
     std::cout << "ControlTower Test: " << test_id << std::endl;
     std::cout << "Input file: " << input_file << std::endl;
     std::cout << "========================================" << std::endl;
 
-    auto model = std::make_shared<TowerTestBench>("TowerTest", input_file.c_str());
+    auto model = std::make_shared<TowerTestBench>("TowerTest", input_file.c_str(), scheduling, signalling);
     auto rootCoordinator = RootCoordinator(model);
 
     rootCoordinator.setLogger<STDOUTLogger>(";");
@@ -134,8 +153,8 @@ int main(int argc, char* argv[]) {
     std::cout << "========================================" << std::endl;
     std::cout << "ControlTower Atomic Model Tests" << std::endl;
     std::cout << "========================================" << std::endl;
-    std::cout << "input format: time port value" << std::endl;
-    std::cout << "  port 0=landing, 1=takeoff" << std::endl;
+    std::cout << "input format: time port value [priority]" << std::endl;
+    std::cout << "  port 0=landing, 1=takeoff, 2=priority update" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << std::endl;
 
@@ -144,6 +163,10 @@ int main(int argc, char* argv[]) {
     runTest("CT-2", base_path + "CT2_single_takeoff.txt", 300.0);
     runTest("CT-3", base_path + "CT3_back_to_back.txt", 400.0);
     runTest("CT-4", base_path + "CT4_while_busy.txt", 300.0);
+    runTest("CT-5", base_path + "CT5_priority.txt", 600.0, TowerScheduling::PRIORITY);
+    runTest("CT-6", base_path + "CT6_priority_update.txt", 600.0, TowerScheduling::PRIORITY);
+    runTest("CT-7", base_path + "CT4_while_busy.txt", 300.0, TowerScheduling::FIFO, TowerSignalling::COALESCED);
+    runTest("CT-8", base_path + "CT8_large_ids.txt", 600.0, TowerScheduling::PRIORITY);
 
     std::cout << "========================================" << std::endl;
     std::cout << "All ControlTower Tests Complete" << std::endl;
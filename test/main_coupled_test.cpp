@@ -4,6 +4,7 @@
  * Tests the integrated behavior of coupled models:
  * - StorageBank (4 bays + merger): SBK-1, SBK-2
  * - Hangar (selector + storage bank): H-1, H-2
+ * - AggregateHangar on the same inputs: AH-1, AH-2 (same exit times)
  *
  * Note: AirportTop tests are run via top_model experiments (T1-T6)
  *
@@ -14,9 +15,10 @@
 #include <cadmium/simulation/root_coordinator.hpp>
 #include <cadmium/simulation/logger/stdout.hpp>
 #include <cadmium/modeling/devs/coupled.hpp>
-#include <cadmium/lib/iestream.hpp>
 
+#include "../atomics/planeGenerator.hpp"
 #include "../coupled/hangar.hpp"
+#include "../atomics/aggregateHangar.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -43,16 +45,16 @@ std::ostream& operator<<(std::ostream &out, const StorageBankGenState& s) {
 
 class StorageBankGenerator : public Atomic<StorageBankGenState> {
 public:
-    Port<int> out1;
-    Port<int> out2;
-    Port<int> out3;
-    Port<int> out4;
+    PooledPort<PlaneMsg> out1;
+    PooledPort<PlaneMsg> out2;
+    PooledPort<PlaneMsg> out3;
+    PooledPort<PlaneMsg> out4;
 
     StorageBankGenerator(const std::string& id, const char* input_file) : Atomic<StorageBankGenState>(id, StorageBankGenState()) {
-        out1 = addOutPort<int>("out1");
-        out2 = addOutPort<int>("out2");
-        out3 = addOutPort<int>("out3");
-        out4 = addOutPort<int>("out4");
+        out1 = addPooledOutPort<PlaneMsg>(this, "out1");
+        out2 = addPooledOutPort<PlaneMsg>(this, "out2");
+        out3 = addPooledOutPort<PlaneMsg>(this, "out3");
+        out4 = addPooledOutPort<PlaneMsg>(this, "out4");
 
         std::ifstream file(input_file);
         double time;
@@ -114,13 +116,23 @@ public:
 class HangarTestBench : public Coupled {
 public:
     HangarTestBench(const std::string& id, const char* input_file) : Coupled(id) {
-        auto generator = addComponent<lib::IEStream<int>>("Generator", input_file);
+        auto generator = addComponent<PlaneGenerator>("Generator", input_file);
         auto hangar = addComponent<Hangar>("Hangar");
 
         addCoupling(generator->out, hangar->in);
     }
 };
 
+class AggregateHangarTestBench : public Coupled {
+public:
+    AggregateHangarTestBench(const std::string& id, const char* input_file) : Coupled(id) {
+        auto generator = addComponent<PlaneGenerator>("Generator", input_file);
+        auto hangar = addComponent<AggregateHangar>("Hangar");
+
+        addCoupling(generator->out, hangar->in);
+    }
+};
+
 void runStorageBankTest(const std::string& test_id, const std::string& input_file, double sim_time) {
     std::cout << "========================================" << std::endl;
     std::cout << "StorageBank Test: " << test_id << std::endl;
@@ -155,6 +167,23 @@ void runHangarTest(const std::string& test_id, const std::string& input_file, do
     std::cout << std::endl;
 }
 
+void runAggregateHangarTest(const std::string& test_id, const std::string& input_file, double sim_time) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "AggregateHangar Test: " << test_id << std::endl;
+    std::cout << "Input file: " << input_file << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    auto model = std::make_shared<AggregateHangarTestBench>("AggregateHangarTest", input_file.c_str());
+    auto rootCoordinator = RootCoordinator(model);
+
+    rootCoordinator.setLogger<STDOUTLogger>(";");
+    rootCoordinator.start();
+    rootCoordinator.simulate(sim_time);
+    rootCoordinator.stop();
+
+    std::cout << std::endl;
+}
+
 int main(int argc, char* argv[]) {
     std::string base_path = "input_data/";
 
@@ -179,6 +208,10 @@ int main(int argc, char* argv[]) {
     runHangarTest("H-1", base_path + "hangar/H1_route_store.txt", 100.0);
     runHangarTest("H-2", base_path + "hangar/H2_all_bays.txt", 250.0);
 
+    // aggregate hangar tests
+    runAggregateHangarTest("AH-1", base_path + "hangar/H1_route_store.txt", 100.0);
+    runAggregateHangarTest("AH-2", base_path + "hangar/H2_all_bays.txt", 250.0);
+
     std::cout << "========================================" << std::endl;
     std::cout << "All Coupled Model Tests Complete" << std::endl;
     std::cout << "========================================" << std::endl;
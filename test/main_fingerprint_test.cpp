@@ -0,0 +1,713 @@
+/*
+ * Test Driver for Trace Fingerprints
+ *
+ * Reruns every scenario of the other test drivers and the T1-T6
+ * experiments with the FingerprintLogger and checks each trace against
+ * its recorded fingerprint (record count and 64-bit hash). No text log
+ * is written, so the whole suite runs in milliseconds. A failing
+ * scenario prints its checkpoints; compare them with a run of the
+ * previous build to find where the traces split.
+ *
+ * Every scenario is also run on the FlatCoordinator, sequentially and
+ * with four threads parallel from one model per step, with the scan and
+ * with the calendar scheduler, and has to give the same fingerprint as
+ * on Cadmium's RootCoordinator. The hangar benches and the experiments
+ * run on the StaticKernel as well, the experiments also under other
+ * AirportConfigs, where the static kernel only has to agree with
+ * RootCoordinator. Finally T1-T6 run back to back on one model reset in
+ * place between runs, which has to give the same traces as a newly built
+ * model, once more as what-if server requests, with the arrivals sent as
+ * text, and on the airport built at run time from
+ * input_data/topology/airport.ma. Last, a T1 trace goes through the
+ * result cache: it has to come back as stored, and only for its own key.
+ *
+ * After an intended behaviour change, run with --print and paste the
+ * new table into EXPECTED below.
+ *
+ * Usage: FINGERPRINT_TEST [input_data_dir] [--print]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include <cadmium/simulation/root_coordinator.hpp>
+#include <cadmium/modeling/devs/coupled.hpp>
+
+#include "../atomics/planeGenerator.hpp"
+#include "../coupled/airportTop.hpp"
+#include "../atomics/merger.hpp"
+#include "../loggers/fingerprint_logger.hpp"
+#include "../simulation/flat_coordinator.hpp"
+#include "../coupled/staticAirport.hpp"
+#include "../simulation/what_if_server.hpp"
+#include "../coupled/topologyBuilder.hpp"
+#include "../simulation/result_cache.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+using namespace cadmium;
+
+// generator port feeding one input port of the model under test
+struct ScenarioPort {
+    int number;              // port column in the input file
+    std::string target;      // input port on the model under test
+    bool plane;              // PlaneMsg port, otherwise int
+};
+
+struct ScenarioInputState {
+    double sigma;
+    double elapsed;
+    size_t current_event;
+    std::vector<std::tuple<double, int, PlaneMsg>> events;  // time port plane
+
+    explicit ScenarioInputState() : sigma(std::numeric_limits<double>::infinity()), elapsed(0), current_event(0) {}
+};
+
+std::ostream& operator<<(std::ostream &out, const ScenarioInputState& s) {
+    out << "{event=" << s.current_event << ", sigma=" << s.sigma << "}";
+    return out;
+}
+
+// the per-driver file generators in one, reads time port value [priority]
+class ScenarioInput : public Atomic<ScenarioInputState> {
+    std::vector<ScenarioPort> ports;
+    std::vector<PooledPort<PlaneMsg>> plane_out;
+    std::vector<Port<int>> int_out;
+
+public:
+    ScenarioInput(const std::string& id, const char* input_file, const std::vector<ScenarioPort>& ports)
+        : Atomic<ScenarioInputState>(id, ScenarioInputState()), ports(ports) {
+        for (const auto& p : ports) {
+            std::string name = "out" + std::to_string(p.number);
+            if (p.plane) plane_out.push_back(addPooledOutPort<PlaneMsg>(this, name));
+            else int_out.push_back(addOutPort<int>(name));
+        }
+
+        std::ifstream file(input_file);
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            double time;
+            int port, value;
+            if (!(fields >> time >> port >> value)) continue;
+            PlaneMsg plane = value;
+            int priority;
+            if (fields >> priority) setPlanePriority(plane, priority);
+            state.events.push_back({time, port, plane});
+        }
+
+        if (!state.events.empty()) {
+            state.sigma = std::get<0>(state.events[0]);
+        }
+    }
+
+    [[nodiscard]] std::shared_ptr<PortInterface> port(int number) const {
+        std::size_t planes = 0, ints = 0;
+        for (const auto& p : ports) {
+            if (p.number == number) return p.plane ? std::shared_ptr<PortInterface>(plane_out[planes]) : int_out[ints];
+            if (p.plane) planes++;
+            else ints++;
+        }
+        return nullptr;
+    }
+
+    void internalTransition(ScenarioInputState& s) const override {
+        s.elapsed += s.sigma;
+        s.current_event++;
+        if (s.current_event < s.events.size()) {
+            s.sigma = std::get<0>(s.events[s.current_event]) - s.elapsed;
+        } else {
+            s.sigma = std::numeric_limits<double>::infinity();
+        }
+    }
+
+    void externalTransition(ScenarioInputState& s, double e) const override {}
+
+    void output(const ScenarioInputState& s) const override {
+        if (s.current_event >= s.events.size()) return;
+        const auto& [time, number, plane] = s.events[s.current_event];
+        std::size_t planes = 0, ints = 0;
+        for (const auto& p : ports) {
+            if (p.number == number) {
+                if (p.plane) plane_out[planes]->addMessage(plane);
+                else int_out[ints]->addMessage(planeId(plane));
+                return;
+            }
+            if (p.plane) planes++;
+            else ints++;
+        }
+    }
+
+    [[nodiscard]] double timeAdvance(const ScenarioInputState& s) const override {
+        return s.sigma;
+    }
+};
+
+// model under test fed by a ScenarioInput, or by a PlaneGenerator when ports is empty
+class ScenarioBench : public Coupled {
+public:
+    ScenarioBench(const std::string& id, const char* input_file, const std::shared_ptr<Component>& model,
+                  const std::vector<ScenarioPort>& ports) : Coupled(id) {
+        addComponent(model);
+        if (ports.empty()) {
+            auto generator = addComponent<PlaneGenerator>("Generator", input_file);
+            addCoupling(generator->out, model->getInPort("in"));
+            return;
+        }
+        auto generator = addComponent<ScenarioInput>("Generator", input_file, ports);
+        for (const auto& p : ports) {
+            addCoupling(generator->port(p.number), model->getInPort(p.target));
+        }
+    }
+};
+
+// same structure and names as AirportSimulation in top_model/main.cpp, so the
+// hashes match AIRPORT_SIMULATION --fingerprint
+class ExperimentBench : public Coupled {
+    std::shared_ptr<PlaneGenerator> generator;
+    std::shared_ptr<AirportTop> airport;
+
+public:
+    ExperimentBench(const std::string& id, const char* input_file, const AirportConfig& config = AirportConfig())
+        : Coupled(id) {
+        PooledPort<PlaneMsg> out_takeoff = addPooledOutPort<PlaneMsg>(this, "out_takeoff");
+        generator = addComponent<PlaneGenerator>("Generator", input_file);
+        airport = addComponent<AirportTop>("Airport", config);
+
+        addCoupling(generator->out, airport->in_landing);
+        addCoupling(airport->out_takeoff, out_takeoff);
+    }
+
+    void reset(const char* input_file, const AirportConfig& config) {
+        generator->reset(input_file);
+        airport->reset(config);
+    }
+};
+
+// the scenario on the StaticKernel, reference is the model build returns
+using StaticRun = std::function<TraceFingerprint(const Coupled& reference, const std::string& input_file, double sim_time)>;
+
+struct Scenario {
+    std::string id;
+    std::string input_file;  // relative to the input_data directory
+    double sim_time;
+    std::function<std::shared_ptr<Coupled>(const std::string& input_file)> build;
+    StaticRun on_static;     // empty for the single-atomic benches
+};
+
+struct Expected {
+    std::string id;
+    std::uint64_t records;
+    std::uint64_t hash;
+};
+
+// recorded with --print
+const std::vector<Expected> EXPECTED = {
+    {"CT-1", 14, 0xdb73702c623dac36ULL},
+    {"CT-2", 14, 0x4af2da19fe727be6ULL},
+    {"CT-3", 24, 0x3728ca72c848b576ULL},
+    {"CT-4", 24, 0xcf84f8a436fc5c0aULL},
+    {"CT-5", 44, 0x8ec41bba77da2f77ULL},
+    {"CT-6", 37, 0xcde35f69cd4f7fbeULL},
+    {"CT-7", 21, 0x2f407e5a005c1571ULL},
+    {"CT-8", 37, 0x8a1949ede91ec794ULL},
+    {"Q-1", 9, 0xa372f38c865114bdULL},
+    {"Q-2", 14, 0xdb9b99941353dcbcULL},
+    {"Q-3", 15, 0xc4e185ca1bab9f71ULL},
+    {"Q-4", 10, 0x36aef7cad7933d2eULL},
+    {"Q-5", 15, 0xf8aa9159ad59d54bULL},
+    {"Q-6", 28, 0xc80d14f0ec296a17ULL},
+    {"Q-7", 28, 0x6e01d5b3ef4e3a4dULL},
+    {"Q-8", 24, 0x2e24a007af0ccd17ULL},
+    {"R-1", 9, 0x7ac3907393632ddeULL},
+    {"R-2", 9, 0x91cfc45485c52566ULL},
+    {"R-3", 14, 0xc1fc52d944e6a79dULL},
+    {"S-1", 9, 0xa910463cd0b3cf18ULL},
+    {"S-2", 9, 0x9896413a08e51bbdULL},
+    {"S-3", 9, 0xf9aa0c9d9a898b51ULL},
+    {"S-4", 9, 0x04483d8c66e5ad71ULL},
+    {"S-5", 34, 0x79d095cd74ba5aaaULL},
+    {"SB-1", 9, 0xb4f386e84b7f779cULL},
+    {"SB-2", 17, 0x1bccc9d4fb02b5d6ULL},
+    {"SB-3", 39, 0x39b1b2356a606a12ULL},
+    {"M-1", 9, 0x6e3ea617d0637ad5ULL},
+    {"M-2", 24, 0x741295cba01d8e15ULL},
+    {"M-3", 21, 0x9b2ec2c067e513e2ULL},
+    {"SBK-1", 20, 0xd1a31f35f6845530ULL},
+    {"SBK-2", 44, 0x35c9022b2e6c00a8ULL},
+    {"H-1", 25, 0xce2b227e33415973ULL},
+    {"H-2", 58, 0x77faff7f9c2a5e7aULL},
+    {"AH-1", 9, 0xb6ca349b09a01df1ULL},
+    {"AH-2", 24, 0xd0ac75087637c6bdULL},
+    {"T1", 69, 0xbacd310c6778ca60ULL},
+    {"T2", 285, 0x01aa9d970d27b9c8ULL},
+    {"T3", 2372, 0xd9485297264e8674ULL},
+    {"T4", 242, 0x51f51240009ac3b8ULL},
+    {"T5", 282, 0xc5685f79b4f2c8f3ULL},
+    {"T6", 455, 0xdd5c974e88a33efeULL},
+};
+
+template <typename Root>
+TraceFingerprint runOn(Root& rootCoordinator, double sim_time, std::uint64_t interval) {
+    auto result = std::make_shared<TraceFingerprint>();
+    result->interval = interval;
+    rootCoordinator.template setLogger<FingerprintLogger>(result);
+    rootCoordinator.start();
+    rootCoordinator.simulate(sim_time);
+    rootCoordinator.stop();
+    return *result;
+}
+
+// Generator feeding a hangar part, the H and AH benches on the static kernel
+template <template <std::size_t> class HangarPart>
+StaticRun staticHangar() {
+    return [](const Coupled& reference, const std::string& input_file, double sim_time) {
+        using Hangar = HangarPart<1>;
+        using Bench = Join<Topology<ModelList<PlaneGenerator>,
+                                    LinkList<Link<0, &PlaneGenerator::out, Hangar::in, Hangar::in_port>>>,
+                           Hangar>;
+        StaticKernel<Bench> kernel(reference, std::tuple_cat(std::make_tuple(std::make_tuple(std::string("Generator"),
+                                                                                           input_file.c_str())),
+                                                             Hangar::args(DwellConfig())));
+        return runOn(kernel, sim_time, 0);
+    };
+}
+
+StaticRun staticExperiment(const AirportConfig& config) {
+    return [config](const Coupled& reference, const std::string& input_file, double sim_time) {
+        TraceFingerprint result;
+        withStaticAirport(reference, input_file.c_str(), config,
+                          [&](auto& kernel) { result = runOn(kernel, sim_time, 0); });
+        return result;
+    };
+}
+
+template <typename M, typename... Args>
+std::function<std::shared_ptr<Coupled>(const std::string&)> bench(std::vector<ScenarioPort> ports, Args... args) {
+    return [=](const std::string& input_file) -> std::shared_ptr<Coupled> {
+        auto model = std::make_shared<M>(args...);
+        return std::make_shared<ScenarioBench>("FingerprintTest", input_file.c_str(), model, ports);
+    };
+}
+
+std::vector<Scenario> scenarios() {
+    const std::vector<ScenarioPort> tower = {{0, "in_landing", true}, {1, "in_takeoff", true}, {2, "in_priority", true}};
+    const std::vector<ScenarioPort> queue = {{0, "in", true}, {1, "stop", false}, {2, "done", false}};
+    const std::vector<ScenarioPort> runway = {{0, "land", true}, {1, "takeoff", true}};
+    const std::vector<ScenarioPort> four = {{1, "in1", true}, {2, "in2", true}, {3, "in3", true}, {4, "in4", true}};
+    DwellConfig dwell;
+    dwell.enabled = true;
+    dwell.dwell = 60.0;
+
+    auto experiment = [](const std::string& input_file) -> std::shared_ptr<Coupled> {
+        return std::make_shared<ExperimentBench>("AirportSimulation", input_file.c_str());
+    };
+
+    return {
+        {"CT-1", "control_tower/CT1_single_landing.txt", 300.0, bench<ControlTower>(tower, "ControlTower", TowerScheduling::FIFO)},
+        {"CT-2", "control_tower/CT2_single_takeoff.txt", 300.0, bench<ControlTower>(tower, "ControlTower", TowerScheduling::FIFO)},
+        {"CT-3", "control_tower/CT3_back_to_back.txt", 400.0, bench<ControlTower>(tower, "ControlTower", TowerScheduling::FIFO)},
+        {"CT-4", "control_tower/CT4_while_busy.txt", 300.0, bench<ControlTower>(tower, "ControlTower", TowerScheduling::FIFO)},
+        {"CT-5", "control_tower/CT5_priority.txt", 600.0, bench<ControlTower>(tower, "ControlTower", TowerScheduling::PRIORITY)},
+        {"CT-6", "control_tower/CT6_priority_update.txt", 600.0, bench<ControlTower>(tower, "ControlTower", TowerScheduling::PRIORITY)},
+        {"CT-7", "control_tower/CT4_while_busy.txt", 300.0, bench<ControlTower>(tower, "ControlTower", TowerScheduling::FIFO, TowerSignalling::COALESCED)},
+        {"CT-8", "control_tower/CT8_large_ids.txt", 600.0, bench<ControlTower>(tower, "ControlTower", TowerScheduling::PRIORITY)},
+        {"Q-1", "queue/Q1_single_plane.txt", 100.0, bench<Queue>(queue, "Queue", 0, QueueOverflow::DIVERT_NEWEST)},
+        {"Q-2", "queue/Q2_multiple.txt", 100.0, bench<Queue>(queue, "Queue", 0, QueueOverflow::DIVERT_NEWEST)},
+        {"Q-3", "queue/Q3_stop_resume.txt", 100.0, bench<Queue>(queue, "Queue", 0, QueueOverflow::DIVERT_NEWEST)},
+        {"Q-4", "queue/Q4_stop_empty.txt", 100.0, bench<Queue>(queue, "Queue", 0, QueueOverflow::DIVERT_NEWEST)},
+        {"Q-5", "queue/Q5_enqueue_stopped.txt", 100.0, bench<Queue>(queue, "Queue", 0, QueueOverflow::DIVERT_NEWEST)},
+        {"Q-6", "queue/Q6_overflow.txt", 100.0, bench<Queue>(queue, "Queue", 2, QueueOverflow::DIVERT_NEWEST)},
+        {"Q-7", "queue/Q6_overflow.txt", 100.0, bench<Queue>(queue, "Queue", 2, QueueOverflow::DIVERT_OLDEST)},
+        {"Q-8", "queue/Q8_handover.txt", 200.0, bench<Queue>(queue, "Queue", 0, QueueOverflow::DIVERT_NEWEST)},
+        {"R-1", "runway/R1_landing.txt", 200.0, bench<Runway>(runway, "Runway")},
+        {"R-2", "runway/R2_takeoff.txt", 200.0, bench<Runway>(runway, "Runway")},
+        {"R-3", "runway/R3_sequential.txt", 250.0, bench<Runway>(runway, "Runway")},
+        {"S-1", "selector/S1_bay1.txt", 100.0, bench<Selector>({}, "Selector")},
+        {"S-2", "selector/S2_bay2.txt", 100.0, bench<Selector>({}, "Selector")},
+        {"S-3", "selector/S3_bay3.txt", 100.0, bench<Selector>({}, "Selector")},
+        {"S-4", "selector/S4_bay4.txt", 100.0, bench<Selector>({}, "Selector")},
+        {"S-5", "selector/S5_boundary.txt", 400.0, bench<Selector>({}, "Selector")},
+        {"SB-1", "storage_bay/SB1_single.txt", 50.0, bench<StorageBay>({}, "StorageBay", DwellConfig())},
+        {"SB-2", "storage_bay/SB2_fifo.txt", 50.0, bench<StorageBay>({}, "StorageBay", DwellConfig())},
+        {"SB-3", "storage_bay/SB3_dwell.txt", 80000.0, bench<StorageBay>({}, "StorageBay", dwell)},
+        {"M-1", "merger/M1_single.txt", 50.0, bench<Merger>(four, "Merger")},
+        {"M-2", "merger/M2_all_ports.txt", 100.0, bench<Merger>(four, "Merger")},
+        {"M-3", "merger/M3_simultaneous.txt", 50.0, bench<Merger>(four, "Merger")},
+        {"SBK-1", "storage_bank/SBK1_one_bay.txt", 50.0, bench<StorageBank>(four, "StorageBank", DwellConfig())},
+        {"SBK-2", "storage_bank/SBK2_all_bays.txt", 100.0, bench<StorageBank>(four, "StorageBank", DwellConfig())},
+        {"H-1", "hangar/H1_route_store.txt", 100.0, bench<Hangar>({}, "Hangar", DwellConfig()), staticHangar<StaticHangar>()},
+        {"H-2", "hangar/H2_all_bays.txt", 250.0, bench<Hangar>({}, "Hangar", DwellConfig()), staticHangar<StaticHangar>()},
+        {"AH-1", "hangar/H1_route_store.txt", 100.0, bench<AggregateHangar>({}, "Hangar", DwellConfig()), staticHangar<StaticAggregateHangar>()},
+        {"AH-2", "hangar/H2_all_bays.txt", 250.0, bench<AggregateHangar>({}, "Hangar", DwellConfig()), staticHangar<StaticAggregateHangar>()},
+        {"T1", "T1_single_lifecycle.txt", 500.0, experiment, staticExperiment(AirportConfig())},
+        {"T2", "T2_burst_test.txt", 3600.0, experiment, staticExperiment(AirportConfig())},
+        {"T3", "T3_staggered_test.txt", 18000.0, experiment, staticExperiment(AirportConfig())},
+        {"T4", "T4_rapid_test.txt", 1800.0, experiment, staticExperiment(AirportConfig())},
+        {"T5", "T5_boundary_test.txt", 3600.0, experiment, staticExperiment(AirportConfig())},
+        {"T6", "T6_bay_stress_test.txt", 3600.0, experiment, staticExperiment(AirportConfig())},
+    };
+}
+
+TraceFingerprint runScenario(const Scenario& scenario, const std::string& base_path, std::uint64_t interval) {
+    auto rootCoordinator = RootCoordinator(scenario.build(base_path + scenario.input_file));
+    return runOn(rootCoordinator, scenario.sim_time, interval);
+}
+
+// threads 1 is the flat coordinator without the pool
+TraceFingerprint runFlatScenario(const Scenario& scenario, const std::string& base_path, unsigned threads,
+                                 FlatScheduler scheduler) {
+    ParallelOptions options;
+    options.threads = threads;
+    options.min_width = 1;
+    options.scheduler = scheduler;
+    FlatCoordinator rootCoordinator(scenario.build(base_path + scenario.input_file), options);
+    return runOn(rootCoordinator, scenario.sim_time, 0);
+}
+
+// T1-T6 under option sets covering every static airport topology, returns the number that differ
+int checkStaticConfigs(const std::string& base_path) {
+    struct Options {
+        std::string name;
+        AirportConfig config;
+    };
+    std::vector<Options> options(3);
+    options[0].name = "priority";
+    options[0].config.scheduling = TowerScheduling::PRIORITY;
+    options[1].name = "aggregate dwell capacity";
+    options[1].config.hangar = HangarModel::AGGREGATE;
+    options[1].config.hangar_dwell.enabled = true;
+    options[1].config.hangar_dwell.dwell = 60.0;
+    options[2].name = "priority aggregate exp-dwell coalesced";
+    options[2].config = options[1].config;
+    options[2].config.scheduling = TowerScheduling::PRIORITY;
+    options[2].config.hangar_dwell.exponential = true;
+    options[2].config.signalling = TowerSignalling::COALESCED;
+    // the capacity bounds queues only, priority mode has no landing queue
+    options[1].config.queue_capacity = 3;
+
+    int failures = 0;
+    for (const auto& option : options) {
+        bool pass = true;
+        for (const auto& scenario : scenarios()) {
+            if (!scenario.on_static || scenario.id[0] != 'T') continue;
+            std::string input_file = base_path + scenario.input_file;
+            ExperimentBench reference("AirportSimulation", input_file.c_str(), option.config);
+            auto rootCoordinator = RootCoordinator(
+                std::make_shared<ExperimentBench>("AirportSimulation", input_file.c_str(), option.config));
+            TraceFingerprint cadmium = runOn(rootCoordinator, scenario.sim_time, 0);
+            TraceFingerprint fixed = staticExperiment(option.config)(reference, input_file, scenario.sim_time);
+            if (fixed.records != cadmium.records || fixed.hash != cadmium.hash) {
+                std::cout << "  " << scenario.id << ": static " << fixed.final() << ", Cadmium " << cadmium.final()
+                          << std::endl;
+                pass = false;
+            }
+        }
+        std::cout << (pass ? "PASS " : "FAIL ") << "static kernel, " << option.name << std::endl;
+        if (!pass) failures++;
+    }
+    return failures;
+}
+
+// the trace of one T scenario under one config, as the code under test gives it
+using ScenarioRunner = std::function<TraceFingerprint(const Scenario&, const std::string& input_file, const AirportConfig&)>;
+
+// T1-T6 under each config through run, against freshly built models
+int compareWithFreshModels(const std::string& base_path, const std::vector<AirportConfig>& configs,
+                           const std::string& label, const ScenarioRunner& run) {
+    bool pass = true;
+    for (const auto& scenario : scenarios()) {
+        if (scenario.id[0] != 'T') continue;
+        std::string input_file = base_path + scenario.input_file;
+        for (const auto& config : configs) {
+            auto fresh = RootCoordinator(
+                std::make_shared<ExperimentBench>("AirportSimulation", input_file.c_str(), config));
+            TraceFingerprint expected = runOn(fresh, scenario.sim_time, 0);
+            TraceFingerprint fingerprint = run(scenario, input_file, config);
+            if (fingerprint.records != expected.records || fingerprint.hash != expected.hash) {
+                std::cout << "  " << scenario.id << (config.hangar_dwell.enabled ? " (options)" : "") << ": "
+                          << fingerprint.final() << ", new model " << expected.final() << std::endl;
+                pass = false;
+            }
+        }
+    }
+    std::cout << (pass ? "PASS " : "FAIL ") << label << std::endl;
+    return pass ? 0 : 1;
+}
+
+// one model reset between runs, alternating two configs, on both coordinators
+int checkReset(const std::string& base_path) {
+    std::vector<AirportConfig> configs(2);
+    configs[1].queue_capacity = 3;
+    configs[1].queue_overflow = QueueOverflow::DIVERT_OLDEST;
+    configs[1].hangar_dwell.enabled = true;
+    configs[1].hangar_dwell.dwell = 90.0;
+    configs[1].hangar_dwell.exponential = true;
+    configs[1].signalling = TowerSignalling::COALESCED;
+
+    auto reused = std::make_shared<ExperimentBench>("AirportSimulation", "/dev/null");
+    FlatCoordinator flat(reused);
+    int failures = compareWithFreshModels(base_path, configs, "model reset between runs, flat coordinator",
+        [&](const Scenario& scenario, const std::string& input_file, const AirportConfig& config) {
+            reused->reset(input_file.c_str(), config);
+            flat.reset();
+            return runOn(flat, scenario.sim_time, 0);
+        });
+    failures += compareWithFreshModels(base_path, configs, "model reset between runs, RootCoordinator",
+        [&](const Scenario& scenario, const std::string& input_file, const AirportConfig& config) {
+            reused->reset(input_file.c_str(), config);
+            auto rootCoordinator = RootCoordinator(reused);
+            return runOn(rootCoordinator, scenario.sim_time, 0);
+        });
+    return failures;
+}
+
+// what-if requests on one worker's warm airports, with the arrivals sent as text
+int checkServed(const std::string& base_path) {
+    std::vector<AirportConfig> configs(2);
+    configs[1].scheduling = TowerScheduling::PRIORITY;
+    configs[1].hangar_dwell.enabled = true;
+    configs[1].hangar_dwell.dwell = 90.0;
+
+    WarmAirports airports{AirportConfig()};
+    // a dwell that is not finite is refused, as an option and set directly,
+    // and the warm airports answer the requests after it as before
+    WhatIfRequest refused;
+    std::string error;
+    bool pass = !parseRequestLine("options --dwell=nan", refused, error);
+    refused.config.hangar_dwell.enabled = true;
+    refused.config.hangar_dwell.dwell = std::numeric_limits<double>::quiet_NaN();
+    refused.arrivals = "0 1\n";
+    try {
+        airports.answer(refused);
+        pass = false;
+    } catch (const CadmiumModelException&) {
+    }
+    if (!pass) std::cout << "  what-if request with --dwell=nan is not refused" << std::endl;
+
+    return (pass ? 0 : 1) + compareWithFreshModels(base_path, configs, "what-if server requests",
+        [&](const Scenario& scenario, const std::string& input_file, const AirportConfig& config) {
+            std::ifstream input(input_file);
+            std::stringstream arrivals;
+            arrivals << input.rdbuf();
+            WhatIfRequest request;
+            request.config = config;
+            request.arrivals = arrivals.str();
+            request.sim_time = scenario.sim_time;
+            request.fingerprint = true;
+            std::string answer = airports.answer(request);
+
+            TraceFingerprint served;
+            unsigned long long records = 0, hash = 0;
+            if (std::sscanf(answer.c_str(), "ok records=%llu hash=%llx time=%lf", &records, &hash, &served.time) != 3) {
+                std::cout << "  " << scenario.id << ": served " << answer << std::endl;
+            }
+            served.records = records;
+            served.hash = hash;
+            return served;
+        });
+}
+
+// the airport built from topology/airport.ma, against the hand-wired model
+int checkTopology(const std::string& base_path) {
+    std::vector<AirportConfig> configs(2);
+    configs[1].queue_capacity = 2;
+    configs[1].hangar_dwell.enabled = true;
+    configs[1].hangar_dwell.dwell = 300.0;
+    configs[1].hangar_dwell.exponential = true;
+    configs[1].signalling = TowerSignalling::COALESCED;
+
+    TopologyFile topology = TopologyFile::load(base_path + "topology/airport.ma");
+    return compareWithFreshModels(base_path, configs, "topology built from airport.ma",
+        [&](const Scenario& scenario, const std::string& input_file, const AirportConfig& config) {
+            TopologyBuilder builder(topology, AtomicParameters{config, input_file});
+            auto built = RootCoordinator(builder.build("AirportSimulation"));
+            return runOn(built, scenario.sim_time, 0);
+        });
+}
+
+// a T1 fingerprint file through the result cache, and keys that must not find it
+int checkCache(const std::string& base_path) {
+    char root[] = "/tmp/airport_cache_test_XXXXXX";
+    if (::mkdtemp(root) == nullptr) {
+        std::cout << "FAIL result cache (no temporary directory)" << std::endl;
+        return 1;
+    }
+    std::string log_file = std::string(root) + "/T1_fingerprint.txt";
+    std::string restored_file = std::string(root) + "/restored.txt";
+    std::string input_file = base_path + "T1_single_lifecycle.txt";
+
+    AirportConfig options;
+    options.queue_capacity = 3;
+    options.hangar_dwell.enabled = true;
+    options.hangar_dwell.dwell = 90.0;
+    auto key = [&](double sim_time, const AirportConfig& config) {
+        RunKey k;
+        k.addFile("input", input_file).add("time", sim_time).add("options", airportOptions(config));
+        return k;
+    };
+    auto text = [](const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    };
+
+    auto root_coordinator = RootCoordinator(
+        std::make_shared<ExperimentBench>("AirportSimulation", input_file.c_str(), options));
+    TraceFingerprint fingerprint = runOn(root_coordinator, 500.0, 16);
+    {
+        std::ofstream file(log_file);
+        writeCheckpoints(file, fingerprint);
+    }
+
+    bool pass = true;
+    AirportConfig parsed;
+    std::istringstream words(airportOptions(options));
+    for (std::string word; words >> word;) pass = parseAirportOption(word, parsed) && pass;
+    if (!pass || airportOptions(parsed) != airportOptions(options)) {
+        std::cout << "  airportOptions does not read back: " << airportOptions(options) << std::endl;
+        pass = false;
+    }
+
+    ResultCache cache(std::string(root) + "/cache");
+    CachedRun cached;
+    if (cache.restore(key(500.0, options), restored_file, cached)) {
+        std::cout << "  hit in an empty cache" << std::endl;
+        pass = false;
+    }
+    if (!cache.store(key(500.0, options), log_file, 0.5)) {
+        std::cout << "  cannot store in " << root << std::endl;
+        pass = false;
+    }
+    if (!cache.restore(key(500.0, options), restored_file, cached) || text(restored_file) != text(log_file) ||
+        cached.seconds != 0.5) {
+        std::cout << "  stored trace does not come back" << std::endl;
+        pass = false;
+    }
+    if (cache.restore(key(501.0, options), restored_file, cached) ||
+        cache.restore(key(500.0, AirportConfig()), restored_file, cached)) {
+        std::cout << "  hit for another simulation time or other options" << std::endl;
+        pass = false;
+    }
+    // an entry whose log lost its end is a miss, and the next store replaces it
+    ::truncate((cache.entry(key(500.0, options)) + "/log").c_str(), 8);
+    if (cache.restore(key(500.0, options), restored_file, cached)) {
+        std::cout << "  hit on a truncated entry" << std::endl;
+        pass = false;
+    }
+    if (!cache.store(key(500.0, options), log_file, 0.25) ||
+        !cache.restore(key(500.0, options), restored_file, cached) || text(restored_file) != text(log_file)) {
+        std::cout << "  truncated entry is not replaced" << std::endl;
+        pass = false;
+    }
+
+    std::string entry = cache.entry(key(500.0, options));
+    for (const std::string& path : {entry + "/log", entry + "/summary.txt", log_file, restored_file}) {
+        std::remove(path.c_str());
+    }
+    for (const std::string& path : {entry, std::string(root) + "/cache", std::string(root)}) ::rmdir(path.c_str());
+    std::cout << (pass ? "PASS " : "FAIL ") << "result cache" << std::endl;
+    return pass ? 0 : 1;
+}
+
+std::string hex(std::uint64_t value) {
+    std::ostringstream out;
+    out << "0x" << std::hex << std::setw(16) << std::setfill('0') << value << "ULL";
+    return out.str();
+}
+
+int main(int argc, char* argv[]) {
+    std::string base_path = "input_data/";
+    bool print = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--print") {
+            print = true;
+        } else {
+            base_path = arg;
+            if (base_path.back() != '/') base_path += "/";
+        }
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "Trace Fingerprint Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    int failures = 0;
+    for (const auto& scenario : scenarios()) {
+        TraceFingerprint fingerprint = runScenario(scenario, base_path, 0);
+        if (print) {
+            std::cout << "    {\"" << scenario.id << "\", " << fingerprint.records << ", "
+                      << hex(fingerprint.hash) << "}," << std::endl;
+            continue;
+        }
+
+        const Expected* expected = nullptr;
+        for (const auto& e : EXPECTED) {
+            if (e.id == scenario.id) expected = &e;
+        }
+        bool pass = expected != nullptr && expected->records == fingerprint.records && expected->hash == fingerprint.hash;
+        std::cout << (pass ? "PASS " : "FAIL ") << std::left << std::setw(6) << scenario.id << std::right
+                  << ' ' << fingerprint.final() << std::endl;
+        for (unsigned threads : {1u, 4u}) {
+            for (FlatScheduler scheduler : {FlatScheduler::SCAN, FlatScheduler::CALENDAR}) {
+                TraceFingerprint flat = runFlatScenario(scenario, base_path, threads, scheduler);
+                if (flat.records != fingerprint.records || flat.hash != fingerprint.hash) {
+                    std::cout << "  flat coordinator (" << threads << " threads, "
+                              << (scheduler == FlatScheduler::SCAN ? "scan" : "calendar")
+                              << ") differs: " << flat.final() << std::endl;
+                    pass = false;
+                }
+            }
+        }
+        if (scenario.on_static) {
+            auto reference = scenario.build(base_path + scenario.input_file);
+            TraceFingerprint fixed = scenario.on_static(*reference, base_path + scenario.input_file, scenario.sim_time);
+            if (fixed.records != fingerprint.records || fixed.hash != fingerprint.hash) {
+                std::cout << "  static kernel differs: " << fixed.final() << std::endl;
+                pass = false;
+            }
+        }
+        if (!pass) {
+            failures++;
+            if (expected == nullptr) {
+                std::cout << "  no recorded fingerprint" << std::endl;
+            } else {
+                std::cout << "  expected " << expected->records << " records, hash " << hex(expected->hash) << std::endl;
+                std::cout << "  checkpoints every 16 records (records time hash):" << std::endl;
+                TraceFingerprint detail = runScenario(scenario, base_path, 16);
+                for (const auto& c : detail.checkpoints) std::cout << "    " << c << std::endl;
+            }
+        }
+    }
+    // no recorded fingerprints for other options, the static kernel has to agree with RootCoordinator
+    if (!print) failures += checkStaticConfigs(base_path);
+    if (!print) failures += checkReset(base_path);
+    if (!print) failures += checkServed(base_path);
+    if (!print) failures += checkTopology(base_path);
+    if (!print) failures += checkCache(base_path);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "========================================" << std::endl;
+    if (!print) {
+        std::cout << (failures == 0 ? "All fingerprints match" : std::to_string(failures) + " fingerprint(s) differ")
+                  << " (" << ms << " ms)" << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -44,16 +44,16 @@ std::ostream& operator<<(std::ostream &out, const MergerInputState& s) {
 // file-based input generator for merger
 class MergerInputGenerator : public Atomic<MergerInputState> {
 public:
-    Port<int> out1;
-    Port<int> out2;
-    Port<int> out3;
-    Port<int> out4;
+    PooledPort<PlaneMsg> out1;
+    PooledPort<PlaneMsg> out2;
+    PooledPort<PlaneMsg> out3;
+    PooledPort<PlaneMsg> out4;
 
     MergerInputGenerator(const std::string& id, const char* input_file) : Atomic<MergerInputState>(id, MergerInputState()) {
-        out1 = addOutPort<int>("out1");
-        out2 = addOutPort<int>("out2");
-        out3 = addOutPort<int>("out3");
-        out4 = addOutPort<int>("out4");
+        out1 = addPooledOutPort<PlaneMsg>(this, "out1");
+        out2 = addPooledOutPort<PlaneMsg>(this, "out2");
+        out3 = addPooledOutPort<PlaneMsg>(this, "out3");
+        out4 = addPooledOutPort<PlaneMsg>(this, "out4");
 
         std::ifstream file(input_file);
         double time;
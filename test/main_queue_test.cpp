@@ -11,6 +11,9 @@
  *   Q-3: Stop signal pauses output
  *   Q-4: Done signal resumes output
  *   Q-5: Enqueue while stopped
+ *   Q-6: Bounded queue (capacity 2) diverts the newest arrivals
+ *   Q-7: Bounded queue (capacity 2) diverts the oldest waiting plane
+ *   Q-8: Handover done (value 2) sends one plane, then holds until the next done
  *
  * Authors: Hasib Khodayar & Hajar Assim
  * Course: SYSC 4906G, Winter 2026
@@ -46,12 +49,12 @@ std::ostream& operator<<(std::ostream &out, const QueueInputState& s) {
 // file-based input generator for queue
 class QueueInputGenerator : public Atomic<QueueInputState> {
 public:
-    Port<int> out_plane;
+    PooledPort<PlaneMsg> out_plane;
     Port<int> out_stop;
     Port<int> out_done;
 
     QueueInputGenerator(const std::string& id, const char* input_file) : Atomic<QueueInputState>(id, QueueInputState()) {
-        out_plane = addOutPort<int>("out_plane");
+        out_plane = addPooledOutPort<PlaneMsg>(this, "out_plane");
         out_stop = addOutPort<int>("out_stop");
         out_done = addOutPort<int>("out_done");
 
@@ -101,9 +104,10 @@ public:
 // test bench
 class QueueTestBench : public Coupled {
 public:
-    QueueTestBench(const std::string& id, const char* input_file) : Coupled(id) {
+    QueueTestBench(const std::string& id, const char* input_file,
+                   std::size_t capacity, QueueOverflow policy) : Coupled(id) {
         auto generator = addComponent<QueueInputGenerator>("Generator", input_file);
-        auto queue = addComponent<Queue>("Queue");
+        auto queue = addComponent<Queue>("Queue", capacity, policy);
 
         addCoupling(generator->out_plane, queue->in);
         addCoupling(generator->out_stop, queue->stop);
@@ -111,13 +115,14 @@ public:
     }
 };
 
-void runTest(const std::string& test_id, const std::string& input_file, double sim_time) {
+void runTest(const std::string& test_id, const std::string& input_file, double sim_time,
+             std::size_t capacity = 0, QueueOverflow policy = QueueOverflow::DIVERT_NEWEST) {
     std::cout << "========================================" << std::endl;
     std::cout << "Queue Test: " << test_id << std::endl;
     std::cout << "Input file: " << input_file << std::endl;
     std::cout << "========================================" << std::endl;
 
-    auto model = std::make_shared<QueueTestBench>("QueueTest", input_file.c_str());
+    auto model = std::make_shared<QueueTestBench>("QueueTest", input_file.c_str(), capacity, policy);
     auto rootCoordinator = RootCoordinator(model);
 
     rootCoordinator.setLogger<STDOUTLogger>(";");
@@ -150,6 +155,9 @@ int main(int argc, char* argv[]) {
     runTest("Q-3", base_path + "Q3_stop_resume.txt", 100.0);
     runTest("Q-4", base_path + "Q4_stop_empty.txt", 100.0);
     runTest("Q-5", base_path + "Q5_enqueue_stopped.txt", 100.0);
+    runTest("Q-6", base_path + "Q6_overflow.txt", 100.0, 2, QueueOverflow::DIVERT_NEWEST);
+    runTest("Q-7", base_path + "Q6_overflow.txt", 100.0, 2, QueueOverflow::DIVERT_OLDEST);
+    runTest("Q-8", base_path + "Q8_handover.txt", 200.0);
 
     std::cout << "========================================" << std::endl;
     std::cout << "All Queue Tests Complete" << std::endl;
@@ -44,12 +44,12 @@ std::ostream& operator<<(std::ostream &out, const RunwayInputState& s) {
 // file-based input generator for runway
 class RunwayInputGenerator : public Atomic<RunwayInputState> {
 public:
-    Port<int> out_land;
-    Port<int> out_takeoff;
+    PooledPort<PlaneMsg> out_land;
+    PooledPort<PlaneMsg> out_takeoff;
 
     RunwayInputGenerator(const std::string& id, const char* input_file) : Atomic<RunwayInputState>(id, RunwayInputState()) {
-        out_land = addOutPort<int>("out_land");
-        out_takeoff = addOutPort<int>("out_takeoff");
+        out_land = addPooledOutPort<PlaneMsg>(this, "out_land");
+        out_takeoff = addPooledOutPort<PlaneMsg>(this, "out_takeoff");
 
         std::ifstream file(input_file);
         double time;
@@ -2,7 +2,7 @@
  * Test Driver for Selector Atomic Model
  *
  * Tests plane routing to storage bays based on plane ID ranges.
- * Uses IEStream to read test inputs from files.
+ * Uses PlaneGenerator to read test inputs from files.
  * Verifies Bug #4 fix - corrected boundaries (249, 499, 749, 999).
  *
  * Test Cases:
@@ -19,7 +19,7 @@
 #include <cadmium/simulation/root_coordinator.hpp>
 #include <cadmium/simulation/logger/stdout.hpp>
 #include <cadmium/modeling/devs/coupled.hpp>
-#include <cadmium/lib/iestream.hpp>
+#include "../atomics/planeGenerator.hpp"
 #include "../atomics/selector.hpp"
 #include <iostream>
 #include <string>
@@ -30,7 +30,7 @@ using namespace cadmium;
 class SelectorTestBench : public Coupled {
 public:
     SelectorTestBench(const std::string& id, const char* input_file) : Coupled(id) {
-        auto generator = addComponent<lib::IEStream<int>>("Generator", input_file);
+        auto generator = addComponent<PlaneGenerator>("Generator", input_file);
         auto selector = addComponent<Selector>("Selector");
 
         addCoupling(generator->out, selector->in);
@@ -2,11 +2,13 @@
  * Test Driver for StorageBay Atomic Model
  *
  * Tests the FIFO buffer storage and immediate draining behavior.
- * Uses IEStream to read test inputs from files.
+ * Uses PlaneGenerator to read test inputs from files.
  *
  * Test Cases:
  *   SB-1: Single plane storage and output
  *   SB-2: Multiple planes (FIFO order)
+ *   SB-3: Dwell mode, planes leave when their turnaround ends
+ *         (per-plane dwell column, 60s default, one dwell past 65536 ticks)
  *
  * Authors: Hasib Khodayar & Hajar Assim
  * Course: SYSC 4906G, Winter 2026
@@ -15,7 +17,7 @@
 #include <cadmium/simulation/root_coordinator.hpp>
 #include <cadmium/simulation/logger/stdout.hpp>
 #include <cadmium/modeling/devs/coupled.hpp>
-#include <cadmium/lib/iestream.hpp>
+#include "../atomics/planeGenerator.hpp"
 #include "../atomics/storageBay.hpp"
 #include <iostream>
 #include <string>
@@ -26,21 +28,22 @@ using namespace cadmium;
 // test bench using iestream
 class StorageBayTestBench : public Coupled {
 public:
-    StorageBayTestBench(const std::string& id, const char* input_file) : Coupled(id) {
-        auto generator = addComponent<lib::IEStream<int>>("Generator", input_file);
-        auto bay = addComponent<StorageBay>("StorageBay");
+    StorageBayTestBench(const std::string& id, const char* input_file, const DwellConfig& dwell) : Coupled(id) {
+        auto generator = addComponent<PlaneGenerator>("Generator", input_file);
+        auto bay = addComponent<StorageBay>("StorageBay", dwell);
 
         addCoupling(generator->out, bay->in);
     }
 };
 
-void runTest(const std::string& test_id, const std::string& input_file, double sim_time) {
+void runTest(const std::string& test_id, const std::string& input_file, double sim_time,
+             const DwellConfig& dwell = DwellConfig()) {
     std::cout << "========================================" << std::endl;
     std::cout << "StorageBay Test: " << test_id << std::endl;
     std::cout << "Input file: " << input_file << std::endl;
     std::cout << "========================================" << std::endl;
 
-    auto model = std::make_shared<StorageBayTestBench>("StorageBayTest", input_file.c_str());
+    auto model = std::make_shared<StorageBayTestBench>("StorageBayTest", input_file.c_str(), dwell);
     auto rootCoordinator = RootCoordinator(model);
 
     rootCoordinator.setLogger<STDOUTLogger>(";");
@@ -69,6 +72,11 @@ int main(int argc, char* argv[]) {
     runTest("SB-1", base_path + "SB1_single.txt", 50.0);
     runTest("SB-2", base_path + "SB2_fifo.txt", 50.0);
 
+    DwellConfig dwell;
+    dwell.enabled = true;
+    dwell.dwell = 60.0;
+    runTest("SB-3", base_path + "SB3_dwell.txt", 80000.0, dwell);
+
     std::cout << "========================================" << std::endl;
     std::cout << "All StorageBay Tests Complete" << std::endl;
     std::cout << "========================================" << std::endl;
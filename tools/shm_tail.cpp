@@ -0,0 +1,121 @@
+/*
+ * Shared-Memory Log Tail
+ *
+ * Follows the ring a ShmLogger publishes (see loggers/shm_ring.hpp) and
+ * prints each record in the same form as the CSV logger:
+ *   time;model_id;model_name;port_name;data
+ * Starts at the newest record unless --from-start is given, and exits
+ * once the simulation has stopped and every record has been read. If it
+ * falls more than a ring behind, it reports how many records it lost and
+ * carries on from the oldest one still in the ring.
+ *
+ * Usage: SHM_TAIL <shm_name> [--from-start]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include "../loggers/shm_ring.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+// map an existing ring read-only, waiting for the writer to create it
+ShmRingHeader* attach(const std::string& name, std::size_t& bytes) {
+    while (true) {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd >= 0) {
+            struct stat st;
+            if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) > sizeof(ShmRingHeader)) {
+                bytes = static_cast<std::size_t>(st.st_size);
+                void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (base == MAP_FAILED) return nullptr;
+                auto* header = static_cast<ShmRingHeader*>(base);
+                // wait for the writer to finish the header
+                while (header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                return header;
+            }
+            ::close(fd);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <shm_name> [--from-start]" << std::endl;
+        return 1;
+    }
+    std::string name = argv[1];
+    if (name[0] != '/') name.insert(0, "/");
+    bool from_start = (argc > 2 && std::strcmp(argv[2], "--from-start") == 0);
+
+    std::size_t bytes = 0;
+    ShmRingHeader* header = attach(name, bytes);
+    if (header == nullptr) {
+        std::cerr << "Error: cannot map shared memory " << name << std::endl;
+        return 1;
+    }
+    if (header->version != SHM_RING_VERSION || header->slot_size != SHM_RING_SLOT_SIZE ||
+        bytes < shmRingBytes(header->slot_count)) {
+        std::cerr << "Error: " << name << " is not a version " << SHM_RING_VERSION << " log ring" << std::endl;
+        return 1;
+    }
+
+    const std::uint64_t slot_count = header->slot_count;
+    const ShmRingSlot* slots = shmRingSlots(header);
+    std::uint64_t next = from_start ? 0 : header->write_seq.load(std::memory_order_acquire);
+    std::uint64_t lost = 0;
+    ShmRingSlot copy;
+
+    while (true) {
+        std::uint64_t written = header->write_seq.load(std::memory_order_acquire);
+        if (next >= written) {
+            if (header->closed.load(std::memory_order_acquire) != 0) break;
+            std::cout.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        // lapped, skip to the oldest record still in the ring
+        if (written - next > slot_count) {
+            lost += written - slot_count - next;
+            next = written - slot_count;
+        }
+
+        const ShmRingSlot& slot = slots[next & (slot_count - 1)];
+        std::uint64_t expected = 2 * next + 2;
+        std::uint64_t before = slot.seq.load(std::memory_order_acquire);
+        std::memcpy(static_cast<void*>(&copy), static_cast<const void*>(&slot), sizeof(copy));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t after = slot.seq.load(std::memory_order_relaxed);
+        if (before != expected || after != expected) {
+            // overwritten while we read it, the lap check above picks up from there
+            lost++;
+            next++;
+            continue;
+        }
+
+        const char* text = copy.text;
+        std::cout << copy.time << ';' << copy.model_id << ';';
+        std::cout.write(text, copy.name_len) << ';';
+        std::cout.write(text + copy.name_len, copy.port_len) << ';';
+        std::cout.write(text + copy.name_len + copy.port_len, copy.data_len) << '\n';
+        next++;
+    }
+
+    std::cout.flush();
+    if (lost > 0) std::cerr << "Lost " << lost << " records (reader fell behind)" << std::endl;
+    ::munmap(header, bytes);
+    return 0;
+}
@@ -0,0 +1,375 @@
+/*
+ * Trace Analyzer
+ *
+ * Full-scan statistics over a CSV simulation log, for the questions an
+ * index does not help with:
+ *   - per model, the simulated time spent in each phase (runway
+ *     occupancy, tower busy time, ...)
+ *   - per model with a size field, the time-weighted distribution of
+ *     that size (queue lengths, bay occupancy)
+ *   - per model and port, the message count and rate
+ *
+ * The log is memory-mapped and cut at line boundaries into one chunk
+ * per thread. Each thread finds the ';' and newline delimiters 16 bytes
+ * at a time with SSE2 compares (a scalar loop elsewhere) and builds
+ * partial results. The partials are then merged in chunk order. A model's
+ * state that starts in one chunk and ends in the next is carried across
+ * the seam, so the results do not depend on the thread count.
+ *
+ * Usage: TRACE_ANALYZE <trace.csv> [--threads=N]
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// yields the positions of ';' and '\n' in [begin, end) in order
+class DelimiterScanner {
+    const char* pos;    // start of the next 16-byte block
+    const char* end;
+    std::uint32_t mask; // delimiters left in the current block
+    const char* block;
+
+    void load() {
+#if defined(__SSE2__)
+        const __m128i semicolon = _mm_set1_epi8(';');
+        const __m128i newline = _mm_set1_epi8('\n');
+        while (end - pos >= 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+            __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, semicolon), _mm_cmpeq_epi8(bytes, newline));
+            mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+            block = pos;
+            pos += 16;
+            if (mask != 0) return;
+        }
+#endif
+        // tail (or no SSE2): one byte per bit
+        while (pos < end) {
+            block = pos;
+            mask = 0;
+            std::size_t n = std::min<std::size_t>(16, static_cast<std::size_t>(end - pos));
+            for (std::size_t i = 0; i < n; i++) {
+                if (pos[i] == ';' || pos[i] == '\n') mask |= 1u << i;
+            }
+            pos += n;
+            if (mask != 0) return;
+        }
+        mask = 0;
+    }
+
+public:
+    DelimiterScanner(const char* begin, const char* end)
+        : pos(begin), end(end), mask(0), block(begin) {}
+
+    // next delimiter, or nullptr at the end
+    const char* next() {
+        if (mask == 0) load();
+        if (mask == 0) return nullptr;
+        int bit = __builtin_ctz(mask);
+        mask &= mask - 1;
+        return block + bit;
+    }
+};
+
+struct StateValue {
+    std::string_view phase;
+    long size = -1;  // -1 when the state has no size field
+};
+
+// linear search, a trace has a handful of models and ports so this beats hashing
+template <typename Entry, typename Match>
+Entry* find(std::vector<Entry>& entries, Match match) {
+    for (auto& entry : entries) {
+        if (match(entry)) return &entry;
+    }
+    return nullptr;
+}
+
+struct ModelStats {
+    std::string_view name;
+    double first_time = 0;  // first state in this chunk, its start is in an earlier chunk
+    double last_time = 0;
+    StateValue last;
+    std::vector<std::pair<std::string_view, double>> phase_time;
+    std::vector<double> size_time;  // indexed by size
+
+    void add(const StateValue& value, double duration) {
+        if (duration <= 0) return;
+        if (!value.phase.empty()) addPhase(value.phase, duration);
+        if (value.size >= 0) addSize(static_cast<std::size_t>(value.size), duration);
+    }
+
+    void addPhase(std::string_view phase, double duration) {
+        auto* entry = find(phase_time, [phase](const auto& e) { return e.first == phase; });
+        if (entry != nullptr) entry->second += duration;
+        else phase_time.emplace_back(phase, duration);
+    }
+
+    void addSize(std::size_t size, double duration) {
+        if (size >= size_time.size()) size_time.resize(size + 1, 0.0);
+        size_time[size] += duration;
+    }
+};
+
+struct PortCount {
+    std::string_view model;
+    std::string_view port;
+    std::uint64_t count;
+};
+
+struct PartialResult {
+    std::vector<ModelStats> models;     // in order of first appearance
+    std::vector<PortCount> messages;
+    std::uint64_t records = 0;
+    double first_time = 0;
+    double last_time = 0;
+
+    ModelStats& model(std::string_view name, bool& inserted) {
+        auto* stats = find(models, [name](const ModelStats& m) { return m.name == name; });
+        inserted = (stats == nullptr);
+        if (stats != nullptr) return *stats;
+        models.emplace_back();
+        models.back().name = name;
+        return models.back();
+    }
+
+    void addMessages(std::string_view model, std::string_view port, std::uint64_t count) {
+        auto* entry = find(messages, [&](const PortCount& m) { return m.port == port && m.model == model; });
+        if (entry != nullptr) entry->count += count;
+        else messages.push_back(PortCount{model, port, count});
+    }
+};
+
+// plain decimals ("60", "90.5") inline, anything else through from_chars
+bool parseTime(const char* first, const char* last, double& time) {
+    std::uint64_t whole = 0, frac = 0, scale = 1;
+    const char* p = first;
+    for (; p < last && *p >= '0' && *p <= '9' && p - first < 15; p++) whole = whole * 10 + static_cast<std::uint64_t>(*p - '0');
+    if (p < last && *p == '.') {
+        for (p++; p < last && *p >= '0' && *p <= '9' && scale < 1000000000000ULL; p++) {
+            frac = frac * 10 + static_cast<std::uint64_t>(*p - '0');
+            scale *= 10;
+        }
+    }
+    if (p == last && p != first) {
+        time = static_cast<double>(whole) + static_cast<double>(frac) / static_cast<double>(scale);
+        return true;
+    }
+    auto parsed = std::from_chars(first, last, time);
+    return parsed.ec == std::errc() && parsed.ptr == last;
+}
+
+std::string_view field(std::string_view data, std::string_view key) {
+    std::size_t at = data.find(key);
+    if (at == std::string_view::npos) return {};
+    std::string_view value = data.substr(at + key.size());
+    return value.substr(0, value.find_first_of(",}"));
+}
+
+void analyzeChunk(const char* begin, const char* end, PartialResult& result) {
+    DelimiterScanner scanner(begin, end);
+    const char* line = begin;
+    const char* bounds[4];
+    int found = 0;
+    bool any = false;
+
+    while (true) {
+        const char* d = scanner.next();
+        if (d != nullptr && *d == ';') {
+            if (found < 4) bounds[found++] = d;
+            continue;
+        }
+        const char* eol = (d != nullptr) ? d : end;
+        if (found == 4) {
+            double time;
+            if (parseTime(line, bounds[0], time)) {
+                std::string_view model(bounds[1] + 1, static_cast<std::size_t>(bounds[2] - bounds[1] - 1));
+                std::string_view port(bounds[2] + 1, static_cast<std::size_t>(bounds[3] - bounds[2] - 1));
+                const char* data_end = (eol > bounds[3] && eol[-1] == '\r') ? eol - 1 : eol;
+                std::string_view data(bounds[3] + 1, static_cast<std::size_t>(data_end - bounds[3] - 1));
+
+                if (!any) result.first_time = time;
+                any = true;
+                result.last_time = time;
+                result.records++;
+                if (!port.empty()) {
+                    result.addMessages(model, port, 1);
+                } else if (!data.empty() && data.front() == '{') {
+                    bool inserted;
+                    ModelStats& stats = result.model(model, inserted);
+                    StateValue value;
+                    value.phase = field(data, "phase=");
+                    std::string_view size = field(data, "size=");
+                    if (!size.empty()) std::from_chars(size.data(), size.data() + size.size(), value.size);
+                    if (inserted) stats.first_time = time;
+                    else stats.add(stats.last, time - stats.last_time);
+                    stats.last_time = time;
+                    stats.last = value;
+                }
+            }
+        }
+        if (d == nullptr) break;
+        line = d + 1;
+        found = 0;
+    }
+}
+
+// fold the chunks together in order, carrying open states across seams
+PartialResult merge(std::vector<PartialResult>& parts) {
+    PartialResult total;
+    bool any = false;
+    for (auto& part : parts) {
+        if (part.records == 0) continue;
+        if (!any) total.first_time = part.first_time;
+        any = true;
+        total.last_time = part.last_time;
+        total.records += part.records;
+        for (const auto& m : part.messages) total.addMessages(m.model, m.port, m.count);
+
+        for (const auto& from : part.models) {
+            bool inserted;
+            ModelStats& into = total.model(from.name, inserted);
+            // the state open at the end of the previous chunks lasts until this chunk's first one
+            if (inserted) into.first_time = from.first_time;
+            else into.add(into.last, from.first_time - into.last_time);
+            for (const auto& [phase, t] : from.phase_time) into.addPhase(phase, t);
+            for (std::size_t size = 0; size < from.size_time.size(); size++) {
+                if (from.size_time[size] > 0) into.addSize(size, from.size_time[size]);
+            }
+            into.last_time = from.last_time;
+            into.last = from.last;
+        }
+    }
+    // last states run to the end of the trace
+    for (auto& stats : total.models) stats.add(stats.last, total.last_time - stats.last_time);
+    return total;
+}
+
+void printReport(const PartialResult& total) {
+    double span = total.last_time - total.first_time;
+    std::cout << "Records: " << total.records << ", time " << total.first_time << " to " << total.last_time << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::vector<ModelStats> models = total.models;
+    std::sort(models.begin(), models.end(), [](const ModelStats& a, const ModelStats& b) { return a.name < b.name; });
+    std::cout << std::endl << "State time per model (seconds, share of the run)" << std::endl;
+    for (auto& stats : models) {
+        if (stats.phase_time.empty() && stats.size_time.empty()) continue;
+        std::cout << stats.name << std::endl;
+        std::sort(stats.phase_time.begin(), stats.phase_time.end());
+        for (const auto& [phase, t] : stats.phase_time) {
+            std::cout << "  phase " << std::left << std::setw(10) << phase << std::right << std::setw(12) << t
+                      << std::setw(7) << (span > 0 ? 100.0 * t / span : 0.0) << "%" << std::endl;
+        }
+        if (!stats.size_time.empty()) {
+            double weighted = 0, total_time = 0;
+            for (std::size_t size = 0; size < stats.size_time.size(); size++) {
+                double t = stats.size_time[size];
+                if (t <= 0) continue;
+                weighted += static_cast<double>(size) * t;
+                total_time += t;
+                std::cout << "  size  " << std::left << std::setw(10) << size << std::right << std::setw(12) << t
+                          << std::setw(7) << (span > 0 ? 100.0 * t / span : 0.0) << "%" << std::endl;
+            }
+            std::cout << "  mean size " << std::setprecision(3) << (total_time > 0 ? weighted / total_time : 0.0)
+                      << std::setprecision(1) << std::endl;
+        }
+    }
+
+    std::vector<PortCount> messages = total.messages;
+    std::sort(messages.begin(), messages.end(), [](const PortCount& a, const PortCount& b) {
+        return std::tie(a.model, a.port) < std::tie(b.model, b.port);
+    });
+    std::cout << std::endl << "Messages per port (count, per simulated hour)" << std::endl;
+    for (const auto& m : messages) {
+        std::string name = std::string(m.model) + "." + std::string(m.port);
+        std::cout << "  " << std::left << std::setw(28) << name << std::right << std::setw(12) << m.count
+                  << std::setw(12) << (span > 0 ? m.count * 3600.0 / span : 0.0) << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <trace.csv> [--threads=N]" << std::endl;
+        return 1;
+    }
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--threads=", 0) == 0) {
+            threads = std::max(1, std::stoi(arg.substr(10)));
+        } else {
+            std::cout << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int fd = ::open(argv[1], O_RDONLY);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        std::cerr << "Error: cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    auto size = static_cast<std::size_t>(st.st_size);
+    if (size == 0) {
+        std::cerr << "Error: " << argv[1] << " is empty" << std::endl;
+        return 1;
+    }
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Error: cannot map " << argv[1] << std::endl;
+        return 1;
+    }
+    ::madvise(mapped, size, MADV_SEQUENTIAL);
+    const char* csv = static_cast<const char*>(mapped);
+
+    // cut just after a newline near each even split
+    std::vector<const char*> cuts{csv};
+    for (unsigned i = 1; i < threads; i++) {
+        const char* guess = csv + size * i / threads;
+        if (guess <= cuts.back()) continue;
+        const char* nl = static_cast<const char*>(std::memchr(guess, '\n', static_cast<std::size_t>(csv + size - guess)));
+        if (nl == nullptr) break;
+        cuts.push_back(nl + 1);
+    }
+    cuts.push_back(csv + size);
+
+    std::vector<PartialResult> parts(cuts.size() - 1);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i + 1 < cuts.size(); i++) {
+        workers.emplace_back(analyzeChunk, cuts[i], cuts[i + 1], std::ref(parts[i]));
+    }
+    for (auto& worker : workers) worker.join();
+    PartialResult total = merge(parts);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printReport(total);
+    std::cout << std::endl << "Scanned " << size / 1e6 << " MB with " << parts.size()
+              << " threads in " << seconds << " s (" << size / 1e6 / seconds << " MB/s)" << std::endl;
+    ::munmap(mapped, size);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * Trace Expander
+ *
+ * Turns a delta log written with --delta back into the CSV logger's
+ * output, byte for byte: keyframes and port messages are copied, and
+ * each delta is applied to its model's last state (delta_codec.hpp).
+ *
+ * Usage: TRACE_EXPAND <delta.csv> [output.csv] [--from=T]
+ *   the output defaults to the input with _delta.csv replaced by
+ *   _expanded.csv; --from starts decoding at time T (seconds), and a
+ *   model's records before its first keyframe from there are dropped
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include "../loggers/delta_codec.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// simulation_results/T3_delta.csv -> simulation_results/T3_expanded.csv
+std::string expandedFile(const std::string& input) {
+    std::size_t at = input.rfind("_delta.csv");
+    if (at != std::string::npos) return input.substr(0, at) + "_expanded.csv";
+    return input.substr(0, input.rfind(".csv")) + "_expanded.csv";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args;
+    double from = -std::numeric_limits<double>::infinity();
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--from=", 0) == 0) from = std::stod(arg.substr(7));
+        else args.push_back(arg);
+    }
+    if (args.empty() || args.size() > 2) {
+        std::cout << "Usage: " << argv[0] << " <delta.csv> [output.csv] [--from=T]" << std::endl;
+        return 1;
+    }
+    std::string input = args[0];
+    std::string output = (args.size() > 1) ? args[1] : expandedFile(input);
+
+    auto start = std::chrono::steady_clock::now();
+    int fd = ::open(input.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        std::cerr << "Error: cannot open " << input << std::endl;
+        return 1;
+    }
+    auto size = static_cast<std::size_t>(st.st_size);
+    const char* csv = nullptr;
+    if (size > 0) {
+        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "Error: cannot map " << input << std::endl;
+            return 1;
+        }
+        csv = static_cast<const char*>(mapped);
+        ::madvise(mapped, size, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+
+    std::vector<char> buffer(1 << 20);
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.open(output, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: cannot write " << output << std::endl;
+        return 1;
+    }
+
+    DeltaDecoder decoder;
+    std::string state;
+    std::uint64_t records = 0, expanded = 0, dropped = 0;
+    const char* p = csv;
+    const char* end = csv + size;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (eol == nullptr) eol = end;
+        std::string_view line(p, static_cast<std::size_t>(eol - p));
+        p = eol + 1;
+
+        // time;model_id;model_name;port_name;data, only state records (no port) are decoded
+        std::size_t sep[4];
+        std::size_t from_pos = 0;
+        int n = 0;
+        for (; n < 4; n++) {
+            sep[n] = line.find(';', from_pos);
+            if (sep[n] == std::string_view::npos) break;
+            from_pos = sep[n] + 1;
+        }
+        double time;
+        long model_id;
+        if (n < 4 || std::from_chars(line.data(), line.data() + sep[0], time).ec != std::errc() ||
+            std::from_chars(line.data() + sep[0] + 1, line.data() + sep[1], model_id).ec != std::errc()) {
+            // sep= and header lines, copied as they are
+            out << line << '\n';
+            continue;
+        }
+        if (time < from) continue;
+        records++;
+        if (sep[3] != sep[2] + 1) {
+            out << line << '\n';
+            continue;
+        }
+        std::string_view data = line.substr(sep[3] + 1);
+        if (!decoder.decode(model_id, data, state)) {
+            dropped++;
+            continue;
+        }
+        if (data.size() > 1 && data[0] == DELTA_MARKER && data[1] != DELTA_MARKER) expanded++;
+        out << line.substr(0, sep[3] + 1) << state << '\n';
+    }
+
+    out.close();
+    if (csv != nullptr) ::munmap(const_cast<char*>(csv), size);
+    if (!out) {
+        std::cerr << "Error: failed writing " << output << std::endl;
+        return 1;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Expanded " << records << " records (" << expanded << " deltas) into " << output
+              << " (" << ms << " ms)" << std::endl;
+    if (dropped > 0) std::cout << "Dropped " << dropped << " deltas before their model's first keyframe" << std::endl;
+    return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Trace Indexer
+ *
+ * Converts a CSV simulation log into the columnar trace store described
+ * in trace_store.hpp, so TRACE_QUERY can answer time-window and
+ * per-plane lookups without scanning the log. The CSV is memory-mapped
+ * and read once. Data fields are streamed straight into the store, and
+ * only the fixed-size columns (about 28 bytes per record) and the plane
+ * postings are held in memory until the end.
+ *
+ * Usage: TRACE_INDEX <trace.csv> [store.idx]
+ *   the store defaults to the CSV path with .csv replaced by .idx
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include "trace_store.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// string table, id 0 is the empty string
+class StringTable {
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::vector<std::string> strings;
+
+public:
+    StringTable() { intern(""); }
+
+    std::uint32_t intern(std::string_view s) {
+        auto it = ids.find(std::string(s));
+        if (it != ids.end()) return it->second;
+        auto id = static_cast<std::uint32_t>(strings.size());
+        strings.emplace_back(s);
+        ids.emplace(strings.back(), id);
+        return id;
+    }
+
+    [[nodiscard]] const std::vector<std::string>& all() const { return strings; }
+};
+
+template <typename T>
+void writeArray(std::ofstream& out, const std::vector<T>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+// pad to the next 8-byte boundary and return the offset
+std::uint64_t align(std::ofstream& out) {
+    static const char zeros[8] = {};
+    auto pos = static_cast<std::uint64_t>(out.tellp());
+    std::uint64_t pad = (8 - pos % 8) % 8;
+    out.write(zeros, static_cast<std::streamsize>(pad));
+    return pos + pad;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <trace.csv> [store.idx]" << std::endl;
+        return 1;
+    }
+    std::string input = argv[1];
+    std::string output = (argc > 2) ? argv[2] : input.substr(0, input.rfind(".csv")) + ".idx";
+
+    auto start = std::chrono::steady_clock::now();
+    int fd = ::open(input.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        std::cerr << "Error: cannot open " << input << std::endl;
+        return 1;
+    }
+    auto size = static_cast<std::size_t>(st.st_size);
+    const char* csv = nullptr;
+    if (size > 0) {
+        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "Error: cannot map " << input << std::endl;
+            return 1;
+        }
+        csv = static_cast<const char*>(mapped);
+        ::madvise(mapped, size, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: cannot write " << output << std::endl;
+        return 1;
+    }
+    TraceStoreHeader header{};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    header.data_offset = sizeof(header);
+
+    StringTable strings;
+    std::vector<double> times;
+    std::vector<std::uint32_t> model_ids, models, ports;
+    std::vector<std::uint64_t> text{0};
+    std::map<std::int64_t, std::vector<std::uint64_t>> plane_postings;
+    std::uint64_t skipped = 0;
+
+    const char* p = csv;
+    const char* end = csv + size;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (eol == nullptr) eol = end;
+        std::string_view line(p, static_cast<std::size_t>(eol - p));
+        p = eol + 1;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        // time;model_id;model_name;port_name;data, data may hold anything
+        std::string_view field[5];
+        std::size_t from = 0;
+        int n = 0;
+        for (; n < 4; n++) {
+            std::size_t sep = line.find(';', from);
+            if (sep == std::string_view::npos) break;
+            field[n] = line.substr(from, sep - from);
+            from = sep + 1;
+        }
+        field[4] = line.substr(std::min(from, line.size()));
+        double time;
+        std::uint32_t model_id;
+        if (n < 4 ||
+            std::from_chars(field[0].data(), field[0].data() + field[0].size(), time).ec != std::errc() ||
+            std::from_chars(field[1].data(), field[1].data() + field[1].size(), model_id).ec != std::errc()) {
+            // sep= and header lines, anything else is counted
+            if (!line.empty() && line.rfind("sep=", 0) != 0 && line.rfind("time;", 0) != 0) skipped++;
+            continue;
+        }
+        if (!times.empty() && time < times.back()) {
+            std::cerr << "Error: " << input << " is not in time order (" << time << " after "
+                      << times.back() << ")" << std::endl;
+            return 1;
+        }
+
+        std::uint64_t record = times.size();
+        times.push_back(time);
+        model_ids.push_back(model_id);
+        models.push_back(strings.intern(field[2]));
+        ports.push_back(strings.intern(field[3]));
+        out.write(field[4].data(), static_cast<std::streamsize>(field[4].size()));
+        text.push_back(text.back() + field[4].size());
+
+        std::int64_t plane = tracePlaneOf(field[3], field[4]);
+        if (plane != 0) plane_postings[plane].push_back(record);
+    }
+
+    header.magic = TRACE_STORE_MAGIC;
+    header.version = TRACE_STORE_VERSION;
+    header.block_size = TRACE_STORE_BLOCK;
+    header.records = times.size();
+
+    header.time_offset = align(out);
+    writeArray(out, times);
+    header.model_id_offset = align(out);
+    writeArray(out, model_ids);
+    header.model_offset = align(out);
+    writeArray(out, models);
+    header.port_offset = align(out);
+    writeArray(out, ports);
+    header.text_offset = align(out);
+    writeArray(out, text);
+
+    header.strings_offset = align(out);
+    header.string_count = strings.all().size();
+    std::vector<std::uint32_t> string_offsets{0};
+    for (const auto& s : strings.all()) string_offsets.push_back(string_offsets.back() + static_cast<std::uint32_t>(s.size()));
+    writeArray(out, string_offsets);
+    for (const auto& s : strings.all()) out.write(s.data(), static_cast<std::streamsize>(s.size()));
+
+    std::vector<double> sparse;
+    for (std::uint64_t i = 0; i < times.size(); i += TRACE_STORE_BLOCK) sparse.push_back(times[i]);
+    header.sparse_offset = align(out);
+    writeArray(out, sparse);
+
+    std::vector<TracePlaneEntry> entries;
+    std::uint64_t first = 0;
+    for (const auto& [plane, records] : plane_postings) {
+        entries.push_back(TracePlaneEntry{plane, first, records.size()});
+        first += records.size();
+    }
+    header.plane_offset = align(out);
+    header.plane_count = entries.size();
+    writeArray(out, entries);
+    header.postings_offset = align(out);
+    for (const auto& entry : plane_postings) writeArray(out, entry.second);
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (csv != nullptr) ::munmap(const_cast<char*>(csv), size);
+    if (!out) {
+        std::cerr << "Error: failed writing " << output << std::endl;
+        return 1;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Indexed " << header.records << " records, " << header.plane_count << " planes into "
+              << output << " (" << ms << " ms)" << std::endl;
+    if (skipped > 0) std::cout << "Skipped " << skipped << " malformed lines" << std::endl;
+    return 0;
+}
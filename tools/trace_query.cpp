@@ -0,0 +1,113 @@
+/*
+ * Trace Query
+ *
+ * Answers lookups on a store built by TRACE_INDEX and prints the
+ * matching records in the CSV logger's format:
+ *   time;model_id;model_name;port_name;data
+ *
+ * Usage: TRACE_QUERY <store.idx> plane <id> [from to]
+ *        TRACE_QUERY <store.idx> window <from> <to>
+ *        TRACE_QUERY <store.idx> stats
+ * Times are seconds or HH:MM[:SS] ("20:00" is 72000).
+ *
+ * A plane query returns every message carrying the plane and every
+ * state naming it, through the plane-ID inverted index. A window query
+ * finds its first record through the sparse time index. Both only touch
+ * the pages of the records they print.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include "trace_store.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+
+// seconds, or HH:MM[:SS], false if neither
+bool parseTime(const std::string& text, double& seconds) {
+    double parts[3] = {0, 0, 0};
+    int count = 0;
+    const char* p = text.c_str();
+    while (count < 3) {
+        char* end = nullptr;
+        parts[count++] = std::strtod(p, &end);
+        if (end == p) return false;
+        if (*end == '\0') break;
+        if (*end != ':') return false;
+        p = end + 1;
+    }
+    if (count == 1) seconds = parts[0];
+    else if (count == 2) seconds = parts[0] * 3600 + parts[1] * 60;
+    else seconds = parts[0] * 3600 + parts[1] * 60 + parts[2];
+    return true;
+}
+
+void printRecord(const TraceStore& store, std::uint64_t i) {
+    std::cout << store.time(i) << ';' << store.modelId(i) << ';' << store.model(i) << ';'
+              << store.port(i) << ';' << store.data(i) << '\n';
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " <store.idx> plane <id> [from to]" << std::endl;
+    std::cout << "       " << program << " <store.idx> window <from> <to>" << std::endl;
+    std::cout << "       " << program << " <store.idx> stats" << std::endl;
+    std::cout << "Times are seconds or HH:MM[:SS]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    auto start = std::chrono::steady_clock::now();
+    TraceStore store;
+    if (!store.open(argv[1])) {
+        std::cerr << "Error: " << argv[1] << " is not a version " << TRACE_STORE_VERSION << " trace store" << std::endl;
+        return 1;
+    }
+    std::string command = argv[2];
+    std::uint64_t printed = 0;
+
+    if (command == "stats" && argc == 3) {
+        std::cout << "Records: " << store.records() << std::endl;
+        if (store.records() > 0) {
+            std::cout << "Time: " << store.time(0) << " to " << store.time(store.records() - 1) << std::endl;
+        }
+        std::cout << "Planes: " << store.planeCount() << std::endl;
+        return 0;
+    } else if (command == "plane" && (argc == 4 || argc == 6)) {
+        char* end = nullptr;
+        std::int64_t id = std::strtoll(argv[3], &end, 10);
+        double from = -std::numeric_limits<double>::infinity();
+        double to = std::numeric_limits<double>::infinity();
+        if (*end != '\0' || (argc == 6 && (!parseTime(argv[4], from) || !parseTime(argv[5], to)))) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        auto [first, last] = store.plane(id);
+        // postings are in record order, so in time order too
+        first = std::lower_bound(first, last, from,
+            [&store](std::uint64_t r, double t) { return store.time(r) < t; });
+        for (; first != last && store.time(*first) <= to; ++first, ++printed) printRecord(store, *first);
+    } else if (command == "window" && argc == 5) {
+        double from, to;
+        if (!parseTime(argv[3], from) || !parseTime(argv[4], to)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        auto [first, last] = store.window(from, to);
+        for (std::uint64_t i = first; i < last; i++, printed++) printRecord(store, i);
+    } else {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout.flush();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << printed << " records (" << ms << " ms)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Indexed Trace Store
+ *
+ * On-disk layout of the columnar trace store TRACE_INDEX builds from a
+ * CSV log (time;model_id;model_name;port_name;data) and TRACE_QUERY
+ * reads. The store is memory-mapped, never loaded, so a query only
+ * touches the pages of the records it returns.
+ *
+ * File layout (little endian, every section 8-byte aligned):
+ *
+ *   TraceStoreHeader, 128 bytes (offsets below are from file start)
+ *   data      record data fields back to back, no separators
+ *   time      f64[records]           non-decreasing
+ *   model_id  u32[records]
+ *   model     u32[records]           string table index of the model name
+ *   port      u32[records]           string table index, 0 ("") for states
+ *   text      u64[records + 1]       record i's data is text[i]..text[i+1]
+ *   strings   u32[count + 1] offsets, then the characters
+ *   sparse    f64[blocks]            time of every block_size-th record
+ *   planes    TracePlaneEntry[plane_count], sorted by plane id
+ *   postings  u64[]                  record numbers, each plane's run sorted
+ *
+ * A record mentions a plane when it is a plane message (integer data on
+ * any port but the stop/done signals) or a state with a plane=N field,
+ * N != 0. Those records make up the plane's postings.
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#ifndef TRACE_STORE_HPP
+#define TRACE_STORE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+constexpr std::uint64_t TRACE_STORE_MAGIC = 0x3130584449524941ULL;  // "AIRIDX01"
+constexpr std::uint32_t TRACE_STORE_VERSION = 1;
+constexpr std::uint32_t TRACE_STORE_BLOCK = 1024;
+
+struct TraceStoreHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t block_size;      // records per sparse time index entry
+    std::uint64_t records;
+    std::uint64_t data_offset;
+    std::uint64_t time_offset;
+    std::uint64_t model_id_offset;
+    std::uint64_t model_offset;
+    std::uint64_t port_offset;
+    std::uint64_t text_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t string_count;
+    std::uint64_t sparse_offset;
+    std::uint64_t plane_offset;
+    std::uint64_t plane_count;
+    std::uint64_t postings_offset;
+    std::uint64_t reserved;
+};
+
+struct TracePlaneEntry {
+    std::int64_t plane;
+    std::uint64_t first;   // index into postings
+    std::uint64_t count;
+};
+
+static_assert(sizeof(TraceStoreHeader) == 128, "header layout");
+static_assert(sizeof(TracePlaneEntry) == 24, "plane entry layout");
+
+// plane id a record mentions, 0 for none
+inline std::int64_t tracePlaneOf(std::string_view port, std::string_view data) {
+    std::string_view digits;
+    if (!port.empty()) {
+        if (port.rfind("stop", 0) == 0 || port.rfind("done", 0) == 0) return 0;
+        digits = data;
+    } else {
+        std::size_t at = data.find("plane=");
+        if (at == std::string_view::npos) return 0;
+        digits = data.substr(at + 6);
+        digits = digits.substr(0, digits.find_first_of(",}"));
+    }
+    if (digits.empty() || digits.size() > 18) return 0;
+    bool negative = digits[0] == '-';
+    std::int64_t value = 0;
+    for (std::size_t i = negative ? 1 : 0; i < digits.size(); i++) {
+        if (digits[i] < '0' || digits[i] > '9') return 0;
+        value = value * 10 + (digits[i] - '0');
+    }
+    if (negative && digits.size() == 1) return 0;
+    return negative ? -value : value;
+}
+
+// read-only view of a mapped store
+class TraceStore {
+    void* base;
+    std::size_t bytes;
+    const TraceStoreHeader* header;
+    const double* times;
+    const std::uint32_t* model_ids;
+    const std::uint32_t* models;
+    const std::uint32_t* ports;
+    const std::uint64_t* text;
+    const char* blob;
+    const std::uint32_t* string_offsets;
+    const char* string_chars;
+    const double* sparse;
+    const TracePlaneEntry* planes;
+    const std::uint64_t* postings;
+
+    template <typename T>
+    const T* at(std::uint64_t offset) const {
+        return reinterpret_cast<const T*>(static_cast<const char*>(base) + offset);
+    }
+
+public:
+    TraceStore() : base(nullptr), bytes(0), header(nullptr), times(nullptr), model_ids(nullptr), models(nullptr),
+                   ports(nullptr), text(nullptr), blob(nullptr), string_offsets(nullptr), string_chars(nullptr),
+                   sparse(nullptr), planes(nullptr), postings(nullptr) {}
+
+    ~TraceStore() {
+        if (base != nullptr) ::munmap(base, bytes);
+    }
+
+    TraceStore(const TraceStore&) = delete;
+    TraceStore& operator=(const TraceStore&) = delete;
+
+    // map a store, false if it is missing or not a version 1 store
+    bool open(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(TraceStoreHeader)) {
+            ::close(fd);
+            return false;
+        }
+        bytes = static_cast<std::size_t>(st.st_size);
+        base = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            return false;
+        }
+        header = at<TraceStoreHeader>(0);
+        if (header->magic != TRACE_STORE_MAGIC || header->version != TRACE_STORE_VERSION ||
+            header->postings_offset > bytes) {
+            return false;
+        }
+        times = at<double>(header->time_offset);
+        model_ids = at<std::uint32_t>(header->model_id_offset);
+        models = at<std::uint32_t>(header->model_offset);
+        ports = at<std::uint32_t>(header->port_offset);
+        text = at<std::uint64_t>(header->text_offset);
+        blob = at<char>(header->data_offset);
+        string_offsets = at<std::uint32_t>(header->strings_offset);
+        string_chars = at<char>(header->strings_offset + (header->string_count + 1) * sizeof(std::uint32_t));
+        sparse = at<double>(header->sparse_offset);
+        planes = at<TracePlaneEntry>(header->plane_offset);
+        postings = at<std::uint64_t>(header->postings_offset);
+        return true;
+    }
+
+    [[nodiscard]] std::uint64_t records() const { return header->records; }
+    [[nodiscard]] std::uint64_t planeCount() const { return header->plane_count; }
+    [[nodiscard]] double time(std::uint64_t i) const { return times[i]; }
+    [[nodiscard]] std::uint32_t modelId(std::uint64_t i) const { return model_ids[i]; }
+    [[nodiscard]] std::string_view model(std::uint64_t i) const { return symbol(models[i]); }
+    [[nodiscard]] std::string_view port(std::uint64_t i) const { return symbol(ports[i]); }
+    [[nodiscard]] std::string_view data(std::uint64_t i) const {
+        return std::string_view(blob + text[i], text[i + 1] - text[i]);
+    }
+
+    [[nodiscard]] std::string_view symbol(std::uint32_t id) const {
+        return std::string_view(string_chars + string_offsets[id], string_offsets[id + 1] - string_offsets[id]);
+    }
+
+    // first record at or after t: sparse index picks the block, binary search inside it
+    [[nodiscard]] std::uint64_t lowerBound(double t) const {
+        std::uint64_t blocks = (header->records + header->block_size - 1) / header->block_size;
+        std::uint64_t b = std::lower_bound(sparse, sparse + blocks, t) - sparse;
+        std::uint64_t lo = (b == 0) ? 0 : (b - 1) * header->block_size;
+        std::uint64_t hi = std::min<std::uint64_t>(b * header->block_size, header->records);
+        return std::lower_bound(times + lo, times + hi, t) - times;
+    }
+
+    // first record after t
+    [[nodiscard]] std::uint64_t upperBound(double t) const {
+        std::uint64_t blocks = (header->records + header->block_size - 1) / header->block_size;
+        std::uint64_t b = std::upper_bound(sparse, sparse + blocks, t) - sparse;
+        std::uint64_t lo = (b == 0) ? 0 : (b - 1) * header->block_size;
+        std::uint64_t hi = std::min<std::uint64_t>(b * header->block_size, header->records);
+        return std::upper_bound(times + lo, times + hi, t) - times;
+    }
+
+    // records [first, last) with from <= time <= to
+    [[nodiscard]] std::pair<std::uint64_t, std::uint64_t> window(double from, double to) const {
+        return {lowerBound(from), upperBound(to)};
+    }
+
+    // postings of a plane, empty if it never appears
+    [[nodiscard]] std::pair<const std::uint64_t*, const std::uint64_t*> plane(std::int64_t id) const {
+        const TracePlaneEntry* end = planes + header->plane_count;
+        const TracePlaneEntry* entry = std::lower_bound(planes, end, id,
+            [](const TracePlaneEntry& e, std::int64_t v) { return e.plane < v; });
+        if (entry == end || entry->plane != id) return {postings, postings};
+        return {postings + entry->first, postings + entry->first + entry->count};
+    }
+};
+
+#endif // TRACE_STORE_HPP
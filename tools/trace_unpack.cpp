@@ -0,0 +1,161 @@
+/*
+ * Trace Unpacker
+ *
+ * Decompresses a segmented log written with --segments back into the
+ * CSV logger's file (format in segment_format.hpp). Segments are
+ * independent, so each thread takes the next one, decompresses it,
+ * checks it against the manifest checksum and writes it straight to its
+ * place in the output, which is known from the raw sizes in the
+ * manifest. A run that is still going is unpacked up to its last
+ * finished segment.
+ *
+ * Usage: TRACE_UNPACK <segment_dir> [output.csv] [--threads=N] [--segment=I]
+ *   the output defaults to the directory with _segments replaced by
+ *   _unpacked.csv; --segment writes only segment I
+ *
+ * Authors: Hasib Khodayar & Hajar Assim
+ * Course: SYSC 4906G, Winter 2026
+ */
+
+#include "../loggers/segment_format.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// simulation_results/T3_segments -> simulation_results/T3_unpacked.csv
+std::string unpackedFile(std::string directory) {
+    while (directory.size() > 1 && directory.back() == '/') directory.pop_back();
+    std::size_t at = directory.rfind("_segments");
+    if (at != std::string::npos) return directory.substr(0, at) + "_unpacked.csv";
+    return directory + "_unpacked.csv";
+}
+
+// decompresses one segment file into text, empty string if it is fine
+std::string unpackSegment(const std::string& path, const SegmentInfo& info, std::vector<char>& text) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> stored(info.stored_bytes);
+    if (!file.read(stored.data(), static_cast<std::streamsize>(stored.size()))) return "cannot read " + path;
+    if (stored.size() < sizeof(SEGMENT_MAGIC) || std::memcmp(stored.data(), SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0) {
+        return path + " is not a segment file";
+    }
+    text.resize(info.raw_bytes);
+    std::size_t in = sizeof(SEGMENT_MAGIC);
+    std::size_t out = 0;
+    while (in < stored.size()) {
+        std::uint32_t lengths[2];
+        if (stored.size() - in < sizeof(lengths)) return path + " is truncated";
+        std::memcpy(lengths, stored.data() + in, sizeof(lengths));
+        in += sizeof(lengths);
+        std::uint32_t raw = lengths[0], kept = lengths[1];
+        if (kept > stored.size() - in || raw > text.size() - out) return path + " is corrupt";
+        if (kept == raw) std::memcpy(text.data() + out, stored.data() + in, raw);
+        else if (!lzDecompress(stored.data() + in, kept, text.data() + out, raw)) return path + " is corrupt";
+        in += kept;
+        out += raw;
+    }
+    if (out != text.size() || segmentChecksum(text.data(), text.size()) != info.checksum) {
+        return path + " does not match its checksum";
+    }
+    return "";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    long only = -1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--threads=", 0) == 0) {
+            threads = std::max(1, std::stoi(arg.substr(10)));
+        } else if (arg.rfind("--segment=", 0) == 0) {
+            only = std::stol(arg.substr(10));
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cout << "Unknown option: " << arg << std::endl;
+            return 1;
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.empty() || args.size() > 2) {
+        std::cout << "Usage: " << argv[0] << " <segment_dir> [output.csv] [--threads=N] [--segment=I]" << std::endl;
+        return 1;
+    }
+    std::string directory = args[0];
+    std::string output = (args.size() > 1) ? args[1] : unpackedFile(directory);
+
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream manifest_file(directory + "/" + SEGMENT_MANIFEST);
+    if (!manifest_file) {
+        std::cerr << "Error: cannot open " << directory << "/" << SEGMENT_MANIFEST << std::endl;
+        return 1;
+    }
+    SegmentManifest manifest = readManifest(manifest_file);
+    std::vector<SegmentInfo> segments = manifest.segments;
+    if (only >= 0) {
+        if (static_cast<std::size_t>(only) >= segments.size()) {
+            std::cerr << "Error: " << directory << " has " << segments.size() << " segments" << std::endl;
+            return 1;
+        }
+        segments = {segments[static_cast<std::size_t>(only)]};
+    }
+
+    // each segment's place in the output
+    std::vector<std::uint64_t> offsets{0};
+    for (const auto& info : segments) offsets.push_back(offsets.back() + info.raw_bytes);
+
+    int fd = ::open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(offsets.back())) != 0) {
+        std::cerr << "Error: cannot write " << output << std::endl;
+        return 1;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::mutex error_mutex;
+    std::string error;
+    auto work = [&]() {
+        std::vector<char> text;
+        for (std::size_t i = next++; i < segments.size(); i = next++) {
+            std::string failure = unpackSegment(directory + "/" + segments[i].file, segments[i], text);
+            for (std::size_t done = 0; failure.empty() && done < text.size();) {
+                ssize_t n = ::pwrite(fd, text.data() + done, text.size() - done, static_cast<off_t>(offsets[i] + done));
+                if (n <= 0) failure = "failed writing " + output;
+                else done += static_cast<std::size_t>(n);
+            }
+            if (!failure.empty()) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (error.empty()) error = failure;
+                return;
+            }
+        }
+    };
+    threads = std::min<unsigned>(threads, std::max<std::size_t>(1, segments.size()));
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; i++) workers.emplace_back(work);
+    for (auto& worker : workers) worker.join();
+    ::close(fd);
+    if (!error.empty()) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+
+    std::uint64_t stored = 0, records = 0;
+    for (const auto& info : segments) {
+        stored += info.stored_bytes;
+        records += info.records;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Unpacked " << segments.size() << " segments, " << records << " records, " << stored / 1e6
+              << " MB to " << offsets.back() / 1e6 << " MB in " << output << " with " << threads << " threads ("
+              << seconds << " s)" << std::endl;
+    if (!manifest.complete) std::cout << "The run is still going, later segments are not in the manifest yet" << std::endl;
+    return 0;
+}
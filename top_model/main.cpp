@@ -1,8 +1,19 @@
 /*
  * Airport Simulation - Top Model
  *
- * Main driver for the airport DEVS simulation. Uses IEStream to read
+ * Main driver for the airport DEVS simulation. Uses PlaneGenerator to read
  * plane arrivals from input file and runs the full landing-storage-takeoff cycle.
+ * With --realtime the model is paced against the wall clock and takes its
+ * arrivals live from a FIFO or Unix socket instead (see RealTimeRunner).
+ * With --parallel or --scheduler=calendar a batch run uses FlatCoordinator
+ * instead of Cadmium's RootCoordinator, with --kernel=static the
+ * compile-time topology of coupled/staticAirport.hpp on the StaticKernel.
+ * With --serve it stays up and answers what-if scenarios on a Unix socket
+ * (see WhatIfServer). With --topology the model is built from a .ma file
+ * at run time (see TopologyBuilder) instead of AirportSimulation.
+ * Batch runs that write one log file are kept in a ResultCache, and a
+ * rerun with the same input, options and executable copies the log back
+ * instead of simulating (--no-cache to always simulate).
  *
  * Authors: Hasib Khodayar & Hajar Assim
  * Course: SYSC 4906G, Winter 2026
@@ -12,74 +23,83 @@
 #include <cadmium/simulation/logger/stdout.hpp>
 #include <cadmium/simulation/logger/csv.hpp>
 #include <cadmium/modeling/devs/coupled.hpp>
-#include <cadmium/lib/iestream.hpp>
 
-#include "../atomics/controlTower.hpp"
-#include "../atomics/queue.hpp"
-#include "../atomics/runway.hpp"
-#include "../coupled/hangar.hpp"
+#include "../atomics/planeGenerator.hpp"
+#include "../coupled/airportTop.hpp"
+#include "../coupled/staticAirport.hpp"
+#include "../coupled/topologyBuilder.hpp"
+#include "../simulation/realtime_runner.hpp"
+#include "../simulation/airport_estimator.hpp"
+#include "../simulation/flat_coordinator.hpp"
+#include "../simulation/what_if_server.hpp"
+#include "../simulation/result_cache.hpp"
+#include "../loggers/shm_logger.hpp"
+#include "../loggers/viewer_logger.hpp"
+#include "../loggers/fingerprint_logger.hpp"
+#include "../loggers/delta_logger.hpp"
+#include "../loggers/segment_logger.hpp"
+#include "../loggers/metrics_logger.hpp"
+#include "../loggers/plane_timing_logger.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sys/stat.h>
 #include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 using namespace cadmium;
 
-// airporttop the main airport model with queues tower runway hangar
-class AirportTop : public Coupled {
-public:
-    Port<int> in_landing;
-    Port<int> out_takeoff;
-
-    AirportTop(const std::string& id) : Coupled(id) {
-        in_landing = addInPort<int>("in_landing");
-        out_takeoff = addOutPort<int>("out_takeoff");
+// test bench uses plane generator for input
 
-        auto tower = addComponent<ControlTower>("ControlTower");
-        auto landing_queue = addComponent<Queue>("landing_queue");
-        auto takeoff_queue = addComponent<Queue>("takeoff_queue");
-        auto runway = addComponent<Runway>("Runway");
-        auto hangar = addComponent<Hangar>("Hangar");
-
-        // planes come in through landing queue
-        addCoupling(in_landing, landing_queue->in);
+class AirportSimulation : public Coupled {
+    std::shared_ptr<PlaneGenerator> generator;
+    std::shared_ptr<AirportTop> airport;
 
-        // queues send planes to tower
-        addCoupling(landing_queue->out, tower->in_landing);
-        addCoupling(takeoff_queue->out, tower->in_takeoff);
+public:
+    PooledPort<PlaneMsg> out_takeoff;
 
-        // tower controls the queues with stop done signals
-        addCoupling(tower->stop_landing, landing_queue->stop);
-        addCoupling(tower->stop_takeoff, takeoff_queue->stop);
-        addCoupling(tower->done_landing, landing_queue->done);
-        addCoupling(tower->done_takeoff, takeoff_queue->done);
+    AirportSimulation(const std::string& id, const char* input_file, const AirportConfig& config = AirportConfig()) : Coupled(id) {
+        out_takeoff = addPooledOutPort<PlaneMsg>(this, "out_takeoff");
 
-        // tower sends planes to runway
-        addCoupling(tower->land, runway->land);
-        addCoupling(tower->takeoff, runway->takeoff);
+        // generator reads the input file and stamps plane arrivals
+        generator = addComponent<PlaneGenerator>("Generator", input_file);
+        airport = addComponent<AirportTop>("Airport", config);
 
-        // after landing planes go to hangar then back to takeoff queue
-        addCoupling(runway->landing_exit, hangar->in);
-        addCoupling(hangar->hangar_exit, takeoff_queue->in);
+        addCoupling(generator->out, airport->in_landing);
+        addCoupling(airport->out_takeoff, out_takeoff);
+    }
 
-        // takeoff exit is the final output
-        addCoupling(runway->takeoff_exit, out_takeoff);
+    // a new run on input_file in the same model, see AirportTop::reset for config
+    void reset(const char* input_file, const AirportConfig& config) {
+        generator->reset(input_file);
+        airport->reset(config);
     }
 };
 
-// test bench uses iestream for input
-
-class AirportSimulation : public Coupled {
+// live variant, arrivals are injected on in_landing by the real-time runner
+class LiveAirportSimulation : public Coupled {
 public:
-    Port<int> out_takeoff;
+    PooledPort<PlaneMsg> in_landing;
+    PooledPort<PlaneMsg> out_takeoff;
 
-    AirportSimulation(const std::string& id, const char* input_file) : Coupled(id) {
-        out_takeoff = addOutPort<int>("out_takeoff");
+    LiveAirportSimulation(const std::string& id, const AirportConfig& config = AirportConfig()) : Coupled(id) {
+        in_landing = addPooledInPort<PlaneMsg>(this, "in_landing");
+        out_takeoff = addPooledOutPort<PlaneMsg>(this, "out_takeoff");
 
-        // iestream reads the input file and generates plane arrivals
-        auto generator = addComponent<lib::IEStream<int>>("Generator", input_file);
-        auto airport = addComponent<AirportTop>("Airport");
+        auto airport = addComponent<AirportTop>("Airport", config);
 
-        addCoupling(generator->out, airport->in_landing);
+        addCoupling(in_landing, airport->in_landing);
         addCoupling(airport->out_takeoff, out_takeoff);
     }
 };
@@ -94,41 +114,693 @@ std::string getTestName(const std::string& path) {
     return path.substr(lastSlash, lastDot - lastSlash);
 }
 
+// where the trace goes, the CSV file unless a shared-memory ring, viewer files, a fingerprint, a delta log or segments are asked for
+struct OutputOptions {
+    std::string shm_name;
+    std::uint64_t shm_slots = 65536;
+    std::string viewer_dir;
+    bool fingerprint = false;
+    std::uint64_t fingerprint_interval = 1000;
+    std::string compare_file;  // checkpoints of an earlier run to check against
+    std::shared_ptr<TraceFingerprint> fingerprint_result = std::make_shared<TraceFingerprint>();
+    bool delta = false;
+    std::uint64_t delta_keyframe = 100;  // every Nth state of a model is written in full
+    bool segments = false;
+    std::uint64_t segment_mb = 64;
+    double segment_time = 0;  // seconds of simulated time per segment, 0 for size only
+    std::string metrics_file;  // live metrics, published alongside any of the above
+    double metrics_interval = 1.0;
+    std::shared_ptr<AirportMetrics> metrics;  // set when metrics_file is
+};
+
+// simulation_results/T1_output.csv -> simulation_results/T1_fingerprint.txt
+std::string fingerprintFile(const std::string& output_file) {
+    return output_file.substr(0, output_file.rfind("_output.csv")) + "_fingerprint.txt";
+}
+
+// simulation_results/T1_output.csv -> simulation_results/T1_delta.csv
+std::string deltaFile(const std::string& output_file) {
+    return output_file.substr(0, output_file.rfind("_output.csv")) + "_delta.csv";
+}
+
+// simulation_results/T1_output.csv -> simulation_results/T1_segments
+std::string segmentDirectory(const std::string& output_file) {
+    return output_file.substr(0, output_file.rfind("_output.csv")) + "_segments";
+}
+
+// a T logger, wrapped in a MetricsLogger when live metrics are on
+template <typename T, typename Root, typename... Args>
+void setLogger(Root& rootCoordinator, const OutputOptions& output, Args&&... args) {
+    if (output.metrics) {
+        rootCoordinator.template setLogger<MetricsLogger>(std::make_shared<T>(std::forward<Args>(args)...), output.metrics);
+    } else {
+        rootCoordinator.template setLogger<T>(std::forward<Args>(args)...);
+    }
+}
+
+template <typename Root>
+void attachLogger(Root& rootCoordinator, const std::shared_ptr<Coupled>& model,
+                  const std::string& output_file, const OutputOptions& output) {
+    if (!output.shm_name.empty()) {
+        setLogger<ShmLogger>(rootCoordinator, output, output.shm_name, output.shm_slots);
+    } else if (!output.viewer_dir.empty()) {
+        setLogger<ViewerLogger>(rootCoordinator, output, output.viewer_dir + "/Airport", model);
+    } else if (output.fingerprint) {
+        output.fingerprint_result->interval = output.fingerprint_interval;
+        setLogger<FingerprintLogger>(rootCoordinator, output, output.fingerprint_result);
+    } else if (output.delta) {
+        setLogger<DeltaLogger>(rootCoordinator, output, deltaFile(output_file), ";", output.delta_keyframe);
+    } else if (output.segments) {
+        setLogger<SegmentLogger>(rootCoordinator, output, segmentDirectory(output_file), ";",
+                                 output.segment_mb << 20, output.segment_time);
+    } else {
+        setLogger<CSVLogger>(rootCoordinator, output, output_file, ";");
+    }
+}
+
+// publishes output.metrics to the metrics file while alive, nothing without --metrics
+std::unique_ptr<MetricsPublisher> startMetrics(const OutputOptions& output) {
+    if (!output.metrics) return nullptr;
+    auto publisher = std::make_unique<MetricsPublisher>(
+        output.metrics_file, std::chrono::milliseconds(static_cast<long>(output.metrics_interval * 1000)), *output.metrics);
+    publisher->start();
+    return publisher;
+}
+
+void printOutput(const std::string& output_file, const OutputOptions& output) {
+    if (!output.shm_name.empty()) {
+        std::cout << "Output: shared memory " << output.shm_name << " (" << output.shm_slots << " slots)" << std::endl;
+    } else if (!output.viewer_dir.empty()) {
+        std::cout << "Output: web viewer files in " << output.viewer_dir << std::endl;
+    } else if (output.fingerprint) {
+        std::cout << "Output: trace fingerprint, checkpoint every " << output.fingerprint_interval
+                  << " records" << std::endl;
+    } else if (output.delta) {
+        std::cout << "Output file: " << deltaFile(output_file) << " (changed fields only, keyframe every "
+                  << output.delta_keyframe << " states)" << std::endl;
+    } else if (output.segments) {
+        std::cout << "Output: compressed segments in " << segmentDirectory(output_file) << " (" << output.segment_mb
+                  << " MB";
+        if (output.segment_time > 0) std::cout << " or " << output.segment_time << " simulated seconds";
+        std::cout << " each)" << std::endl;
+    } else {
+        std::cout << "Output file: " << output_file << std::endl;
+    }
+    if (output.metrics) {
+        std::cout << "Metrics: " << output.metrics_file << " (every " << output.metrics_interval << " s)" << std::endl;
+    }
+}
+
+std::string outputTarget(const std::string& output_file, const OutputOptions& output) {
+    if (!output.shm_name.empty()) return output.shm_name;
+    if (!output.viewer_dir.empty()) return output.viewer_dir;
+    if (output.fingerprint) return fingerprintFile(output_file);
+    if (output.delta) return deltaFile(output_file);
+    if (output.segments) return segmentDirectory(output_file);
+    return output_file;
+}
+
+// save and print the fingerprint, 2 if it differs from the --compare run
+int reportFingerprint(const std::string& output_file, const OutputOptions& output) {
+    if (!output.fingerprint) return 0;
+    const TraceFingerprint& fingerprint = *output.fingerprint_result;
+    // read the saved run first, it may be the file this run is about to replace
+    std::vector<FingerprintCheckpoint> saved;
+    if (!output.compare_file.empty()) {
+        std::ifstream saved_file(output.compare_file);
+        if (!saved_file) {
+            std::cout << "Cannot read checkpoints from " << output.compare_file << std::endl;
+            return 1;
+        }
+        saved = readCheckpoints(saved_file);
+    }
+    std::ofstream file(fingerprintFile(output_file));
+    writeCheckpoints(file, fingerprint);
+    std::cout << "Fingerprint: " << fingerprint.final() << " (records time hash)" << std::endl;
+    if (output.compare_file.empty()) return 0;
+
+    std::vector<FingerprintCheckpoint> current = fingerprint.checkpoints;
+    current.push_back(fingerprint.final());
+    std::size_t i = firstDivergence(saved, current);
+    if (i == saved.size() && i == current.size()) {
+        std::cout << "Trace matches " << output.compare_file << std::endl;
+        return 0;
+    }
+    // identical up to checkpoint i-1, differs by checkpoint i (or one run is longer)
+    std::uint64_t from = (i == 0) ? 0 : current[i - 1].records;
+    double from_time = (i == 0) ? 0.0 : current[i - 1].time;
+    std::cout << "Trace differs from " << output.compare_file << " after record " << from
+              << " (time " << from_time << ")";
+    if (i < current.size()) std::cout << ", by record " << current[i].records << " (time " << current[i].time << ")";
+    std::cout << std::endl;
+    return 2;
+}
+
+// what the log of a batch run depends on; not the coordinator or kernel, they all give the same trace
+RunKey runKey(const std::string& input_file, double sim_time, const AirportConfig& config,
+              const std::string& topology_file, const OutputOptions& output) {
+    RunKey key;
+    key.addFile("model", "/proc/self/exe");
+    key.addFile("input", input_file);
+    key.add("time", sim_time);
+    key.add("options", airportOptions(config));
+    if (!topology_file.empty()) key.addFile("topology", topology_file);
+    if (output.fingerprint) {
+        key.add("log", "fingerprint " + std::to_string(output.fingerprint_interval));
+    } else if (output.delta) {
+        key.add("log", "delta " + std::to_string(output.delta_keyframe));
+    } else {
+        key.add("log", "csv");
+    }
+    return key;
+}
+
+// the fingerprint of a run from its checkpoint file, as the logger left it
+void readFingerprint(const std::string& path, TraceFingerprint& fingerprint) {
+    std::ifstream file(path);
+    fingerprint.checkpoints = readCheckpoints(file);
+    if (fingerprint.checkpoints.empty()) return;
+    FingerprintCheckpoint last = fingerprint.checkpoints.back();
+    fingerprint.checkpoints.pop_back();
+    fingerprint.records = last.records;
+    fingerprint.time = last.time;
+    fingerprint.hash = last.hash;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " <input_file|-> [simulation_time] [options]" << std::endl;
+    std::cout << "       " << program << " --realtime[=SPEED] --fifo=PATH|--socket=PATH [simulation_time] [options]" << std::endl;
+    std::cout << "       " << program << " --serve=PATH [--workers=N] [options]" << std::endl;
+    std::cout << "Input format: time plane_id [class priority fuel dwell] (one per line)" << std::endl;
+    std::cout << "Input '-' streams arrivals from stdin; stdin and FIFOs run until the writer closes" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --tower=fifo|priority   control tower scheduling (default fifo)" << std::endl;
+    std::cout << "  --queue-capacity=N      bound each queue to N planes, divert the rest (default unbounded, refused with --tower=priority)" << std::endl;
+    std::cout << "  --queue-policy=newest|oldest  plane diverted when a queue is full (default newest)" << std::endl;
+    std::cout << "  --dwell=S               park planes S seconds in the hangar unless the input gives a dwell" << std::endl;
+    std::cout << "  --dwell-exp=MEAN        draw hangar dwells from an exponential distribution" << std::endl;
+    std::cout << "  --seed=N                random seed for drawn dwells (default 1)" << std::endl;
+    std::cout << "  --hangar=aggregate      model the hangar as one FIFO delay line (default detailed)" << std::endl;
+    std::cout << "  --signals=coalesced     send the tower's stop/done signals only where they change a queue" << std::endl;
+    std::cout << "  --parallel[=N]          flat coordinator, models of wide steps run on N threads (default all cores)" << std::endl;
+    std::cout << "  --parallel-min=N        fewest models in a step to run them in parallel (default 8)" << std::endl;
+    std::cout << "  --scheduler=calendar    flat coordinator, next models from an indexed heap instead of a scan" << std::endl;
+    std::cout << "  --kernel=static         run on the compile-time airport topology instead of Cadmium's coordinators" << std::endl;
+    std::cout << "  --topology=FILE         build the model from a .ma topology file (see input_data/topology) instead" << std::endl;
+    std::cout << "  --no-cache              simulate even if the result cache holds this run, and do not store it" << std::endl;
+    std::cout << "  --cache=DIR             result cache directory (default simulation_cache)" << std::endl;
+    std::cout << "  --realtime[=SPEED]      pace against the wall clock, SPEED simulated seconds per second (default 1)" << std::endl;
+    std::cout << "  --fifo=PATH             real-time arrivals from a named pipe, lines: now|time plane_id [...]" << std::endl;
+    std::cout << "  --socket=PATH           real-time arrivals from a Unix domain socket, same lines" << std::endl;
+    std::cout << "  --shm=NAME              publish the trace to a shared-memory ring instead of the CSV file" << std::endl;
+    std::cout << "  --shm-slots=N           ring size in records (default 65536)" << std::endl;
+    std::cout << "  --viewer=DIR            write the web viewer files (Airport.ma, messages, states) to DIR instead" << std::endl;
+    std::cout << "  --fingerprint[=N]       hash the trace instead of logging it, checkpoint every N records (default 1000)" << std::endl;
+    std::cout << "  --compare=FILE          with --fingerprint, locate the first difference from a saved checkpoint file" << std::endl;
+    std::cout << "  --delta[=N]             log only the state fields that change, every Nth state in full (default 100)" << std::endl;
+    std::cout << "  --segments[=MB]         write the log as compressed segments of MB megabytes with a manifest (default 64)" << std::endl;
+    std::cout << "  --segment-time=S        with --segments, also start a new segment every S simulated seconds" << std::endl;
+    std::cout << "  --metrics=FILE          keep live metrics (time, event rate, queues, tower) in FILE while running" << std::endl;
+    std::cout << "  --metrics-interval=S    seconds between metrics updates (default 1)" << std::endl;
+    std::cout << "  --estimate[=RATE|=FROM:TO:STEP]  print queueing estimates for arrivals per hour instead of simulating" << std::endl;
+    std::cout << "  --calibrate [files]     compare the estimates with simulations of the T scenarios (or the files given)" << std::endl;
+    std::cout << "  --serve=PATH            answer what-if scenarios on a Unix domain socket until Ctrl-C" << std::endl;
+    std::cout << "  --workers=N             with --serve, requests served at once, each worker with warm models (default all cores)" << std::endl;
+}
+
+// real-time mode, runs until simulation_time has passed on the wall clock or Ctrl-C
+int runRealTime(const std::vector<std::string>& args, const AirportConfig& config, const RealTimeOptions& options,
+                const OutputOptions& output) {
+    if (options.speed <= 0 || (options.fifo_path.empty() == options.socket_path.empty())) {
+        std::cout << "Real-time mode needs a positive speed and exactly one of --fifo or --socket" << std::endl;
+        return 1;
+    }
+    double sim_time = !args.empty() ? std::stod(args[0]) : std::numeric_limits<double>::infinity();
+    std::string source = options.fifo_path.empty() ? options.socket_path : options.fifo_path;
+    std::string output_file = "simulation_results/" + getTestName(source) + "_output.csv";
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "Airport Simulation Starting (real time)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Input " << (options.fifo_path.empty() ? "socket: " : "FIFO: ") << source << std::endl;
+    printOutput(output_file, output);
+    std::cout << "Simulation time: " << sim_time << " seconds" << std::endl;
+    std::cout << "Speed: " << options.speed << "x wall clock" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+
+    auto model = std::make_shared<LiveAirportSimulation>("AirportSimulation", config);
+    auto rootCoordinator = RootCoordinator(model);
+    RealTimeRunner runner(rootCoordinator, model->in_landing, options);
+    if (!runner.open()) return 1;
+    std::signal(SIGINT, [](int) { RealTimeRunner::interrupted = 1; });
+
+    attachLogger(runner, model, output_file, output);
+    auto metrics = startMetrics(output);
+    rootCoordinator.start();
+    RealTimeReport report = runner.run(sim_time);
+    rootCoordinator.stop();
+    metrics.reset();
+
+    std::cout << report;
+    std::cout << "Simulation complete. Results saved to: "
+              << outputTarget(output_file, output) << std::endl;
+    return reportFingerprint(output_file, output);
+}
+
+// server mode, what-if requests on a Unix socket until Ctrl-C
+int runServe(WhatIfOptions options) {
+    WhatIfServer server(options);
+    if (!server.open()) return 1;
+    std::signal(SIGINT, [](int) { WhatIfServer::interrupted = 1; });
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "Airport What-If Server" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Socket: " << options.socket_path << std::endl;
+    std::cout << "Workers: " << options.workers << std::endl;
+    std::cout << "========================================" << std::endl;
+    WhatIfReport report = server.run();
+    std::cout << std::endl << report;
+    return 0;
+}
+
+// estimate mode, closed-form waits and queue lengths for a range of arrival rates
+int runEstimate(const std::string& range, const AirportConfig& config) {
+    double from = 2, to = 28, step = 2;
+    if (!range.empty()) {
+        char* end = nullptr;
+        from = to = std::strtod(range.c_str(), &end);
+        if (*end == ':') {
+            to = std::strtod(end + 1, &end);
+            if (*end == ':') step = std::strtod(end + 1, &end);
+        }
+        if (*end != '\0' || step <= 0 || to < from) {
+            std::cout << "Estimate range must be RATE or FROM:TO:STEP arrivals per hour" << std::endl;
+            return 1;
+        }
+    }
+    double dwell = config.hangar_dwell.enabled ? config.hangar_dwell.dwell : 0.0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<AirportEstimate> curve;
+    for (double rate = from; rate <= to + 1e-9; rate += step) curve.push_back(estimateAirport(rate, dwell));
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Runway " << RunwayState::RUNWAY_TIME << " s per operation, landings first; selector "
+              << SelectorState::ROUTING_TIME << " s per plane; hangar dwell " << dwell << " s" << std::endl;
+    std::cout << "arrivals/h  runway  land wait  takeoff wait  land queue  takeoff queue  in system" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& e : curve) {
+        std::cout << std::setw(10) << e.arrivals_per_hour << std::setw(7) << e.runway_utilization * 100 << "%";
+        if (!e.stable) {
+            std::cout << "  saturated" << std::endl;
+            continue;
+        }
+        std::cout << std::setw(10) << e.landing_wait << "s" << std::setw(13) << e.takeoff_wait << "s"
+                  << std::setw(12) << e.landing_queue << std::setw(15) << e.takeoff_queue
+                  << std::setw(10) << e.time_in_system << "s" << std::endl;
+    }
+    if (dwell > 0) {
+        const AirportEstimate& last = curve.back();
+        std::cout << "Bays at " << last.arrivals_per_hour << "/h:";
+        for (double planes : last.bay_planes) std::cout << " " << planes;
+        std::cout << " planes" << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "Computed " << curve.size() << " points in " << us << " us" << std::endl;
+    return 0;
+}
+
+// Poisson arrivals at rate per hour with uniform plane IDs, written to a temporary file
+std::string writePoissonScenario(double per_hour, int planes, std::uint64_t seed) {
+    char path[] = "/tmp/airport_calibrate_XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0) return "";
+    ::close(fd);
+    std::ofstream file(path);
+    file << poissonArrivals(per_hour, planes, seed);
+    return path;
+}
+
+// simulate one scenario with the timing logger, on a model reset for it
+PlaneTimings simulateTimings(AirportSimulation& model, FlatCoordinator& coordinator, const std::string& input_file,
+                             const AirportConfig& config) {
+    auto timings = std::make_shared<PlaneTimings>();
+    model.reset(input_file.c_str(), config);
+    coordinator.reset();
+    coordinator.setLogger<PlaneTimingLogger>(timings);
+    coordinator.setLogStates(false);
+    coordinator.start();
+    coordinator.simulate(std::numeric_limits<double>::infinity());
+    coordinator.stop();
+    return *timings;
+}
+
+// calibrate mode, estimator against simulated scenarios
+int runCalibrate(std::vector<std::string> inputs, const AirportConfig& config) {
+    struct Scenario {
+        std::string name;
+        std::string file;
+        bool temporary;
+    };
+    std::vector<Scenario> scenarios;
+    if (inputs.empty()) {
+        for (const char* name : {"T1_single_lifecycle", "T2_burst_test", "T3_staggered_test", "T4_rapid_test",
+                                 "T5_boundary_test", "T6_bay_stress_test"}) {
+            scenarios.push_back(Scenario{name, std::string("input_data/") + name + ".txt", false});
+        }
+        // steady Poisson traffic, the estimator's own assumption
+        for (double rate : {6.0, 12.0, 18.0, 24.0}) {
+            std::string file = writePoissonScenario(rate, 5000, 1);
+            if (file.empty()) continue;
+            std::ostringstream name;
+            name << "poisson_" << rate << "_per_h";
+            scenarios.push_back(Scenario{name.str(), file, true});
+        }
+    } else {
+        for (const auto& input : inputs) scenarios.push_back(Scenario{getTestName(input), input, false});
+    }
+    double dwell = config.hangar_dwell.enabled ? config.hangar_dwell.dwell : 0.0;
+
+    std::cout << "Waits in seconds, mean per plane: simulated / estimated (error)" << std::endl;
+    std::cout << std::left << std::setw(22) << "scenario" << std::right << std::setw(7) << "planes"
+              << std::setw(9) << "rate/h" << std::setw(17) << "runway" << std::setw(26) << "landing wait"
+              << std::setw(26) << "takeoff wait" << std::endl;
+    double error_sum = 0;
+    int compared = 0;
+    // one model for every scenario, reset in place between them
+    auto model = std::make_shared<AirportSimulation>("AirportSimulation", "/dev/null", config);
+    FlatCoordinator coordinator(model);
+    for (const auto& scenario : scenarios) {
+        PlaneTimings sim = simulateTimings(*model, coordinator, scenario.file, config);
+        if (scenario.temporary) std::remove(scenario.file.c_str());
+        double rate = sim.arrivalsPerHour();
+        std::cout << std::left << std::setw(22) << scenario.name << std::right << std::setw(7) << sim.arrivals
+                  << std::fixed << std::setprecision(1) << std::setw(9) << rate;
+        if (sim.departures < 2 || rate <= 0) {
+            std::cout << "  too few planes to compare" << std::defaultfloat << std::setprecision(6) << std::endl;
+            continue;
+        }
+        AirportEstimate est = estimateAirport(rate, dwell);
+        double span = sim.last_departure - sim.first_arrival;
+        double utilization = span > 0 ? sim.runway_operations * RunwayState::RUNWAY_TIME / span : 0.0;
+        double landing = sim.landing_wait / sim.departures;
+        double takeoff = sim.takeoff_wait / sim.departures;
+        std::cout << std::setw(8) << utilization * 100 << "%/" << std::setw(5) << est.runway_utilization * 100 << "%";
+        if (!est.stable) {
+            std::cout << std::setw(10) << landing << " / saturated" << std::setw(10) << takeoff << " / saturated"
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+            continue;
+        }
+        double landing_error = est.landing_wait - landing;
+        double takeoff_error = est.takeoff_wait - takeoff;
+        std::cout << std::setw(10) << landing << " /" << std::setw(6) << est.landing_wait << " (" << std::showpos
+                  << std::setw(6) << landing_error << ")" << std::noshowpos << std::setw(10) << takeoff << " /"
+                  << std::setw(6) << est.takeoff_wait << " (" << std::showpos << std::setw(6) << takeoff_error << ")"
+                  << std::noshowpos << std::defaultfloat << std::setprecision(6) << std::endl;
+        error_sum += std::abs(landing_error) + std::abs(takeoff_error);
+        compared += 2;
+    }
+    if (compared > 0) {
+        std::cout << "Mean absolute wait error: " << std::fixed << std::setprecision(1) << error_sum / compared
+                  << " s over " << compared / 2 << " scenarios" << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+    return 0;
+}
+
 // main
 
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        std::cout << "Usage: " << argv[0] << " <input_file> [simulation_time]" << std::endl;
-        std::cout << "Input format: time plane_id (one per line)" << std::endl;
+    // split options from the positional input file and simulation time
+    std::vector<std::string> args;
+    AirportConfig config;
+    bool realtime = false;
+    bool estimate = false;
+    bool calibrate = false;
+    WhatIfOptions serve;
+    serve.workers = std::max(1u, std::thread::hardware_concurrency());
+    std::string estimate_range;
+    RealTimeOptions rt_options;
+    OutputOptions output;
+    bool flat = false;
+    bool static_kernel = false;
+    std::string topology_file;
+    bool use_cache = true;
+    std::string cache_dir = "simulation_cache";
+    ParallelOptions parallel;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            args.push_back(arg);
+        } else if (parseAirportOption(arg, config)) {
+            continue;
+        } else if (arg == "--realtime") {
+            realtime = true;
+        } else if (arg.rfind("--realtime=", 0) == 0) {
+            realtime = true;
+            rt_options.speed = std::stod(arg.substr(11));
+        } else if (arg.rfind("--fifo=", 0) == 0) {
+            rt_options.fifo_path = arg.substr(7);
+        } else if (arg.rfind("--socket=", 0) == 0) {
+            rt_options.socket_path = arg.substr(9);
+        } else if (arg.rfind("--shm=", 0) == 0) {
+            output.shm_name = arg.substr(6);
+        } else if (arg.rfind("--shm-slots=", 0) == 0) {
+            output.shm_slots = std::stoull(arg.substr(12));
+        } else if (arg.rfind("--viewer=", 0) == 0) {
+            output.viewer_dir = arg.substr(9);
+        } else if (arg == "--fingerprint") {
+            output.fingerprint = true;
+        } else if (arg.rfind("--fingerprint=", 0) == 0) {
+            output.fingerprint = true;
+            output.fingerprint_interval = std::stoull(arg.substr(14));
+        } else if (arg.rfind("--compare=", 0) == 0) {
+            output.compare_file = arg.substr(10);
+        } else if (arg == "--delta") {
+            output.delta = true;
+        } else if (arg.rfind("--delta=", 0) == 0) {
+            output.delta = true;
+            output.delta_keyframe = std::stoull(arg.substr(8));
+        } else if (arg == "--segments") {
+            output.segments = true;
+        } else if (arg.rfind("--segments=", 0) == 0) {
+            output.segments = true;
+            output.segment_mb = std::stoull(arg.substr(11));
+            if (output.segment_mb == 0) {
+                std::cout << "--segments needs at least 1 megabyte per segment" << std::endl;
+                return 1;
+            }
+        } else if (arg.rfind("--segment-time=", 0) == 0) {
+            output.segments = true;
+            output.segment_time = std::stod(arg.substr(15));
+        } else if (arg == "--estimate") {
+            estimate = true;
+        } else if (arg.rfind("--estimate=", 0) == 0) {
+            estimate = true;
+            estimate_range = arg.substr(11);
+        } else if (arg == "--calibrate") {
+            calibrate = true;
+        } else if (arg.rfind("--serve=", 0) == 0) {
+            serve.socket_path = arg.substr(8);
+        } else if (arg.rfind("--workers=", 0) == 0) {
+            serve.workers = static_cast<unsigned>(std::max(1, std::stoi(arg.substr(10))));
+        } else if (arg.rfind("--metrics=", 0) == 0) {
+            output.metrics_file = arg.substr(10);
+            output.metrics = std::make_shared<AirportMetrics>();
+        } else if (arg.rfind("--metrics-interval=", 0) == 0) {
+            output.metrics_interval = std::stod(arg.substr(19));
+            // under a millisecond the publisher would rewrite the file in a busy loop
+            if (!std::isfinite(output.metrics_interval) || output.metrics_interval < 0.001) {
+                std::cout << "--metrics-interval needs at least 0.001 seconds" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--parallel") {
+            flat = true;
+            parallel.threads = std::max(1u, std::thread::hardware_concurrency());
+        } else if (arg.rfind("--parallel=", 0) == 0) {
+            flat = true;
+            parallel.threads = std::max(1, std::stoi(arg.substr(11)));
+        } else if (arg.rfind("--parallel-min=", 0) == 0) {
+            parallel.min_width = std::max(1, std::stoi(arg.substr(15)));
+        } else if (arg == "--scheduler=calendar") {
+            flat = true;
+            parallel.scheduler = FlatScheduler::CALENDAR;
+        } else if (arg == "--scheduler=scan") {
+            parallel.scheduler = FlatScheduler::SCAN;
+        } else if (arg == "--kernel=static") {
+            static_kernel = true;
+        } else if (arg == "--kernel=cadmium") {
+            static_kernel = false;
+        } else if (arg.rfind("--topology=", 0) == 0) {
+            topology_file = arg.substr(11);
+        } else if (arg == "--no-cache") {
+            use_cache = false;
+        } else if (arg.rfind("--cache=", 0) == 0) {
+            cache_dir = arg.substr(8);
+        } else {
+            std::cout << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    // a topology file brings its own structure, the compiled airport's limits do not apply
+    std::string config_error = topology_file.empty() ? airportConfigError(config) : "";
+    if (!config_error.empty()) {
+        std::cout << config_error << std::endl;
+        return 1;
+    }
+    int output_modes = !output.shm_name.empty() + !output.viewer_dir.empty() + output.fingerprint + output.delta +
+                       output.segments;
+    if (output_modes > 1) {
+        std::cout << "The trace goes to one output, use only one of --shm, --viewer, --fingerprint, --delta and --segments"
+                  << std::endl;
         return 1;
     }
 
-    std::string input_file = argv[1];
-    double sim_time = (argc > 2) ? std::stod(argv[2]) : 36000.0;
+    if (estimate) {
+        return runEstimate(estimate_range, config);
+    }
+    if (calibrate) {
+        return runCalibrate(args, config);
+    }
+    if (!serve.socket_path.empty()) {
+        serve.config = config;
+        return runServe(serve);
+    }
+    if (realtime) {
+        return runRealTime(args, config, rt_options, output);
+    }
+
+    if (args.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (static_kernel && flat) {
+        std::cout << "The static kernel has its own scheduler, use either --kernel=static or --parallel / --scheduler" << std::endl;
+        return 1;
+    }
+    if (static_kernel && !topology_file.empty()) {
+        std::cout << "The static kernel runs only the compiled airport, use either --kernel=static or --topology" << std::endl;
+        return 1;
+    }
+
+    std::string input_file = args[0];
+
+    // streamed input has no natural end time, run until the writer closes
+    struct stat input_stat;
+    bool streamed = (input_file == "-") ||
+                    (::stat(input_file.c_str(), &input_stat) == 0 && S_ISFIFO(input_stat.st_mode));
+    double default_time = streamed ? std::numeric_limits<double>::infinity() : 36000.0;
+    double sim_time = (args.size() > 1) ? std::stod(args[1]) : default_time;
 
     // generate output filename from input filename
-    std::string test_name = getTestName(input_file);
+    std::string test_name = (input_file == "-") ? "stdin" : getTestName(input_file);
     std::string output_file = "simulation_results/" + test_name + "_output.csv";
 
     std::cout << "========================================" << std::endl;
     std::cout << "Airport Simulation Starting" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Input file: " << input_file << std::endl;
-    std::cout << "Output file: " << output_file << std::endl;
+    printOutput(output_file, output);
     std::cout << "Simulation time: " << sim_time << " seconds" << std::endl;
+    if (config.scheduling == TowerScheduling::PRIORITY) {
+        std::cout << "Tower scheduling: priority" << std::endl;
+    }
+    if (config.queue_capacity > 0) {
+        std::cout << "Queue capacity: " << config.queue_capacity << std::endl;
+    }
+    if (config.hangar_dwell.enabled) {
+        std::cout << "Hangar dwell: " << config.hangar_dwell.dwell << " seconds"
+                  << (config.hangar_dwell.exponential ? " (exponential mean)" : "") << std::endl;
+    }
+    if (config.hangar == HangarModel::AGGREGATE) {
+        std::cout << "Hangar: aggregate delay line" << std::endl;
+    }
+    if (config.signalling == TowerSignalling::COALESCED) {
+        std::cout << "Tower signalling: coalesced" << std::endl;
+    }
+    if (static_kernel) {
+        std::cout << "Kernel: static airport topology" << std::endl;
+    }
+    if (!topology_file.empty()) {
+        std::cout << "Topology: " << topology_file << std::endl;
+    }
+    if (flat) {
+        std::cout << "Coordinator: flat, " << parallel.threads << " thread(s), parallel from "
+                  << parallel.min_width << " models per step, "
+                  << (parallel.scheduler == FlatScheduler::CALENDAR ? "calendar" : "scan") << " scheduler" << std::endl;
+    }
     std::cout << "========================================" << std::endl;
     std::cout << std::endl;
 
-    auto model = std::make_shared<AirportSimulation>("AirportSimulation", input_file.c_str());
-    auto rootCoordinator = RootCoordinator(model);
+    // a run to a single log file is cached; live outputs and streamed input are always simulated
+    ResultCache cache(cache_dir);
+    std::string log_file = outputTarget(output_file, output);
+    RunKey key;
+    bool cached_run = use_cache && !streamed && output.shm_name.empty() && output.viewer_dir.empty() &&
+                      !output.segments && !output.metrics;
+    if (cached_run) {
+        key = runKey(input_file, sim_time, config, topology_file, output);
+        cached_run = key.valid();
+    }
+    CachedRun cached;
+    if (cached_run && cache.restore(key, log_file, cached)) {
+        std::cout << "Served from cache: " << cached.directory << " (the run took " << cached.seconds
+                  << " s, --no-cache to simulate again)" << std::endl;
+        if (output.fingerprint) readFingerprint(log_file, *output.fingerprint_result);
+        std::cout << "Simulation complete. Results saved to: " << log_file << std::endl;
+        return reportFingerprint(output_file, output);
+    }
 
-    // log to csv file
-    rootCoordinator.setLogger<CSVLogger>(output_file, ";");
-    rootCoordinator.start();
-    rootCoordinator.simulate(sim_time);
-    rootCoordinator.stop();
+    // the static kernel reads the input itself, its Cadmium tree only gives the model ids
+    std::shared_ptr<AirportSimulation> airport;
+    std::shared_ptr<Coupled> model;
+    if (topology_file.empty()) {
+        airport = std::make_shared<AirportSimulation>("AirportSimulation",
+                                                      static_kernel ? "/dev/null" : input_file.c_str(), config);
+        model = airport;
+    } else {
+        try {
+            TopologyFile topology = TopologyFile::load(topology_file);
+            TopologyBuilder builder(topology, AtomicParameters{config, input_file});
+            model = builder.build("AirportSimulation");
+            const TopologyStats& stats = builder.stats();
+            std::cout << "Built " << stats.atomics << " atomic and " << stats.coupled << " coupled models, "
+                      << stats.couplings << " couplings" << std::endl;
+        } catch (const CadmiumModelException& e) {
+            std::cout << e.what() << std::endl;
+            return 1;
+        }
+    }
+    auto run = [&](auto& rootCoordinator) {
+        // log to csv file, or the shared-memory ring
+        attachLogger(rootCoordinator, model, output_file, output);
+        auto metrics = startMetrics(output);
+        rootCoordinator.start();
+        rootCoordinator.simulate(sim_time);
+        rootCoordinator.stop();
+        metrics.reset();
+    };
+    auto started = std::chrono::steady_clock::now();
+    if (static_kernel) {
+        withStaticAirport(*airport, input_file.c_str(), config, run);
+    } else if (flat) {
+        FlatCoordinator rootCoordinator(model, parallel);
+        run(rootCoordinator);
+    } else {
+        auto rootCoordinator = RootCoordinator(model);
+        run(rootCoordinator);
+    }
 
-    std::cout << "Simulation complete. Results saved to: " << output_file << std::endl;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
 
-    return 0;
+    std::cout << "Simulation complete. Results saved to: "
+              << outputTarget(output_file, output) << std::endl;
+
+    int status = reportFingerprint(output_file, output);
+    if (cached_run && cache.store(key, log_file, seconds)) {
+        std::cout << "Cached in " << cache.entry(key) << std::endl;
+    }
+    return status;
 }